@@ -3,7 +3,7 @@
 //
 
 #include "AnimationHelper.h"
-#include <iostream>
+#include "../gamecore/Logger.h"
 
 bool AnimationHelper::LoadAnimationFromAtlas(Animator& animator, 
                                              const SpriteAtlas& atlas,
@@ -13,7 +13,7 @@ bool AnimationHelper::LoadAnimationFromAtlas(Animator& animator,
     // 从 SpriteAtlas 获取动画帧序列
     std::vector<std::string> frameNames = atlas.GetAnimationFrames(animationName);
     if (frameNames.empty()) {
-        std::cerr << "AnimationHelper: 未找到动画 '" << animationName << "'" << std::endl;
+        LOG_WARN("AnimationHelper: 未找到动画 '{}'", animationName);
         return false;
     }
     
@@ -3,7 +3,7 @@
 //
 
 #include "Animator.h"
-#include <iostream>
+#include "../gamecore/Logger.h"
 
 Animator::Animator() 
     : currentAnimation(nullptr),
@@ -36,7 +36,7 @@ void Animator::AddAnimation(const std::string& stateName, const std::vector<std:
 
 void Animator::Play(const std::string& stateName, bool forceRestart) {
     if (!HasAnimation(stateName)) {
-        std::cerr << "Animator: 动画状态 '" << stateName << "' 不存在" << std::endl;
+        LOG_WARN("Animator: 动画状态 '{}' 不存在", stateName);
         return;
     }
     
@@ -0,0 +1,80 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef BULLETBEHAVIOR_H
+#define BULLETBEHAVIOR_H
+
+#include <cstdint>
+
+// 每种子弹类型最多配置的行为数
+constexpr int MAX_BULLET_BEHAVIORS = 4;
+
+// 内置行为种类
+enum class BehaviorKind : uint8_t {
+    DELAY_ACCELERATE,   // 到达 triggerMs 后沿当前方向加速到 speed
+    SPLIT,              // 到达 triggerMs 时分裂成 count 颗 typeIndex 子弹，自身消失
+    BOUNCE,             // 碰到左/右/上边界反弹，最多 count 次
+    WRAP,               // 从一侧出界后从对侧进入，最多 count 次
+    CHANGE_SPRITE,      // 到达 triggerMs 时换成 typeIndex 类型的外观和碰撞体
+    COUNT
+};
+
+/**
+ * 数据驱动的子弹行为参数（平凡可复制、无隐式填充）
+ * 不挂在子弹对象上：BulletManager 按种类分表保存（池索引 + 参数），每种行为一个批处理循环，
+ * 只遍历使用该行为的子弹；行为完成或子弹回收后从表中移除
+ */
+struct BulletBehavior {
+    float triggerMs = 0.0f;     // DELAY_ACCELERATE / SPLIT / CHANGE_SPRITE：触发时的存活时间
+    float accel = 0.0f;         // DELAY_ACCELERATE：加速度（像素/毫秒²）
+    float speed = 0.0f;         // DELAY_ACCELERATE：目标速度；SPLIT：子弹速度（像素/毫秒）
+    float spreadRad = 0.0f;     // SPLIT：总张角，>= 2π 时均匀分布一周
+    uint16_t typeIndex = 0;     // SPLIT / CHANGE_SPRITE：子弹类型编号
+    uint8_t count = 0;          // SPLIT：分裂数量；BOUNCE / WRAP：剩余次数
+    BehaviorKind kind = BehaviorKind::COUNT;
+
+    static BulletBehavior DelayAccelerate(float delayMs, float accel, float targetSpeed) {
+        BulletBehavior behavior;
+        behavior.kind = BehaviorKind::DELAY_ACCELERATE;
+        behavior.triggerMs = delayMs;
+        behavior.accel = accel;
+        behavior.speed = targetSpeed;
+        return behavior;
+    }
+
+    static BulletBehavior Split(float atMs, uint16_t typeIndex, uint8_t count, float spreadRad, float speed) {
+        BulletBehavior behavior;
+        behavior.kind = BehaviorKind::SPLIT;
+        behavior.triggerMs = atMs;
+        behavior.typeIndex = typeIndex;
+        behavior.count = count;
+        behavior.spreadRad = spreadRad;
+        behavior.speed = speed;
+        return behavior;
+    }
+
+    static BulletBehavior Bounce(uint8_t times) {
+        BulletBehavior behavior;
+        behavior.kind = BehaviorKind::BOUNCE;
+        behavior.count = times;
+        return behavior;
+    }
+
+    static BulletBehavior Wrap(uint8_t times) {
+        BulletBehavior behavior;
+        behavior.kind = BehaviorKind::WRAP;
+        behavior.count = times;
+        return behavior;
+    }
+
+    static BulletBehavior ChangeSprite(float atMs, uint16_t typeIndex) {
+        BulletBehavior behavior;
+        behavior.kind = BehaviorKind::CHANGE_SPRITE;
+        behavior.triggerMs = atMs;
+        behavior.typeIndex = typeIndex;
+        return behavior;
+    }
+};
+
+#endif //BULLETBEHAVIOR_H
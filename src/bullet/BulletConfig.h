@@ -5,9 +5,22 @@
 #ifndef BULLETCONFIG_H
 #define BULLETCONFIG_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <SDL3/SDL.h>
+#include "BulletBehavior.h"
+#include "../graphics/SpriteBatch.h"
+
+// 曲线激光轨迹点上限（轨迹缓冲按此大小预分配）
+constexpr int MAX_LASER_TRAIL_POINTS = 64;
+
+// 子弹种类：普通子弹、直线激光、曲线激光
+enum class BulletKind : uint8_t {
+    NORMAL,
+    LASER,
+    CURVY_LASER
+};
 
 /**
  * 子弹配置结构体
@@ -28,25 +41,87 @@ struct BulletConfig {
     
     // 碰撞体配置
     struct {
-        // 碰撞体类型："circle"（圆形）或 "rect"（矩形）
+        // 碰撞体类型："circle"（圆形）、"rect"（矩形）或 "obb"（以子弹中心为中心、随朝向旋转的矩形）
         std::string type;
         
         // 圆形碰撞体半径（type == "circle" 时使用）
         float radius;
         
-        // 矩形碰撞体的宽度和高度（type == "rect" 时使用）
+        // 矩形碰撞体的宽度和高度（type == "rect" / "obb" 时使用，obb 的 w 沿朝向方向）
         float w, h;
     } collider;
     
     // 渲染缩放倍数（默认1.0表示原始大小）
     // 可以用于放大或缩小子弹的显示尺寸
     float renderScale;
+
+    // 默认色调（JSON "color": [r, g, b, a]，与贴图相乘）和混合模式（JSON "blend"："alpha" / "additive"）
+    // 色调写在合批顶点里，每颗子弹可以单独改（BulletBase::SetTint）而不打断合批
+    SDL_Color color;
+    BlendMode blend;
+
+    // 朝向：为 true 时按速度方向旋转渲染，obb 碰撞体也随之旋转（米弹、苦无等）
+    bool orientToVelocity;
+    // 贴图本身朝向的角度（度，0 为 +x，90 为向下）
+    float spriteAngleDeg;
+
+    // 子弹种类（JSON "kind"："bullet" / "laser" / "curvy_laser"）
+    BulletKind kind;
+
+    // 激光参数（kind 为激光时使用，JSON "laser" 对象）
+    // 直线激光：预警线 warningMs -> 展开 growMs -> 持续 durationMs -> 收缩 shrinkMs，之后消失
+    // 曲线激光：头部按速度移动，身体是最近 trailPoints 个 tick 的头部位置
+    struct {
+        float length;        // 直线激光长度
+        float width;         // 完全展开时的宽度（渲染）
+        float hitboxScale;   // 判定宽度 / 渲染宽度
+        float warningMs;
+        float growMs;
+        float durationMs;
+        float shrinkMs;
+        float turnRateDeg;   // 曲线激光每秒转向角度（正值顺时针）
+        int trailPoints;     // 曲线激光轨迹点数
+    } laser;
+
+    // 出现阶段（JSON "spawn" 对象，激光不使用）：生成后 durationMs 内从 startScale/startAlpha
+    // 渐变到正常大小，期间没有判定、不计擦弹，被清弹时直接消失不转换道具
+    struct {
+        float durationMs;    // 0 表示生成即有判定
+        float startScale;    // 相对 renderScale 的初始倍数
+        float startAlpha;    // 初始不透明度 0~1
+    } spawn;
+
+    // 生成时自动挂上的行为（JSON "behaviors" 数组，最多 MAX_BULLET_BEHAVIORS 个）
+    // SPLIT / CHANGE_SPRITE 引用的子弹类型先按名称保存在 behaviorTypeNames（与 behaviors 一一对应），
+    // BulletFactory 分配完类型编号后再解析成 typeIndex
+    std::vector<BulletBehavior> behaviors;
+    std::vector<std::string> behaviorTypeNames;
+
+    // 类型编号：不来自JSON，由 BulletFactory 加载完成后按id排序分配
+    // 快照中用它代替类型字符串
+    uint16_t typeIndex;
     
     // 默认构造函数，初始化默认值
-    BulletConfig() : renderScale(1.0f) {
+    BulletConfig() : renderScale(1.0f), color{255, 255, 255, 255}, blend(BlendMode::ALPHA),
+                     orientToVelocity(false), spriteAngleDeg(0.0f),
+                     kind(BulletKind::NORMAL), typeIndex(0) {
         collider.type = "circle";
         collider.radius = 0.0f;
         collider.w = collider.h = 0.0f;
+
+        laser.length = 400.0f;
+        laser.width = 12.0f;
+        laser.hitboxScale = 0.6f;
+        laser.warningMs = 0.0f;
+        laser.growMs = 0.0f;
+        laser.durationMs = 1000.0f;
+        laser.shrinkMs = 0.0f;
+        laser.turnRateDeg = 0.0f;
+        laser.trailPoints = 32;
+
+        spawn.durationMs = 0.0f;
+        spawn.startScale = 2.0f;
+        spawn.startAlpha = 0.0f;
     }
 };
 
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <iostream>
 #include <cstring>
+#include <algorithm>
 
 // 注意：需要下载 nlohmann/json.hpp 单头文件库
 // 下载地址：https://github.com/nlohmann/json/releases
@@ -60,6 +61,102 @@ static bool ParseJsonToConfig(const json& j, BulletConfig& config) {
         if (j.contains("render_scale")) {
             config.renderScale = j["render_scale"].get<float>();
         }
+
+        // 解析色调与混合模式
+        if (j.contains("color") && j["color"].is_array() && j["color"].size() >= 3) {
+            const auto& color = j["color"];
+            config.color.r = static_cast<Uint8>(std::clamp(color[0].get<int>(), 0, 255));
+            config.color.g = static_cast<Uint8>(std::clamp(color[1].get<int>(), 0, 255));
+            config.color.b = static_cast<Uint8>(std::clamp(color[2].get<int>(), 0, 255));
+            config.color.a = static_cast<Uint8>(color.size() > 3 ? std::clamp(color[3].get<int>(), 0, 255) : 255);
+        }
+        std::string blend = j.value("blend", std::string("alpha"));
+        if (blend == "additive") {
+            config.blend = BlendMode::ADDITIVE;
+        } else if (blend != "alpha") {
+            std::cerr << "BulletConfigParser: unknown blend mode: " << blend << std::endl;
+            return false;
+        }
+
+        // 解析朝向
+        config.orientToVelocity = j.value("orient_to_velocity", config.orientToVelocity);
+        config.spriteAngleDeg = j.value("sprite_angle_deg", config.spriteAngleDeg);
+
+        // 解析kind与激光参数
+        std::string kind = j.value("kind", std::string("bullet"));
+        if (kind == "laser") {
+            config.kind = BulletKind::LASER;
+        } else if (kind == "curvy_laser") {
+            config.kind = BulletKind::CURVY_LASER;
+        } else if (kind != "bullet") {
+            std::cerr << "BulletConfigParser: unknown bullet kind: " << kind << std::endl;
+            return false;
+        }
+
+        if (j.contains("laser") && j["laser"].is_object()) {
+            const auto& laser = j["laser"];
+            config.laser.length = laser.value("length", config.laser.length);
+            config.laser.width = laser.value("width", config.laser.width);
+            config.laser.hitboxScale = laser.value("hitbox_scale", config.laser.hitboxScale);
+            config.laser.warningMs = laser.value("warning_ms", config.laser.warningMs);
+            config.laser.growMs = laser.value("grow_ms", config.laser.growMs);
+            config.laser.durationMs = laser.value("duration_ms", config.laser.durationMs);
+            config.laser.shrinkMs = laser.value("shrink_ms", config.laser.shrinkMs);
+            config.laser.turnRateDeg = laser.value("turn_rate_deg", config.laser.turnRateDeg);
+            config.laser.trailPoints = std::clamp(laser.value("trail_points", config.laser.trailPoints),
+                                                  2, MAX_LASER_TRAIL_POINTS);
+        }
+        
+        // 解析出现阶段
+        if (j.contains("spawn") && j["spawn"].is_object()) {
+            const auto& spawn = j["spawn"];
+            config.spawn.durationMs = std::max(0.0f, spawn.value("duration_ms", config.spawn.durationMs));
+            config.spawn.startScale = std::max(0.0f, spawn.value("start_scale", config.spawn.startScale));
+            config.spawn.startAlpha = std::clamp(spawn.value("start_alpha", config.spawn.startAlpha), 0.0f, 1.0f);
+        }
+
+        // 解析behaviors
+        config.behaviors.clear();
+        config.behaviorTypeNames.clear();
+        if (j.contains("behaviors") && j["behaviors"].is_array()) {
+            for (const auto& item : j["behaviors"]) {
+                if (static_cast<int>(config.behaviors.size()) >= MAX_BULLET_BEHAVIORS) {
+                    std::cerr << "BulletConfigParser: too many behaviors in " << config.id << std::endl;
+                    break;
+                }
+
+                std::string kind = item.value("kind", std::string());
+                std::string typeName = item.value("bullet", std::string());
+                uint8_t count = static_cast<uint8_t>(std::clamp(item.value("count", 1), 0, 255));
+                BulletBehavior behavior;
+                if (kind == "delay_accelerate") {
+                    behavior = BulletBehavior::DelayAccelerate(item.value("delay_ms", 0.0f), item.value("accel", 0.0f),
+                                                               item.value("speed", 0.0f));
+                } else if (kind == "split") {
+                    behavior = BulletBehavior::Split(item.value("at_ms", 0.0f), 0, count,
+                                                     item.value("spread_deg", 360.0f) * 3.14159265f / 180.0f,
+                                                     item.value("speed", 0.1f));
+                } else if (kind == "bounce") {
+                    // 次数为 0 的反弹/穿版没有意义，至少 1 次
+                    behavior = BulletBehavior::Bounce(std::max<uint8_t>(count, 1));
+                } else if (kind == "wrap") {
+                    behavior = BulletBehavior::Wrap(std::max<uint8_t>(count, 1));
+                } else if (kind == "change_sprite") {
+                    behavior = BulletBehavior::ChangeSprite(item.value("at_ms", 0.0f), 0);
+                } else {
+                    std::cerr << "BulletConfigParser: unknown behavior kind: " << kind << std::endl;
+                    return false;
+                }
+
+                if ((behavior.kind == BehaviorKind::SPLIT || behavior.kind == BehaviorKind::CHANGE_SPRITE) &&
+                    typeName.empty()) {
+                    std::cerr << "BulletConfigParser: behavior " << kind << " needs a bullet type" << std::endl;
+                    return false;
+                }
+                config.behaviors.push_back(behavior);
+                config.behaviorTypeNames.push_back(typeName);
+            }
+        }
         
         return true;
     } catch (const json::exception& e) {
@@ -6,6 +6,8 @@
 #include "BulletFactory.h"
 #include "BulletConfigParser.h"
 #include "../entity/BulletBase.h"
+#include "../gamecore/FrameProfiler.h"
+#include "../gamecore/Logger.h"
 #include <fstream>
 #include <iostream>
 #include <filesystem>
@@ -29,6 +31,28 @@ bool BulletFactory::Initialize(const std::string& configDir, Renderer& gameRende
         return false;
     }
 
+    // 按id顺序分配类型编号（map 已排序）
+    resourcesByIndex.clear();
+    for (auto& pair : bulletResources) {
+        pair.second.config->typeIndex = static_cast<uint16_t>(resourcesByIndex.size());
+        resourcesByIndex.push_back(&pair.second);
+    }
+
+    // 行为引用的子弹类型按名称解析成编号
+    for (auto& pair : bulletResources) {
+        BulletConfig& config = *pair.second.config;
+        for (size_t i = 0; i < config.behaviors.size(); ++i) {
+            if (config.behaviorTypeNames[i].empty()) continue;
+            int typeIndex = FindBulletTypeIndex(config.behaviorTypeNames[i]);
+            if (typeIndex < 0) {
+                std::cerr << "Bullet " << config.id << " references unknown bullet type: "
+                          << config.behaviorTypeNames[i] << std::endl;
+                return false;
+            }
+            config.behaviors[i].typeIndex = static_cast<uint16_t>(typeIndex);
+        }
+    }
+
     initialized = true;
     std::cout << "BulletFactory initialized successfully" << std::endl;
     return true;
@@ -38,13 +62,13 @@ std::unique_ptr<BulletBase> BulletFactory::CreateBullet(const std::string& bulle
                                                       BulletOwner owner,
                                                       float x, float y) {
     if (!initialized) {
-        std::cerr << "BulletFactory not initialized" << std::endl;
+        LOG_WARN("BulletFactory not initialized");
         return nullptr;
     }
 
     auto it = bulletResources.find(bulletType);
     if (it == bulletResources.end()) {
-        std::cerr << "Bullet type not found: " << bulletType << std::endl;
+        LOG_WARN("Bullet type not found: {}", bulletType);
         return nullptr;
     }
 
@@ -55,7 +79,7 @@ std::unique_ptr<BulletBase> BulletFactory::CreateBullet(const std::string& bulle
     
     // 使用 InitializeFromConfig 方法初始化子弹
     if (!bullet->InitializeFromConfig(resources.config.get(), resources.sprite)) {
-        std::cerr << "Failed to initialize bullet from config: " << bulletType << std::endl;
+        LOG_WARN("Failed to initialize bullet from config: {}", bulletType);
         return nullptr;
     }
     
@@ -90,7 +114,7 @@ bool BulletFactory::InitializeExistingBullet(BulletBase* bullet, const std::stri
     
     auto it = bulletResources.find(bulletType);
     if (it == bulletResources.end()) {
-        std::cerr << "Bullet type not found: " << bulletType << std::endl;
+        LOG_WARN("Bullet type not found: {}", bulletType);
         return false;
     }
     
@@ -98,7 +122,7 @@ bool BulletFactory::InitializeExistingBullet(BulletBase* bullet, const std::stri
     
     // 使用 InitializeFromConfig 方法初始化现有子弹
     if (!bullet->InitializeFromConfig(resources.config.get(), resources.sprite)) {
-        std::cerr << "Failed to initialize bullet from config: " << bulletType << std::endl;
+        LOG_WARN("Failed to initialize bullet from config: {}", bulletType);
         return false;
     }
     
@@ -108,6 +132,30 @@ bool BulletFactory::InitializeExistingBullet(BulletBase* bullet, const std::stri
     return true;
 }
 
+bool BulletFactory::InitializeExistingBullet(BulletBase* bullet, uint16_t typeIndex) {
+    if (!bullet || !initialized || typeIndex >= resourcesByIndex.size()) {
+        return false;
+    }
+
+    const BulletResources* resources = resourcesByIndex[typeIndex];
+    if (!bullet->InitializeFromConfig(resources->config.get(), resources->sprite)) {
+        return false;
+    }
+
+    bullet->Initialize(renderer);
+    return true;
+}
+
+const std::string& BulletFactory::GetBulletTypeName(uint16_t typeIndex) const {
+    static const std::string emptyType;
+    return typeIndex < resourcesByIndex.size() ? resourcesByIndex[typeIndex]->config->id : emptyType;
+}
+
+int BulletFactory::FindBulletTypeIndex(const std::string& bulletType) const {
+    auto it = bulletResources.find(bulletType);
+    return (it != bulletResources.end()) ? it->second.config->typeIndex : -1;
+}
+
 bool BulletFactory::LoadConfigs(const std::string& configDir, Renderer& renderer) {
     // 确保目录存在
     if (!std::filesystem::exists(configDir)) {
@@ -116,9 +164,13 @@ bool BulletFactory::LoadConfigs(const std::string& configDir, Renderer& renderer
     }
 
     // 查找所有JSON文件
+    FrameProfiler& profiler = FrameProfiler::Instance();
     for (const auto& file : std::filesystem::directory_iterator(configDir)) {
         if (file.path().extension() == ".json") {
-            if (!LoadConfigFile(file.path().string(), renderer)) {
+            double loadBegin = profiler.Now();
+            bool loadedFile = LoadConfigFile(file.path().string(), renderer);
+            profiler.Mark(FrameMarker::CONFIG_LOAD, profiler.Now() - loadBegin, file.path().filename().string().c_str());
+            if (!loadedFile) {
                 std::cerr << "Failed to load config file: " << file.path() << std::endl;
                 return false;
             }
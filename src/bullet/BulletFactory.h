@@ -42,6 +42,14 @@ public:
 
     bool InitializeExistingBullet(BulletBase* bullet, const std::string& bulletType);
 
+    // 按类型编号初始化（快照恢复用，避免逐颗子弹查找字符串）
+    bool InitializeExistingBullet(BulletBase* bullet, uint16_t typeIndex);
+
+    // 类型编号表：编号按id排序分配，同一组配置文件在任何机器上编号一致
+    size_t GetBulletTypeCount() const { return resourcesByIndex.size(); }
+    const std::string& GetBulletTypeName(uint16_t typeIndex) const;
+    int FindBulletTypeIndex(const std::string& bulletType) const;   // 不存在返回 -1
+
 
 private:
     // 内部资源管理结构
@@ -62,6 +70,7 @@ private:
     // 资源存储
     std::map<std::string, BulletResources> bulletResources;
     std::map<std::string, std::shared_ptr<Sprite>> textureCache;
+    std::vector<const BulletResources*> resourcesByIndex;   // typeIndex -> 资源
 
     Renderer* renderer;
     bool initialized;
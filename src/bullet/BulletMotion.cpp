@@ -0,0 +1,97 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "BulletMotion.h"
+
+#include <cmath>
+
+BulletMotion BulletMotion::Linear(float speed, float angleRad) {
+    BulletMotion motion;
+    motion.mode = MotionMode::LINEAR;
+    motion.dirX = std::cos(angleRad);
+    motion.dirY = std::sin(angleRad);
+    motion.speed = speed;
+    return motion;
+}
+
+BulletMotion BulletMotion::Accelerated(float speed, float angleRad, float accelX, float accelY) {
+    BulletMotion motion = Linear(speed, angleRad);
+    motion.mode = MotionMode::ACCELERATED;
+    motion.accelX = accelX;
+    motion.accelY = accelY;
+    return motion;
+}
+
+BulletMotion BulletMotion::Spiral(float radialSpeed, float angleRad, float angularVelocity) {
+    BulletMotion motion = Linear(radialSpeed, angleRad);
+    motion.mode = MotionMode::SPIRAL;
+    motion.angularVelocity = angularVelocity;
+    return motion;
+}
+
+BulletMotion BulletMotion::Sine(float speed, float angleRad, float amplitude, float periodMs, float phase) {
+    BulletMotion motion = Linear(speed, angleRad);
+    motion.mode = MotionMode::SINE;
+    motion.amplitude = amplitude;
+    motion.frequency = periodMs > 0.0f ? 6.28318530717959f / periodMs : 0.0f;
+    motion.phase = phase;
+    return motion;
+}
+
+BulletMotion BulletMotion::Rotated(float angleRad) const {
+    BulletMotion motion = *this;
+    float c = std::cos(angleRad);
+    float s = std::sin(angleRad);
+    motion.dirX = dirX * c - dirY * s;
+    motion.dirY = dirX * s + dirY * c;
+    motion.accelX = accelX * c - accelY * s;
+    motion.accelY = accelX * s + accelY * c;
+    return motion;
+}
+
+void BulletMotion::Evaluate(float t, float& x, float& y, float& vx, float& vy) const {
+    switch (mode) {
+        case MotionMode::INTEGRATED:
+        case MotionMode::LINEAR:
+            vx = dirX * speed;
+            vy = dirY * speed;
+            x = originX + vx * t;
+            y = originY + vy * t;
+            break;
+
+        case MotionMode::ACCELERATED:
+            vx = dirX * speed + accelX * t;
+            vy = dirY * speed + accelY * t;
+            x = originX + (dirX * speed + 0.5f * accelX * t) * t;
+            y = originY + (dirY * speed + 0.5f * accelY * t) * t;
+            break;
+
+        case MotionMode::SPIRAL: {
+            // 当前方向 = 初始方向旋转 ωt；半径 r = speed * t
+            float c = std::cos(angularVelocity * t);
+            float s = std::sin(angularVelocity * t);
+            float currentX = dirX * c - dirY * s;
+            float currentY = dirX * s + dirY * c;
+            float radius = speed * t;
+            x = originX + currentX * radius;
+            y = originY + currentY * radius;
+            // 速度 = 径向分量 + 切向分量 r·ω
+            vx = currentX * speed - currentY * radius * angularVelocity;
+            vy = currentY * speed + currentX * radius * angularVelocity;
+            break;
+        }
+
+        case MotionMode::SINE: {
+            // 法线取方向顺时针旋转 90°
+            float wave = frequency * t + phase;
+            float offset = amplitude * (std::sin(wave) - std::sin(phase));
+            float lateralSpeed = amplitude * frequency * std::cos(wave);
+            x = originX + dirX * speed * t - dirY * offset;
+            y = originY + dirY * speed * t + dirX * offset;
+            vx = dirX * speed - dirY * lateralSpeed;
+            vy = dirY * speed + dirX * lateralSpeed;
+            break;
+        }
+    }
+}
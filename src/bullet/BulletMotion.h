@@ -0,0 +1,51 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef BULLETMOTION_H
+#define BULLETMOTION_H
+
+#include <cstdint>
+
+// 运动方式：INTEGRATED 为原有的逐帧积分（速度 + 加速度），其余为按存活时间直接求值的闭式曲线
+enum class MotionMode : uint8_t {
+    INTEGRATED,
+    LINEAR,        // 匀速直线
+    ACCELERATED,   // 恒定加速度
+    SPIRAL,        // 极坐标螺旋：半径匀速增长、角度匀速旋转
+    SINE           // 沿方向匀速前进，横向正弦摆动
+};
+
+/**
+ * 闭式运动曲线：位置只由生成参数和经过时间决定
+ * 没有累积误差，长寿命子弹严格沿设计轨迹运动；任意时刻都可以直接求值（回放、跳转）
+ * 平凡可复制、无隐式填充，直接作为子弹快照的一部分
+ */
+struct BulletMotion {
+    float originX = 0.0f, originY = 0.0f;   // 起点（绑定到子弹时的位置）
+    float startMs = 0.0f;                   // 起点对应的子弹存活时间
+    float dirX = 1.0f, dirY = 0.0f;         // 初始方向单位向量
+    float speed = 0.0f;                     // 沿方向的速度；SPIRAL 为半径增长速度（像素/毫秒）
+    float accelX = 0.0f, accelY = 0.0f;     // ACCELERATED：加速度（像素/毫秒²）
+    float angularVelocity = 0.0f;           // SPIRAL：角速度（弧度/毫秒，正值顺时针）
+    float amplitude = 0.0f;                 // SINE：横向振幅（像素）
+    float frequency = 0.0f;                 // SINE：角频率（弧度/毫秒）
+    float phase = 0.0f;                     // SINE：初相（弧度）
+    MotionMode mode = MotionMode::INTEGRATED;
+    uint8_t reserved[3] = {};
+
+    static BulletMotion Linear(float speed, float angleRad);
+    static BulletMotion Accelerated(float speed, float angleRad, float accelX, float accelY);
+    static BulletMotion Spiral(float radialSpeed, float angleRad, float angularVelocity);
+    static BulletMotion Sine(float speed, float angleRad, float amplitude, float periodMs, float phase = 0.0f);
+
+    bool IsClosedForm() const { return mode != MotionMode::INTEGRATED; }
+
+    // 绕起点旋转整条曲线（方向和加速度一起旋转），用于扇形/环形发射
+    BulletMotion Rotated(float angleRad) const;
+
+    // 经过时间 t（毫秒）时的位置和速度
+    void Evaluate(float t, float& x, float& y, float& vx, float& vy) const;
+};
+
+#endif //BULLETMOTION_H
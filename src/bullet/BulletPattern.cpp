@@ -0,0 +1,104 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "BulletPattern.h"
+#include "../manager/BulletManager.h"
+
+#include <cmath>
+
+namespace {
+    constexpr float TWO_PI = 6.28318530717959f;
+}
+
+int BulletPattern::FireFan(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                           float x, float y, float baseAngleRad, float spreadRad, int count, float speed) {
+    if (!bulletManager || count <= 0) return 0;
+
+    for (int i = 0; i < count; ++i) {
+        float offset = count > 1 ? spreadRad * (static_cast<float>(i) / (count - 1) - 0.5f) : 0.0f;
+
+        BulletBase* bullet = bulletManager->CreateBullet(bulletType, owner, x, y);
+        if (!bullet) {
+            return i;
+        }
+        bullet->SetSpeedAngle(speed, baseAngleRad + offset);
+    }
+    return count;
+}
+
+int BulletPattern::FireFan(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                           float x, float y, float baseAngleRad, float spreadRad, int count, const BulletMotion& motion) {
+    if (!bulletManager || count <= 0) return 0;
+
+    for (int i = 0; i < count; ++i) {
+        float offset = count > 1 ? spreadRad * (static_cast<float>(i) / (count - 1) - 0.5f) : 0.0f;
+
+        BulletBase* bullet = bulletManager->CreateBullet(bulletType, owner, x, y);
+        if (!bullet) {
+            return i;
+        }
+        bullet->SetMotion(motion.Rotated(baseAngleRad + offset));
+    }
+    return count;
+}
+
+int BulletPattern::FireRing(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                            float x, float y, float startAngleRad, int count, float speed) {
+    if (!bulletManager || count <= 0) return 0;
+
+    float step = TWO_PI / static_cast<float>(count);
+    for (int i = 0; i < count; ++i) {
+        BulletBase* bullet = bulletManager->CreateBullet(bulletType, owner, x, y);
+        if (!bullet) {
+            return i;
+        }
+        bullet->SetSpeedAngle(speed, startAngleRad + step * i);
+    }
+    return count;
+}
+
+int BulletPattern::FireRing(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                            float x, float y, float startAngleRad, int count, const BulletMotion& motion) {
+    if (!bulletManager || count <= 0) return 0;
+
+    float step = TWO_PI / static_cast<float>(count);
+    for (int i = 0; i < count; ++i) {
+        BulletBase* bullet = bulletManager->CreateBullet(bulletType, owner, x, y);
+        if (!bullet) {
+            return i;
+        }
+        bullet->SetMotion(motion.Rotated(startAngleRad + step * i));
+    }
+    return count;
+}
+
+int BulletPattern::FireAimedFan(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                                float x, float y, float fallbackAngleRad, float spreadRad, int count, float speed) {
+    if (!bulletManager) return 0;
+
+    float baseAngle = fallbackAngleRad;
+    float targetX, targetY;
+    if (bulletManager->GetTargets().FindTarget(owner, x, y, targetX, targetY)) {
+        baseAngle = std::atan2(targetY - y, targetX - x);
+    }
+    return FireFan(bulletManager, bulletType, owner, x, y, baseAngle, spreadRad, count, speed);
+}
+
+int BulletPattern::FireHomingFan(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                                 float x, float y, float baseAngleRad, float spreadRad, int count, float speed,
+                                 float turnRateRadPerMs, float homingMs) {
+    if (!bulletManager || count <= 0) return 0;
+
+    for (int i = 0; i < count; ++i) {
+        float offset = count > 1 ? spreadRad * (static_cast<float>(i) / (count - 1) - 0.5f) : 0.0f;
+
+        BulletBase* bullet = bulletManager->CreateBullet(bulletType, owner, x, y);
+        if (!bullet) {
+            return i;
+        }
+        bullet->SetSpeedAngle(speed, baseAngleRad + offset);
+        bullet->SetHoming(turnRateRadPerMs, homingMs);
+    }
+    return count;
+}
@@ -0,0 +1,56 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef BULLETPATTERN_H
+#define BULLETPATTERN_H
+
+#include <string>
+#include "../entity/BulletBase.h"
+#include "BulletMotion.h"
+
+class BulletManager;
+
+/**
+ * 常用弹幕发射辅助函数
+ * 敌人脚本和关卡事件共用，避免各自重复角度计算
+ */
+class BulletPattern {
+public:
+    /**
+     * 扇形发射：以 baseAngleRad 为中心、spreadRad 为总张角均匀发射 count 发
+     * @return 实际发射的子弹数量（池耗尽或类型不存在时提前停止）
+     */
+    static int FireFan(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                       float x, float y, float baseAngleRad, float spreadRad, int count, float speed);
+
+    /**
+     * 环形发射：从 startAngleRad 开始一周均匀发射 count 发
+     */
+    static int FireRing(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                        float x, float y, float startAngleRad, int count, float speed);
+
+    /**
+     * 闭式运动版本：motion 按 0 度方向给出，每发子弹把整条曲线旋转到自己的角度
+     */
+    static int FireFan(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                       float x, float y, float baseAngleRad, float spreadRad, int count, const BulletMotion& motion);
+    static int FireRing(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                        float x, float y, float startAngleRad, int count, const BulletMotion& motion);
+
+    /**
+     * 自机狙 / 自动瞄准：以本 tick 目标快照中离发射点最近的目标为中心方向发射扇形
+     * 没有目标时使用 fallbackAngleRad
+     */
+    static int FireAimedFan(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                            float x, float y, float fallbackAngleRad, float spreadRad, int count, float speed);
+
+    /**
+     * 追踪弹扇形：每发子弹按 turnRateRadPerMs 转向最近的目标，持续 homingMs（0 表示一直追踪）
+     */
+    static int FireHomingFan(BulletManager* bulletManager, const std::string& bulletType, BulletOwner owner,
+                             float x, float y, float baseAngleRad, float spreadRad, int count, float speed,
+                             float turnRateRadPerMs, float homingMs);
+};
+
+#endif //BULLETPATTERN_H
@@ -0,0 +1,65 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "BulletTargets.h"
+#include "../entity/BulletBase.h"
+
+namespace {
+    // 线性查找最近点；距离相同取先加入的，保证结果确定
+    bool FindNearest(const float* xs, const float* ys, size_t count, float x, float y,
+                     float& targetX, float& targetY) {
+        if (count == 0) return false;
+
+        size_t best = 0;
+        float bestDistanceSq = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            float dx = xs[i] - x;
+            float dy = ys[i] - y;
+            float distanceSq = dx * dx + dy * dy;
+            if (i == 0 || distanceSq < bestDistanceSq) {
+                best = i;
+                bestDistanceSq = distanceSq;
+            }
+        }
+        targetX = xs[best];
+        targetY = ys[best];
+        return true;
+    }
+}
+
+BulletTargets::BulletTargets(size_t enemyCapacity) {
+    enemyX.reserve(enemyCapacity);
+    enemyY.reserve(enemyCapacity);
+}
+
+void BulletTargets::Clear() {
+    playerCount = 0;
+    enemyX.clear();
+    enemyY.clear();
+}
+
+void BulletTargets::AddPlayer(float x, float y) {
+    if (playerCount >= MAX_PLAYERS) return;
+    playerX[playerCount] = x;
+    playerY[playerCount] = y;
+    playerCount++;
+}
+
+void BulletTargets::AddEnemy(float x, float y) {
+    enemyX.push_back(x);
+    enemyY.push_back(y);
+}
+
+bool BulletTargets::FindNearestPlayer(float x, float y, float& targetX, float& targetY) const {
+    return FindNearest(playerX.data(), playerY.data(), playerCount, x, y, targetX, targetY);
+}
+
+bool BulletTargets::FindNearestEnemy(float x, float y, float& targetX, float& targetY) const {
+    return FindNearest(enemyX.data(), enemyY.data(), enemyX.size(), x, y, targetX, targetY);
+}
+
+bool BulletTargets::FindTarget(BulletOwner owner, float x, float y, float& targetX, float& targetY) const {
+    return owner == BulletOwner::ENEMY ? FindNearestPlayer(x, y, targetX, targetY)
+                                       : FindNearestEnemy(x, y, targetX, targetY);
+}
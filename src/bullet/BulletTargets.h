@@ -0,0 +1,50 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef BULLETTARGETS_H
+#define BULLETTARGETS_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+enum class BulletOwner;
+
+/**
+ * 每 tick 生成一次的瞄准目标快照
+ * 自机中心给敌弹用，敌人中心给自机子弹用；自机狙、追踪弹都只读这里，
+ * 不需要每颗子弹通过回调去取自机或遍历敌人对象
+ */
+class BulletTargets {
+public:
+    static constexpr size_t MAX_PLAYERS = 2;
+
+    explicit BulletTargets(size_t enemyCapacity = 2048);
+
+    // 开始新一 tick 的快照
+    void Clear();
+    void AddPlayer(float x, float y);
+    void AddEnemy(float x, float y);
+
+    // 离 (x, y) 最近的目标，没有目标返回 false
+    bool FindNearestPlayer(float x, float y, float& targetX, float& targetY) const;
+    bool FindNearestEnemy(float x, float y, float& targetX, float& targetY) const;
+
+    // 按子弹归属选目标：敌弹瞄自机，自机子弹瞄敌人
+    bool FindTarget(BulletOwner owner, float x, float y, float& targetX, float& targetY) const;
+
+    size_t GetPlayerCount() const { return playerCount; }
+    size_t GetEnemyCount() const { return enemyX.size(); }
+
+private:
+    std::array<float, MAX_PLAYERS> playerX{};
+    std::array<float, MAX_PLAYERS> playerY{};
+    size_t playerCount = 0;
+
+    // SoA，按敌人池的最大数量预留
+    std::vector<float> enemyX;
+    std::vector<float> enemyY;
+};
+
+#endif //BULLETTARGETS_H
@@ -0,0 +1,165 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "Laser.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 无贴图时的激光颜色
+    constexpr SDL_FColor LASER_FALLBACK_COLOR = {1.0f, 0.35f, 0.8f, 0.9f};
+}
+
+float Laser::GetTotalLifeMs(const BulletConfig& config) {
+    return config.laser.warningMs + config.laser.growMs + config.laser.durationMs + config.laser.shrinkMs;
+}
+
+float Laser::GetWidth(const BulletConfig& config, float livedMs) {
+    const auto& laser = config.laser;
+    if (config.kind != BulletKind::LASER) {
+        return laser.width;
+    }
+
+    float t = livedMs - laser.warningMs;
+    if (t < 0.0f) {
+        return 0.0f;
+    }
+    if (t < laser.growMs) {
+        return laser.width * t / laser.growMs;
+    }
+    t -= laser.growMs;
+    if (t < laser.durationMs) {
+        return laser.width;
+    }
+    t -= laser.durationMs;
+    if (t < laser.shrinkMs) {
+        return laser.width * (1.0f - t / laser.shrinkMs);
+    }
+    return 0.0f;
+}
+
+bool Laser::IsWarning(const BulletConfig& config, float livedMs) {
+    return config.kind == BulletKind::LASER && livedMs < config.laser.warningMs;
+}
+
+float Laser::SegmentDistanceSq(float ax, float ay, float bx, float by, float px, float py) {
+    float abx = bx - ax;
+    float aby = by - ay;
+    float lengthSq = abx * abx + aby * aby;
+    float t = lengthSq > 0.0f ? std::clamp(((px - ax) * abx + (py - ay) * aby) / lengthSq, 0.0f, 1.0f) : 0.0f;
+    float dx = ax + abx * t - px;
+    float dy = ay + aby * t - py;
+    return dx * dx + dy * dy;
+}
+
+float Laser::TrailDistanceSq(const LaserTrail& trail, float px, float py) {
+    if (trail.count == 0) {
+        return INFINITY;
+    }
+    if (trail.count == 1) {
+        float dx = trail.Get(0).x - px;
+        float dy = trail.Get(0).y - py;
+        return dx * dx + dy * dy;
+    }
+
+    float best = INFINITY;
+    for (int i = 0; i + 1 < trail.count; ++i) {
+        const SDL_FPoint& a = trail.Get(i);
+        const SDL_FPoint& b = trail.Get(i + 1);
+        best = std::min(best, SegmentDistanceSq(a.x, a.y, b.x, b.y, px, py));
+    }
+    return best;
+}
+
+int Laser::BuildBeam(const Sprite* sprite, const SDL_Rect* frame, const SDL_FPoint* points, int count, float width,
+                     SDL_Vertex* vertices, int* indices) {
+    if (count < 2 || width <= 0.0f) return 0;
+    count = std::min(count, MAX_LASER_TRAIL_POINTS);
+
+    SDL_Texture* texture = (sprite && sprite->IsLoaded()) ? sprite->GetTexture() : nullptr;
+    float u0 = 0.0f, u1 = 1.0f, v0 = 0.0f, v1 = 1.0f;
+    if (texture && frame && sprite->GetWidth() > 0 && sprite->GetHeight() > 0) {
+        u0 = static_cast<float>(frame->x) / sprite->GetWidth();
+        u1 = static_cast<float>(frame->x + frame->w) / sprite->GetWidth();
+        v0 = static_cast<float>(frame->y) / sprite->GetHeight();
+        v1 = static_cast<float>(frame->y + frame->h) / sprite->GetHeight();
+    }
+    const SDL_FColor color = texture ? SDL_FColor{1.0f, 1.0f, 1.0f, 1.0f} : LASER_FALLBACK_COLOR;
+
+    const float halfWidth = width * 0.5f;
+    float normalX = 0.0f, normalY = 1.0f;
+    for (int i = 0; i < count; ++i) {
+        // 切线取相邻两点（端点取单侧），长度为 0 时沿用上一个法线
+        const SDL_FPoint& prev = points[std::max(0, i - 1)];
+        const SDL_FPoint& next = points[std::min(count - 1, i + 1)];
+        float tx = next.x - prev.x;
+        float ty = next.y - prev.y;
+        float length = std::sqrt(tx * tx + ty * ty);
+        if (length > 0.0001f) {
+            normalX = -ty / length;
+            normalY = tx / length;
+        }
+
+        float u = u0 + (u1 - u0) * static_cast<float>(i) / static_cast<float>(count - 1);
+        vertices[i * 2] = SDL_Vertex{{points[i].x + normalX * halfWidth, points[i].y + normalY * halfWidth}, color, {u, v0}};
+        vertices[i * 2 + 1] = SDL_Vertex{{points[i].x - normalX * halfWidth, points[i].y - normalY * halfWidth}, color, {u, v1}};
+    }
+
+    int indexCount = 0;
+    for (int i = 0; i + 1 < count; ++i) {
+        int a = i * 2;
+        indices[indexCount++] = a;
+        indices[indexCount++] = a + 1;
+        indices[indexCount++] = a + 2;
+        indices[indexCount++] = a + 1;
+        indices[indexCount++] = a + 3;
+        indices[indexCount++] = a + 2;
+    }
+    return indexCount;
+}
+
+void Laser::RenderBeam(Renderer* renderer, const Sprite* sprite, const SDL_Rect* frame,
+                       const SDL_FPoint* points, int count, float width) {
+    if (!renderer) return;
+
+    // 顶点和索引放在栈上，渲染激光不分配内存
+    SDL_Vertex vertices[MAX_LASER_TRAIL_POINTS * 2];
+    int indices[(MAX_LASER_TRAIL_POINTS - 1) * 6];
+    int indexCount = BuildBeam(sprite, frame, points, count, width, vertices, indices);
+    if (indexCount == 0) return;
+
+    // 每段 6 个索引，顶点数为 (段数 + 1) * 2
+    SDL_Texture* texture = (sprite && sprite->IsLoaded()) ? sprite->GetTexture() : nullptr;
+    SDL_RenderGeometry(renderer->GetRenderer(), texture, vertices, indexCount / 3 + 2, indices, indexCount);
+}
+
+void Laser::SubmitBeam(RenderQueue& queue, const Sprite* sprite, const SDL_Rect* frame,
+                       const SDL_FPoint* points, int count, float width, BlendMode blend) {
+    SDL_Vertex vertices[MAX_LASER_TRAIL_POINTS * 2];
+    int indices[(MAX_LASER_TRAIL_POINTS - 1) * 6];
+    int indexCount = BuildBeam(sprite, frame, points, count, width, vertices, indices);
+    if (indexCount == 0) return;
+
+    queue.SubmitGeometry(RenderLayer::LASERS, 0, sprite, vertices, indexCount / 3 + 2, indices, indexCount, blend);
+}
+
+void Laser::RenderWarningLine(Renderer* renderer, float x0, float y0, float x1, float y1) {
+    if (!renderer) return;
+    SDL_Renderer* sdlRenderer = renderer->GetRenderer();
+    SDL_SetRenderDrawBlendMode(sdlRenderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(sdlRenderer, 255, 80, 200, 110);
+    SDL_RenderLine(sdlRenderer, x0, y0, x1, y1);
+}
+
+void Laser::SubmitWarningLine(RenderQueue& queue, float x0, float y0, float x1, float y1) {
+    // 1 像素宽的细长四边形代替 SDL_RenderLine
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+    float angleDeg = std::atan2(dy, dx) * (180.0f / 3.14159265f);
+    queue.SubmitQuad(RenderLayer::LASERS, 0, nullptr, nullptr, (x0 + x1) * 0.5f, (y0 + y1) * 0.5f, length, 1.0f,
+                     angleDeg, SDL_Color{255, 80, 200, 110}, BlendMode::ALPHA);
+}
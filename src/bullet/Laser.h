@@ -0,0 +1,85 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef LASER_H
+#define LASER_H
+
+#include <array>
+#include <cstdint>
+#include <SDL3/SDL.h>
+#include "BulletConfig.h"
+#include "../graphics/Renderer.h"
+#include "../graphics/RenderQueue.h"
+#include "../graphics/Sprite.h"
+
+/**
+ * 曲线激光的轨迹环形缓冲（由 BulletManager 按槽位预分配，激光子弹只持有指针）
+ * 每 tick 压入一次头部位置，满了覆盖最旧的点，更新开销与普通子弹相同
+ */
+struct LaserTrail {
+    std::array<SDL_FPoint, MAX_LASER_TRAIL_POINTS> points;
+    uint16_t head = 0;       // 最新点的下标
+    uint16_t count = 0;      // 有效点数
+    uint16_t capacity = 2;   // 本条激光使用的点数（来自配置）
+
+    void Reset(int trailPoints) {
+        head = 0;
+        count = 0;
+        capacity = static_cast<uint16_t>(trailPoints);
+    }
+
+    void Push(float x, float y) {
+        if (count > 0) {
+            head = static_cast<uint16_t>((head + 1) % capacity);
+        }
+        points[head] = SDL_FPoint{x, y};
+        if (count < capacity) {
+            count++;
+        }
+    }
+
+    // i = 0 为最新的点（头部），i = count - 1 为尾部
+    const SDL_FPoint& Get(int i) const {
+        return points[(head + capacity - i) % capacity];
+    }
+};
+
+/**
+ * 激光的公共计算：宽度随时间变化、胶囊体/折线碰撞、三角形带渲染
+ */
+namespace Laser {
+    // 直线激光从生成到消失的总时长
+    float GetTotalLifeMs(const BulletConfig& config);
+
+    // 当前渲染宽度（直线激光按阶段变化，曲线激光恒定）
+    float GetWidth(const BulletConfig& config, float livedMs);
+
+    // 直线激光是否处于预警阶段（只画预警线，没有判定）
+    bool IsWarning(const BulletConfig& config, float livedMs);
+
+    // 点到线段距离的平方
+    float SegmentDistanceSq(float ax, float ay, float bx, float by, float px, float py);
+
+    // 轨迹折线到点的最小距离平方
+    float TrailDistanceSq(const LaserTrail& trail, float px, float py);
+
+    // 沿折线生成宽度为 width 的三角形带：vertices 至少 count * 2 个，indices 至少 (count - 1) * 6 个
+    // sprite 可为空（纯色），frame 为贴图中沿激光方向拉伸的区域；返回索引数（0 表示不需要绘制）
+    int BuildBeam(const Sprite* sprite, const SDL_Rect* frame, const SDL_FPoint* points, int count, float width,
+                  SDL_Vertex* vertices, int* indices);
+
+    // 三角形带一次 SDL_RenderGeometry 直接绘制
+    void RenderBeam(Renderer* renderer, const Sprite* sprite, const SDL_Rect* frame,
+                    const SDL_FPoint* points, int count, float width);
+
+    // 三角形带作为几何命令提交到渲染队列的激光层
+    void SubmitBeam(RenderQueue& queue, const Sprite* sprite, const SDL_Rect* frame,
+                    const SDL_FPoint* points, int count, float width, BlendMode blend);
+
+    // 预警线
+    void RenderWarningLine(Renderer* renderer, float x0, float y0, float x1, float y1);
+    void SubmitWarningLine(RenderQueue& queue, float x0, float y0, float x1, float y1);
+}
+
+#endif //LASER_H
@@ -0,0 +1,95 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef ENEMYCONFIG_H
+#define ENEMYCONFIG_H
+
+#include <string>
+#include <vector>
+#include <SDL3/SDL.h>
+
+// 单个敌人最多挂载的弹幕脚本数量（固定上限，池化对象无需动态分配）
+constexpr int MAX_ENEMY_PATTERNS = 4;
+
+/**
+ * 移动路径关键点
+ * 位置为相对出生点的偏移，路径在关键点之间用 Catmull-Rom 样条插值
+ */
+struct EnemyPathKey {
+    float timeMs;   // 到达该点的时间（相对出生时刻）
+    float x, y;     // 相对出生点的偏移
+};
+
+/**
+ * 弹幕脚本
+ * 从 startMs 开始，每隔 intervalMs 发射一轮 ways 发子弹，
+ * 以 angleDeg 为中心、spreadDeg 为总张角均匀分布
+ */
+struct EnemyPatternConfig {
+    std::string bulletType;     // 子弹配置id（BulletFactory 中的类型）
+    float startMs = 0.0f;       // 首次发射时间
+    float intervalMs = 1000.0f; // 发射间隔
+    int repeat = 0;             // 发射轮数，0 表示不限
+    int ways = 1;               // 每轮子弹数
+    float spreadDeg = 0.0f;     // 总张角
+    float angleDeg = 90.0f;     // 中心方向（0为右，90为下）
+    float speed = 0.2f;         // 子弹速度（像素/毫秒）
+    bool aimAtPlayer = false;   // 中心方向是否对准自机
+    float jitterDeg = 0.0f;     // 每轮中心方向的随机偏移范围（±），使用模拟随机数
+    float homingTurnDeg = 0.0f; // 追踪弹每秒最大转向角度，0 表示不追踪
+    float homingMs = 0.0f;      // 追踪持续时间，0 表示一直追踪
+};
+
+/**
+ * 敌人配置结构体
+ * 用于存储从JSON文件读取的敌人属性、外观、碰撞体、路径和弹幕脚本
+ */
+struct EnemyConfig {
+    // 敌人唯一标识符
+    std::string id;
+
+    // 贴图与帧（只使用第一帧作为外观）
+    std::string texture;
+    std::vector<SDL_Rect> frames;
+    float renderScale;
+
+    // 生命值
+    float hp;
+
+    // 碰撞体配置（相对精灵中心）
+    struct {
+        std::string type;   // "circle" 或 "rect"
+        float radius;
+        float w, h;
+    } collider;
+
+    // 移动路径（按时间排序）
+    std::vector<EnemyPathKey> path;
+
+    // 路径走完后是否回收（没有路径、少于两个关键帧时不生效）
+    bool despawnAtPathEnd;
+
+    // 弹幕脚本（最多 MAX_ENEMY_PATTERNS 个）
+    std::vector<EnemyPatternConfig> patterns;
+
+    // 被击破时掉落的道具数量（Boss 可以一次掉落上千个）
+    struct {
+        int power = 0;
+        int point = 0;
+        int bomb = 0;
+        int life = 0;
+    } drops;
+
+    // 类型编号：不来自JSON，由 EnemyManager 加载完成后按id排序分配
+    // 快照中用它代替类型字符串
+    uint16_t typeIndex;
+
+    EnemyConfig() : renderScale(1.0f), hp(1.0f), despawnAtPathEnd(true), typeIndex(0) {
+        collider.type = "circle";
+        collider.radius = 8.0f;
+        collider.w = collider.h = 0.0f;
+    }
+};
+
+#endif //ENEMYCONFIG_H
@@ -0,0 +1,137 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "EnemyConfigParser.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "../json.hpp"
+
+using json = nlohmann::json;
+
+// 内部辅助函数：解析单个弹幕脚本
+static EnemyPatternConfig ParseJsonToPattern(const json& j) {
+    EnemyPatternConfig pattern;
+    pattern.bulletType = j.value("bullet", std::string());
+    pattern.startMs = j.value("start_ms", pattern.startMs);
+    pattern.intervalMs = j.value("interval_ms", pattern.intervalMs);
+    pattern.repeat = j.value("repeat", pattern.repeat);
+    pattern.ways = std::max(1, j.value("ways", pattern.ways));
+    pattern.spreadDeg = j.value("spread_deg", pattern.spreadDeg);
+    pattern.angleDeg = j.value("angle_deg", pattern.angleDeg);
+    pattern.speed = j.value("speed", pattern.speed);
+    pattern.aimAtPlayer = j.value("aim_player", pattern.aimAtPlayer);
+    pattern.jitterDeg = j.value("jitter_deg", pattern.jitterDeg);
+    pattern.homingTurnDeg = j.value("homing_turn_deg", pattern.homingTurnDeg);
+    pattern.homingMs = j.value("homing_ms", pattern.homingMs);
+    return pattern;
+}
+
+// 内部辅助函数：从json对象解析配置
+static bool ParseJsonToConfig(const json& j, EnemyConfig& config) {
+    try {
+        if (j.contains("id")) {
+            config.id = j["id"].get<std::string>();
+        }
+
+        if (j.contains("texture")) {
+            config.texture = j["texture"].get<std::string>();
+        }
+
+        if (j.contains("frames") && j["frames"].is_array()) {
+            config.frames.clear();
+            for (const auto& frame : j["frames"]) {
+                config.frames.push_back({
+                    frame.value("x", 0), frame.value("y", 0),
+                    frame.value("w", 0), frame.value("h", 0)
+                });
+            }
+        }
+
+        if (j.contains("render_scale")) {
+            config.renderScale = j["render_scale"].get<float>();
+        }
+
+        if (j.contains("hp")) {
+            config.hp = j["hp"].get<float>();
+        }
+
+        if (j.contains("collider") && j["collider"].is_object()) {
+            const auto& collider = j["collider"];
+            config.collider.type = collider.value("type", config.collider.type);
+            config.collider.radius = collider.value("radius", config.collider.radius);
+            config.collider.w = collider.value("w", config.collider.w);
+            config.collider.h = collider.value("h", config.collider.h);
+        }
+
+        // 路径关键点：[{ "t": 0, "x": 0, "y": 0 }, ...]
+        if (j.contains("path") && j["path"].is_array()) {
+            config.path.clear();
+            for (const auto& key : j["path"]) {
+                config.path.push_back({key.value("t", 0.0f), key.value("x", 0.0f), key.value("y", 0.0f)});
+            }
+            std::sort(config.path.begin(), config.path.end(),
+                      [](const EnemyPathKey& a, const EnemyPathKey& b) { return a.timeMs < b.timeMs; });
+        }
+
+        if (j.contains("despawn_at_path_end")) {
+            config.despawnAtPathEnd = j["despawn_at_path_end"].get<bool>();
+        }
+
+        // 掉落：{ "power": 1, "point": 3, "bomb": 0, "life": 0 }
+        if (j.contains("drops") && j["drops"].is_object()) {
+            const auto& drops = j["drops"];
+            config.drops.power = std::max(0, drops.value("power", 0));
+            config.drops.point = std::max(0, drops.value("point", 0));
+            config.drops.bomb = std::max(0, drops.value("bomb", 0));
+            config.drops.life = std::max(0, drops.value("life", 0));
+        }
+
+        if (j.contains("patterns") && j["patterns"].is_array()) {
+            config.patterns.clear();
+            for (const auto& pattern : j["patterns"]) {
+                if (static_cast<int>(config.patterns.size()) >= MAX_ENEMY_PATTERNS) {
+                    std::cerr << "EnemyConfigParser: too many patterns in " << config.id
+                              << ", extra patterns ignored" << std::endl;
+                    break;
+                }
+                config.patterns.push_back(ParseJsonToPattern(pattern));
+            }
+        }
+
+        return true;
+    } catch (const json::exception& e) {
+        std::cerr << "EnemyConfigParser: Error parsing JSON: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool EnemyConfigParser::LoadFromFile(const std::string& filePath, EnemyConfig& config) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        std::cerr << "EnemyConfigParser: Failed to open file: " << filePath << std::endl;
+        return false;
+    }
+
+    json j;
+    try {
+        file >> j;
+    } catch (const json::parse_error& e) {
+        std::cerr << "EnemyConfigParser: JSON parse error: " << e.what() << std::endl;
+        return false;
+    }
+
+    return ParseJsonToConfig(j, config);
+}
+
+bool EnemyConfigParser::LoadFromString(const std::string& jsonString, EnemyConfig& config) {
+    try {
+        json j = json::parse(jsonString);
+        return ParseJsonToConfig(j, config);
+    } catch (const json::parse_error& e) {
+        std::cerr << "EnemyConfigParser: JSON parse error: " << e.what() << std::endl;
+        return false;
+    }
+}
@@ -0,0 +1,34 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef ENEMYCONFIGPARSER_H
+#define ENEMYCONFIGPARSER_H
+
+#include <string>
+#include "EnemyConfig.h"
+
+/**
+ * 敌人配置解析器
+ * 负责从JSON文件读取并解析EnemyConfig
+ */
+class EnemyConfigParser {
+public:
+    /**
+     * 从JSON文件加载并解析敌人配置
+     * @param filePath JSON文件路径
+     * @param config 输出的配置对象
+     * @return 成功返回true，失败返回false
+     */
+    static bool LoadFromFile(const std::string& filePath, EnemyConfig& config);
+
+    /**
+     * 从JSON字符串解析配置
+     * @param jsonString JSON字符串
+     * @param config 输出的配置对象
+     * @return 成功返回true，失败返回false
+     */
+    static bool LoadFromString(const std::string& jsonString, EnemyConfig& config);
+};
+
+#endif //ENEMYCONFIGPARSER_H
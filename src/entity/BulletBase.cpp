@@ -3,6 +3,8 @@
 //
 
 #include "BulletBase.h"
+#include "../bullet/Laser.h"
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <iostream>
@@ -16,17 +18,33 @@ BulletBase::BulletBase(BulletOwner owner, float x, float y)
       livedMs(0.0f),
       accelX(0.0f),
       accelY(0.0f),
+      flags(0),
+      homingTurnRate(0.0f),
+      homingEndMs(0.0f),
+      tint{255, 255, 255, 255},
       config(nullptr),
+      poolIndex(0),
       currentFrame(0),
-      frameTimer(0.0f) {
+      frameTimer(0.0f),
+      laserTrail(nullptr),
+      laserSlot(NO_LASER_SLOT),
+      orientedBox(false),
+      boxHalfWidth(0.0f),
+      boxHalfHeight(0.0f),
+      facingCos(1.0f),
+      facingSin(0.0f),
+      facingDeg(0.0f) {
+    InvalidateFacingCache();
     // 默认激活
     SetActive(true);
 }
 
 void BulletBase::Initialize(Renderer* renderer) {
     (void)renderer; // 基类不强制加载资源，子类可在此加载 sprite
-    // 默认碰撞体：小圆形，半径 4 像素
-    SetCircleCollider(4.0f);
+    // 默认碰撞体：小圆形，半径 4 像素（已从配置设置碰撞体时不覆盖）
+    if (!config) {
+        SetCircleCollider(4.0f);
+    }
 }
 
 bool BulletBase::InitializeFromConfig(const BulletConfig* bulletConfig, std::shared_ptr<Sprite> sharedSprite) {
@@ -37,17 +55,35 @@ bool BulletBase::InitializeFromConfig(const BulletConfig* bulletConfig, std::sha
     // 保存配置和资源
     config = bulletConfig;
     sprite = sharedSprite;
-    bulletType = bulletConfig->id;  // 使用id字段而不是name
+    tint = bulletConfig->color;
+
+    // 池中复用时动画从第一帧开始
+    currentFrame = 0;
+    frameTimer = 0.0f;
+    InvalidateFacingCache();
     
     // 设置碰撞体（根据实际BulletConfig结构）
     if (bulletConfig->collider.type == "circle") {
         SetCircleCollider(bulletConfig->collider.radius);
     } else if (bulletConfig->collider.type == "rect") {
         SetRectCollider(bulletConfig->collider.w, bulletConfig->collider.h);
+    } else if (bulletConfig->collider.type == "obb") {
+        SetOrientedBoxCollider(bulletConfig->collider.w, bulletConfig->collider.h);
     } else {
         // 默认使用圆形碰撞体，半径为4
         SetCircleCollider(4.0f);
     }
+
+    // 激光的判定走线段/折线距离，碰撞体只用于清弹等粗略判断
+    if (bulletConfig->kind != BulletKind::NORMAL) {
+        SetCircleCollider(bulletConfig->laser.width * bulletConfig->laser.hitboxScale * 0.5f);
+    }
+    // 直线激光的寿命由各阶段时长决定；曲线激光 durationMs 为 0 时只在离开屏幕后回收
+    if (bulletConfig->kind == BulletKind::LASER) {
+        SetLifeTime(Laser::GetTotalLifeMs(*bulletConfig));
+    } else if (bulletConfig->kind == BulletKind::CURVY_LASER) {
+        SetLifeTime(bulletConfig->laser.durationMs);
+    }
     
     return true;
 }
@@ -57,17 +93,39 @@ void BulletBase::Update(float deltaTime) {
 
     // 更新生命周期
     UpdateLifeTime(deltaTime);
+    if ((flags & BulletFlag::SPAWNING) && livedMs >= config->spawn.durationMs) {
+        ClearFlag(BulletFlag::SPAWNING);
+    }
     
-    // 应用移动
-    ApplyMovement(deltaTime);
+    // 应用移动（直线激光固定在发射点，速度只表示方向）
+    switch (GetKind()) {
+        case BulletKind::NORMAL:
+            if (motion.IsClosedForm()) {
+                ApplyMotionCurve();
+            } else {
+                ApplyMovement(deltaTime);
+            }
+            break;
+        case BulletKind::LASER:
+            break;
+        case BulletKind::CURVY_LASER:
+            if (config->laser.turnRateDeg != 0.0f) {
+                float turn = config->laser.turnRateDeg * (3.14159265f / 180.0f) * deltaTime / 1000.0f;
+                float c = std::cos(turn);
+                float s = std::sin(turn);
+                float vx = velocityX * c - velocityY * s;
+                velocityY = velocityX * s + velocityY * c;
+                velocityX = vx;
+            }
+            ApplyMovement(deltaTime);
+            if (laserTrail) {
+                laserTrail->Push(x, y);
+            }
+            break;
+    }
     
     // 更新动画
     UpdateAnimation(deltaTime);
-    
-    // 调用自定义更新函数（如果设置了的话）
-    if (customUpdate) {
-        customUpdate(this, deltaTime);
-    }
 }
 
 
@@ -75,21 +133,67 @@ void BulletBase::Update(float deltaTime) {
 void BulletBase::Render(Renderer* renderer) {
     if (!isActive) return;
 
+    if (IsLaser()) {
+        const Sprite* laserSprite = sprite.get();
+        const SDL_Rect* frame = config->frames.empty() ? nullptr : &config->frames[currentFrame];
+
+        if (config->kind == BulletKind::LASER) {
+            float endX, endY;
+            GetStraightLaserEnd(endX, endY);
+            if (Laser::IsWarning(*config, livedMs)) {
+                Laser::RenderWarningLine(renderer, x, y, endX, endY);
+                return;
+            }
+            const SDL_FPoint points[2] = {{x, y}, {endX, endY}};
+            Laser::RenderBeam(renderer, laserSprite, frame, points, 2, GetLaserWidth());
+        } else if (laserTrail) {
+            // 轨迹从头到尾展开到栈上
+            SDL_FPoint points[MAX_LASER_TRAIL_POINTS];
+            for (int i = 0; i < laserTrail->count; ++i) {
+                points[i] = laserTrail->Get(i);
+            }
+            Laser::RenderBeam(renderer, laserSprite, frame, points, laserTrail->count, GetLaserWidth());
+        }
+        return;
+    }
+
     if (sprite && sprite->IsLoaded() && config) {
         // 使用配置的帧进行渲染
         if (!config->frames.empty()) {
             const SDL_Rect& frame = config->frames[currentFrame];
-            
+            float drawWidth, drawHeight;
+            double angle;
+            SDL_Color color;
+            GetDrawParams(drawWidth, drawHeight, angle, color);
+
+            // 单独绘制只能改贴图的颜色调制，合批路径见 Submit
+            const bool tinted = color.r != 255 || color.g != 255 || color.b != 255 || color.a != 255;
+            if (tinted) {
+                sprite->SetColor(color.r, color.g, color.b, color.a);
+            }
+
             // 目标尺寸（考虑缩放）
-            int destWidth = static_cast<int>(frame.w * config->renderScale);
-            int destHeight = static_cast<int>(frame.h * config->renderScale);
+            int destWidth = static_cast<int>(drawWidth);
+            int destHeight = static_cast<int>(drawHeight);
             
             // 目标位置（居中）
             int destX = static_cast<int>(x - destWidth / 2.0f);
             int destY = static_cast<int>(y - destHeight / 2.0f);
-            
-            // 使用Sprite的Render方法，传入源矩形进行裁切
-            sprite->Render(*renderer, destX, destY, destWidth, destHeight, &frame);
+
+            // 按速度朝向或 rotation 旋转；不旋转的子弹仍走原来的直接拷贝
+            if (angle != 0.0) {
+                SDL_FRect dest = {x - destWidth / 2.0f, y - destHeight / 2.0f,
+                                  static_cast<float>(destWidth), static_cast<float>(destHeight)};
+                sprite->RenderRotated(*renderer, dest, &frame, angle);
+            } else {
+                // 使用Sprite的Render方法，传入源矩形进行裁切
+                sprite->Render(*renderer, destX, destY, destWidth, destHeight, &frame);
+            }
+
+            // 贴图在同类子弹间共享，颜色用完立即恢复
+            if (tinted) {
+                sprite->SetColor(255, 255, 255, 255);
+            }
         } else {
             // 没有帧信息，使用默认渲染
             sprite->Render(*renderer, static_cast<int>(x), static_cast<int>(y));
@@ -102,6 +206,82 @@ void BulletBase::Render(Renderer* renderer) {
     }
 }
 
+void BulletBase::Submit(RenderQueue& queue) const {
+    if (!isActive) return;
+
+    // 激光：三角形带按几何命令提交到激光层（顶点在提交时算好，渲染线程不读子弹状态）
+    if (IsLaser()) {
+        if (!config) return;
+        const Sprite* laserSprite = sprite.get();
+        const SDL_Rect* frame = config->frames.empty() ? nullptr : &config->frames[currentFrame];
+
+        if (config->kind == BulletKind::LASER) {
+            float endX, endY;
+            GetStraightLaserEnd(endX, endY);
+            if (Laser::IsWarning(*config, livedMs)) {
+                Laser::SubmitWarningLine(queue, x, y, endX, endY);
+                return;
+            }
+            const SDL_FPoint points[2] = {{x, y}, {endX, endY}};
+            Laser::SubmitBeam(queue, laserSprite, frame, points, 2, GetLaserWidth(), config->blend);
+        } else if (laserTrail) {
+            SDL_FPoint points[MAX_LASER_TRAIL_POINTS];
+            for (int i = 0; i < laserTrail->count; ++i) {
+                points[i] = laserTrail->Get(i);
+            }
+            Laser::SubmitBeam(queue, laserSprite, frame, points, laserTrail->count, GetLaserWidth(), config->blend);
+        }
+        return;
+    }
+
+    RenderLayer layer = owner == BulletOwner::PLAYER ? RenderLayer::PLAYER_BULLETS : RenderLayer::ENEMY_BULLETS;
+
+    // 没有帧信息：整张贴图，左上角在 (x, y)，与 Render 的默认绘制一致
+    if (!config || config->frames.empty() || !sprite || !sprite->IsLoaded()) {
+        if (sprite && sprite->IsLoaded()) {
+            const float spriteWidth = static_cast<float>(sprite->GetWidth());
+            const float spriteHeight = static_cast<float>(sprite->GetHeight());
+            queue.SubmitQuad(layer, 0, sprite.get(), nullptr, x + spriteWidth * 0.5f, y + spriteHeight * 0.5f,
+                             spriteWidth, spriteHeight, 0.0f, SDL_Color{255, 255, 255, 255}, BlendMode::ALPHA);
+        } else {
+            // 无贴图时用小方块占位
+            queue.SubmitQuad(layer, 0, nullptr, nullptr, x + 4.0f, y + 4.0f, 8.0f, 8.0f, 0.0f,
+                             SDL_Color{255, 0, 255, 255}, BlendMode::ALPHA);
+        }
+        return;
+    }
+
+    float drawWidth, drawHeight;
+    double angle;
+    SDL_Color color;
+    GetDrawParams(drawWidth, drawHeight, angle, color);
+    queue.SubmitQuad(layer, 0, sprite.get(), &config->frames[currentFrame], x, y, drawWidth, drawHeight,
+                     static_cast<float>(angle), color, config->blend);
+}
+
+void BulletBase::GetDrawParams(float& width, float& height, double& angleDeg, SDL_Color& color) const {
+    const SDL_Rect& frame = config->frames[currentFrame];
+
+    // 出现阶段：从 startScale/startAlpha 线性过渡到正常大小
+    float drawScale = config->renderScale;
+    float alpha = tint.a / 255.0f;
+    if (flags & BulletFlag::SPAWNING) {
+        float t = std::clamp(livedMs / config->spawn.durationMs, 0.0f, 1.0f);
+        drawScale *= config->spawn.startScale + (1.0f - config->spawn.startScale) * t;
+        alpha *= config->spawn.startAlpha + (1.0f - config->spawn.startAlpha) * t;
+    }
+    width = frame.w * drawScale;
+    height = frame.h * drawScale;
+    color = SDL_Color{tint.r, tint.g, tint.b, static_cast<Uint8>(alpha * 255.0f)};
+
+    // 按速度朝向或 rotation 旋转
+    angleDeg = rotation;
+    if (config->orientToVelocity) {
+        UpdateFacingCache();
+        angleDeg = facingDeg - config->spriteAngleDeg;
+    }
+}
+
 void BulletBase::OnCollision(EntityBase* other) {
     if (!other || !isActive) return;
     
@@ -116,8 +296,10 @@ void BulletBase::OnCollision(EntityBase* other) {
                 // 对玩家造成伤害
                 // 调用OnHit回调
                 OnHit(other);
-                // 标记子弹为非活跃状态
-                SetActive(false);
+                // 标记子弹为非活跃状态（激光命中后继续存在）
+                if (!IsLaser()) {
+                    SetActive(false);
+                }
             }
             break;
             
@@ -127,8 +309,10 @@ void BulletBase::OnCollision(EntityBase* other) {
                 // 对敌人造成伤害
                 // 调用OnHit回调
                 OnHit(other);
-                // 标记子弹为非活跃状态
-                SetActive(false);
+                // 标记子弹为非活跃状态（激光命中后继续存在）
+                if (!IsLaser()) {
+                    SetActive(false);
+                }
             }
             break;
             
@@ -162,6 +346,45 @@ void BulletBase::SetAcceleration(float ax, float ay) {
     accelY = ay;
 }
 
+void BulletBase::SetMotion(const BulletMotion& newMotion) {
+    motion = newMotion;
+    motion.originX = x;
+    motion.originY = y;
+    motion.startMs = livedMs;
+    ApplyMotionCurve();
+}
+
+void BulletBase::SeekTo(float ageMs) {
+    livedMs = std::max(ageMs, motion.startMs);
+    if (motion.IsClosedForm()) {
+        ApplyMotionCurve();
+    }
+}
+
+void BulletBase::SetHoming(float turnRateRadPerMs, float durationMs) {
+    ClearMotion();
+    homingTurnRate = std::max(0.0f, turnRateRadPerMs);
+    homingEndMs = durationMs > 0.0f ? livedMs + durationMs : 0.0f;
+    SetFlag(BulletFlag::HOMING);
+}
+
+void BulletBase::SteerTowards(float targetX, float targetY, float deltaTime) {
+    float dx = targetX - x;
+    float dy = targetY - y;
+    // 速度方向到目标方向的夹角（一次 atan2），限制在本 tick 的最大转向内
+    float cross = velocityX * dy - velocityY * dx;
+    float dot = velocityX * dx + velocityY * dy;
+    if (cross == 0.0f && dot >= 0.0f) return;   // 已经对准（或速度为 0）
+
+    float maxTurn = homingTurnRate * deltaTime;
+    float turn = std::clamp(std::atan2(cross, dot), -maxTurn, maxTurn);
+    float c = std::cos(turn);
+    float s = std::sin(turn);
+    float vx = velocityX * c - velocityY * s;
+    velocityY = velocityX * s + velocityY * c;
+    velocityX = vx;
+}
+
 void BulletBase::SetActive(bool active) {
     isActive = active;
 }
@@ -178,6 +401,12 @@ float BulletBase::GetDamage() const {
     return damage;
 }
 
+void BulletBase::SetOwner(BulletOwner newOwner) {
+    owner = newOwner;
+    // 池中子弹会在玩家/敌人之间复用，实体类型必须跟随归属
+    type = (newOwner == BulletOwner::PLAYER) ? EntityType::PLAYER_BULLET : EntityType::ENEMY_BULLET;
+}
+
 BulletOwner BulletBase::GetOwner() const {
     return owner;
 }
@@ -191,32 +420,243 @@ bool BulletBase::IsExpired() const {
     return (!isActive) || (lifeTimeMs > 0.0f && livedMs >= lifeTimeMs);
 }
 
+void BulletBase::BeginSpawnPhase() {
+    if (config && config->kind == BulletKind::NORMAL && config->spawn.durationMs > 0.0f) {
+        SetFlag(BulletFlag::SPAWNING);
+    }
+}
+
+void BulletBase::Translate(float dx, float dy) {
+    x += dx;
+    y += dy;
+    if (motion.IsClosedForm()) {
+        motion.originX += dx;
+        motion.originY += dy;
+    }
+}
+
 void BulletBase::SetCircleCollider(float radius) {
     EntityBase::SetCircleCollider(radius, radius, radius);
+    orientedBox = false;
 }
 
 void BulletBase::SetRectCollider(float w, float h) {
     EntityBase::SetRectangleCollider(0.0f, 0.0f, w, h);
+    orientedBox = false;
 }
 
+void BulletBase::SetOrientedBoxCollider(float w, float h) {
+    boxHalfWidth = w * 0.5f;
+    boxHalfHeight = h * 0.5f;
+    // 外接圆的正方形包围盒与朝向无关，清弹和通用检测直接使用
+    float extent = std::sqrt(boxHalfWidth * boxHalfWidth + boxHalfHeight * boxHalfHeight);
+    EntityBase::SetRectangleCollider(-extent, -extent, extent * 2.0f, extent * 2.0f);
+    orientedBox = true;
+}
 
+void BulletBase::InvalidateFacingCache() const {
+    facingSourceX = NAN;
+    facingSourceY = NAN;
+}
 
-void BulletBase::SetCustomUpdate(std::function<void(BulletBase*, float)> customUpdate) {
-    this->customUpdate = std::move(customUpdate);
+void BulletBase::UpdateFacingCache() const {
+    // NaN 与任何值都不相等，失效后的第一次调用一定会重新计算
+    if (velocityX == facingSourceX && velocityY == facingSourceY) return;
+    facingSourceX = velocityX;
+    facingSourceY = velocityY;
+
+    // 速度为 0 时保持上一次的朝向
+    float length = std::sqrt(velocityX * velocityX + velocityY * velocityY);
+    if (length > 0.0f) {
+        facingCos = velocityX / length;
+        facingSin = velocityY / length;
+        facingDeg = std::atan2(facingSin, facingCos) * (180.0f / 3.14159265f);
+    }
+}
+
+void BulletBase::GetFacing(float& cosAngle, float& sinAngle) const {
+    if (config && config->orientToVelocity) {
+        UpdateFacingCache();
+        cosAngle = facingCos;
+        sinAngle = facingSin;
+        return;
+    }
+    float angle = rotation * (3.14159265f / 180.0f);
+    cosAngle = std::cos(angle);
+    sinAngle = std::sin(angle);
+}
+
+float BulletBase::GetBoxDistanceSq(float px, float py) const {
+    float c, s;
+    GetFacing(c, s);
+    // 转到盒子局部坐标后按轴对齐盒计算
+    float dx = px - x;
+    float dy = py - y;
+    float localX = std::fabs(dx * c + dy * s) - boxHalfWidth;
+    float localY = std::fabs(dy * c - dx * s) - boxHalfHeight;
+    localX = std::max(localX, 0.0f);
+    localY = std::max(localY, 0.0f);
+    return localX * localX + localY * localY;
 }
 
 const std::string& BulletBase::GetBulletType() const {
-    return bulletType;
+    static const std::string emptyType;
+    return config ? config->id : emptyType;
+}
+
+void BulletBase::AttachLaserTrail(LaserTrail* trail, uint16_t slot) {
+    laserTrail = trail;
+    laserSlot = trail ? slot : NO_LASER_SLOT;
+}
+
+float BulletBase::GetLaserWidth() const {
+    return config ? Laser::GetWidth(*config, livedMs) : 0.0f;
+}
+
+bool BulletBase::IsLaserHarmful() const {
+    if (!config || !isActive) return false;
+    if (config->kind == BulletKind::CURVY_LASER) {
+        return laserTrail && laserTrail->count > 0;
+    }
+    // 展开到一半之前、收缩到一半之后不判定，和视觉上的"细线"阶段对应
+    return GetLaserWidth() >= config->laser.width * 0.5f;
+}
+
+void BulletBase::GetStraightLaserEnd(float& endX, float& endY) const {
+    // 方向取速度方向，速度为 0 时取朝向（度）
+    float length = std::sqrt(velocityX * velocityX + velocityY * velocityY);
+    float dirX, dirY;
+    if (length > 0.0f) {
+        dirX = velocityX / length;
+        dirY = velocityY / length;
+    } else {
+        float angle = rotation * (3.14159265f / 180.0f);
+        dirX = std::cos(angle);
+        dirY = std::sin(angle);
+    }
+    endX = x + dirX * config->laser.length;
+    endY = y + dirY * config->laser.length;
+}
+
+float BulletBase::GetLaserDistanceSq(float px, float py) const {
+    if (!config) return INFINITY;
+    if (config->kind == BulletKind::LASER) {
+        float endX, endY;
+        GetStraightLaserEnd(endX, endY);
+        return Laser::SegmentDistanceSq(x, y, endX, endY, px, py);
+    }
+    return laserTrail ? Laser::TrailDistanceSq(*laserTrail, px, py) : INFINITY;
+}
+
+bool BulletBase::GetLaserBounds(SDL_FRect& bounds) const {
+    if (!config) return false;
+
+    float minX = x, minY = y, maxX = x, maxY = y;
+    if (config->kind == BulletKind::LASER) {
+        float endX, endY;
+        GetStraightLaserEnd(endX, endY);
+        minX = std::min(minX, endX);
+        maxX = std::max(maxX, endX);
+        minY = std::min(minY, endY);
+        maxY = std::max(maxY, endY);
+    } else {
+        if (!laserTrail || laserTrail->count == 0) return false;
+        for (int i = 0; i < laserTrail->count; ++i) {
+            const SDL_FPoint& point = laserTrail->Get(i);
+            minX = std::min(minX, point.x);
+            maxX = std::max(maxX, point.x);
+            minY = std::min(minY, point.y);
+            maxY = std::max(maxY, point.y);
+        }
+    }
+    bounds = SDL_FRect{minX, minY, maxX - minX, maxY - minY};
+    return true;
+}
 
+bool BulletBase::IsOffscreen(int screenWidth, int screenHeight) const {
+    switch (GetKind()) {
+        case BulletKind::NORMAL:
+            return IsOutOfBounds(screenWidth, screenHeight);
+        case BulletKind::LASER:
+            return false;
+        case BulletKind::CURVY_LASER: {
+            // 头尾都离开屏幕（留出半个宽度）才回收，避免身体还在屏幕内时突然消失
+            if (!laserTrail || laserTrail->count == 0) return IsOutOfBounds(screenWidth, screenHeight);
+            const float margin = config->laser.width;
+            auto outside = [&](const SDL_FPoint& p) {
+                return p.x < -margin || p.y < -margin || p.x > screenWidth + margin || p.y > screenHeight + margin;
+            };
+            return outside(laserTrail->Get(0)) && outside(laserTrail->Get(laserTrail->count - 1));
+        }
+    }
+    return false;
+}
+
+void BulletBase::CaptureState(State& state) const {
+    state.x = x;
+    state.y = y;
+    state.velocityX = velocityX;
+    state.velocityY = velocityY;
+    state.accelX = accelX;
+    state.accelY = accelY;
+    state.damage = damage;
+    state.lifeTimeMs = lifeTimeMs;
+    state.livedMs = livedMs;
+    state.frameTimer = frameTimer;
+    state.rotation = rotation;
+    state.scale = scale;
+    state.currentFrame = currentFrame;
+    state.typeIndex = config ? config->typeIndex : 0;
+    state.owner = static_cast<uint8_t>(owner);
+    state.active = isActive ? 1 : 0;
+    state.flags = flags;
+    state.reserved = 0;
+    state.laserSlot = laserSlot;
+    state.motion = motion;
+    state.homingTurnRate = homingTurnRate;
+    state.homingEndMs = homingEndMs;
+    state.tint = tint;
+}
+
+void BulletBase::ApplyState(const State& state) {
+    x = state.x;
+    y = state.y;
+    velocityX = state.velocityX;
+    velocityY = state.velocityY;
+    accelX = state.accelX;
+    accelY = state.accelY;
+    damage = state.damage;
+    lifeTimeMs = state.lifeTimeMs;
+    livedMs = state.livedMs;
+    frameTimer = state.frameTimer;
+    rotation = state.rotation;
+    scale = state.scale;
+    currentFrame = state.currentFrame;
+    SetOwner(static_cast<BulletOwner>(state.owner));
+    isActive = state.active != 0;
+    flags = state.flags;
+    motion = state.motion;
+    homingTurnRate = state.homingTurnRate;
+    homingEndMs = state.homingEndMs;
+    tint = state.tint;
+    // 轨迹缓冲由 BulletManager 按 state.laserSlot 重新绑定
+    laserTrail = nullptr;
+    laserSlot = NO_LASER_SLOT;
+    InvalidateFacingCache();
+
+    // 帧数来自配置，防止快照与当前配置不一致时越界
+    if (!config || currentFrame < 0 || currentFrame >= static_cast<int>(config->frames.size())) {
+        currentFrame = 0;
+    }
 }
 
 
 
 
 void BulletBase::UpdateLifeTime(float deltaTime) {
-    if (lifeTimeMs <= 0.0f) return;
+    // 不限寿命的子弹也要累计存活时间（闭式运动按它求位置）
     livedMs += deltaTime;
-    if (livedMs >= lifeTimeMs) {
+    if (lifeTimeMs > 0.0f && livedMs >= lifeTimeMs) {
         OnExpire();
         SetActive(false);
     }
@@ -230,6 +670,11 @@ void BulletBase::ApplyMovement(float deltaTime) {
     y += velocityY * deltaTime;
 }
 
+void BulletBase::ApplyMotionCurve() {
+    // 速度也由曲线求出，朝向渲染和 obb 判定照常使用
+    motion.Evaluate(livedMs - motion.startMs, x, y, velocityX, velocityY);
+}
+
 void BulletBase::UpdateAnimation(float deltaTime) {
     if (!config || config->frames.size() <= 1) return;  // 单帧无需动画
     
@@ -5,28 +5,35 @@
 #ifndef BULLETBASE_H
 #define BULLETBASE_H
 
+#include <cstdint>
 #include <memory>
-#include <functional>
 #include "../graphics/Sprite.h"
 #include "../graphics/Renderer.h"
+#include "../graphics/RenderQueue.h"
 #include "../bullet/BulletConfig.h"
+#include "../bullet/BulletMotion.h"
 #include "EntityBase.h"
 
 class BulletBase;
 // 前向声明
 struct BulletConfig;
+struct LaserTrail;
 
 enum class BulletOwner {
     PLAYER,
     ENEMY
 };
 
-// 行为组件基类（前向声明，可以在单独文件中实现）
-class BulletBehavior {
-public:
-    virtual ~BulletBehavior() = default;
-    
-};
+// 子弹运行状态位（随快照保存，子弹出池时清零）
+namespace BulletFlag {
+    constexpr uint8_t GRAZED = 1 << 0;   // 已被自机擦过，不再重复计数
+    constexpr uint8_t HOMING = 1 << 1;   // 追踪弹（参数见 SetHoming）
+    constexpr uint8_t HAS_BEHAVIOR = 1 << 2;   // 在 BulletManager 的行为表/自定义回调表中有条目
+    constexpr uint8_t SPAWNING = 1 << 3;       // 出现阶段：碰撞与擦弹整体跳过（见 BulletConfig::spawn）
+
+    // 任一位被置上时不参与任何判定
+    constexpr uint8_t NO_COLLISION = SPAWNING;
+}
 
 class BulletBase : public EntityBase {
 public:
@@ -39,38 +46,132 @@ public:
     // 新增：从配置初始化外观和碰撞体
     bool InitializeFromConfig(const BulletConfig* config, std::shared_ptr<Sprite> sharedSprite);
     
-    // 更新和渲染（支持自定义行为）
+    // 更新和渲染（行为由 BulletManager 按种类批量执行，见 BulletBehavior）
     virtual void Update(float deltaTime) override;
     virtual void Render(Renderer* renderer) override;
+
+    // 提交到渲染队列：普通子弹按归属进自机弹/敌弹层合批，尺寸、旋转、色调和出现阶段的缩放/透明度
+    // 都写进顶点；激光的三角形带以几何命令提交到激光层
+    void Submit(RenderQueue& queue) const;
+
+    // 每颗子弹的色调（与贴图相乘，a 为透明度），生成时取配置的 color
+    void SetTint(const SDL_Color& color) { tint = color; }
+    const SDL_Color& GetTint() const { return tint; }
     virtual void OnCollision(EntityBase* other) override;
 
     // 运动与状态（保留原有接口）
     void SetVelocity(float vx, float vy);
     void SetSpeedAngle(float speed, float angleRad);
     void SetAcceleration(float ax, float ay);
+
+    // 闭式运动曲线：以当前位置为起点、当前存活时间为零点绑定，之后位置和速度完全由曲线决定
+    // （SetVelocity/SetAcceleration 对闭式运动的子弹无效）；ClearMotion 恢复逐帧积分
+    void SetMotion(const BulletMotion& newMotion);
+    void ClearMotion() { motion = BulletMotion{}; }
+    const BulletMotion& GetMotion() const { return motion; }
+
+    // 直接跳到指定存活时间（闭式运动的子弹同时求出该时刻的位置）
+    void SeekTo(float ageMs);
+
+    // 追踪：保持速率，每毫秒最多转向 turnRateRadPerMs，从现在起持续 durationMs（0 表示一直追踪）
+    // 转向由 BulletManager 按每 tick 的目标快照批量执行；追踪弹使用逐帧积分，会清除闭式运动
+    void SetHoming(float turnRateRadPerMs, float durationMs);
+    bool IsHoming() const { return HasFlag(BulletFlag::HOMING) && (homingEndMs <= 0.0f || livedMs < homingEndMs); }
+    void SteerTowards(float targetX, float targetY, float deltaTime);
     void SetActive(bool active);
     bool IsActive() const;
 
     // 伤害与归属
     void SetDamage(float dmg);
     float GetDamage() const;
-    void SetOwner(BulletOwner newOwner) { owner = newOwner; }
+    void SetOwner(BulletOwner newOwner);
     BulletOwner GetOwner() const;
 
     // 寿命与边界（保留原有接口）
     void SetLifeTime(float ms);          // 设定存活时间，0 表示不限制
     bool IsExpired() const;
+    float GetLivedMs() const { return livedMs; }
+
+    // 平移（闭式运动的子弹同时平移曲线起点，用于出界环绕）
+    void Translate(float dx, float dy);
+
+    // 所在池槽位（池创建时确定，不随复用改变，不进快照）
+    void SetPoolIndex(uint32_t index) { poolIndex = index; }
+    uint32_t GetPoolIndex() const { return poolIndex; }
+
+    // 状态位（见 BulletFlag）
+    bool HasFlag(uint8_t flag) const { return (flags & flag) != 0; }
+    void SetFlag(uint8_t flag) { flags |= flag; }
+    void ClearFlag(uint8_t flag) { flags &= static_cast<uint8_t>(~flag); }
+    void ClearFlags() { flags = 0; }
+    bool IsCollidable() const { return (flags & BulletFlag::NO_COLLISION) == 0; }
+
+    // 进入出现阶段（配置没有出现阶段时无效果）；阶段在 Update 中按存活时间结束
+    void BeginSpawnPhase();
+    bool IsSpawning() const { return HasFlag(BulletFlag::SPAWNING); }
 
     // 碰撞体设置（保留原有接口）
     void SetCircleCollider(float radius);
     void SetRectCollider(float w, float h);
 
-    // 新增：行为设置接口
-    
-    void SetCustomUpdate(std::function<void(BulletBase*, float)> customUpdate){this->customUpdate = std::move(customUpdate);}
-    
+    // 旋转矩形碰撞体：中心为子弹中心 (x, y)，w 沿朝向方向；外接正方形作为粗略包围盒
+    void SetOrientedBoxCollider(float w, float h);
+    bool IsOrientedBoxCollider() const { return orientedBox; }
+    float GetBoxHalfWidth() const { return boxHalfWidth; }
+    float GetBoxHalfHeight() const { return boxHalfHeight; }
+
+    // 朝向的单位向量：orient_to_velocity 的类型取速度方向（速度不变时复用缓存），否则取 rotation
+    // 只有需要朝向的类型（旋转渲染、obb 判定）才会调用，普通圆弹不付出任何开销
+    void GetFacing(float& cosAngle, float& sinAngle) const;
+    // 点到 obb 的距离平方（点在盒内为 0）
+    float GetBoxDistanceSq(float px, float py) const;
+
     // 新增：获取配置信息
     const std::string& GetBulletType() const;
+    const BulletConfig* GetConfig() const { return config; }
+
+    // 激光
+    static constexpr uint16_t NO_LASER_SLOT = 0xFFFF;
+    BulletKind GetKind() const { return config ? config->kind : BulletKind::NORMAL; }
+    bool IsLaser() const { return GetKind() != BulletKind::NORMAL; }
+    void AttachLaserTrail(LaserTrail* trail, uint16_t slot);   // 曲线激光的轨迹缓冲（由 BulletManager 分配）
+    uint16_t GetLaserSlot() const { return laserSlot; }
+    const LaserTrail* GetLaserTrail() const { return laserTrail; }
+    float GetLaserWidth() const;                 // 当前渲染宽度
+    bool IsLaserHarmful() const;                 // 预警/展开初期/收缩末期没有判定
+    float GetLaserDistanceSq(float px, float py) const;   // 激光中心线到点的距离平方
+    bool GetLaserBounds(SDL_FRect& bounds) const;         // 中心线包围盒（未扩展宽度）
+
+    // 是否已离开屏幕（激光按整条判断，直线激光只按寿命消失）
+    bool IsOffscreen(int screenWidth, int screenHeight) const;
+
+    /**
+     * 运行状态快照（平凡可复制，由 BulletManager 按池索引整块写入）
+     * 配置和贴图不在其中：恢复时先按 typeIndex 重新绑定配置，再应用状态。
+     * 行为表由 BulletManager 单独保存；自定义回调无法序列化，恢复后会被清空
+     */
+    struct State {
+        float x, y;
+        float velocityX, velocityY;
+        float accelX, accelY;
+        float damage;
+        float lifeTimeMs, livedMs;
+        float frameTimer;
+        float rotation, scale;
+        int32_t currentFrame;
+        uint16_t typeIndex;
+        uint8_t owner;
+        uint8_t active;
+        uint8_t flags;
+        uint8_t reserved;      // 显式填充，保证快照字节确定
+        uint16_t laserSlot;
+        BulletMotion motion;
+        float homingTurnRate, homingEndMs;
+        SDL_Color tint;
+    };
+
+    void CaptureState(State& state) const;
+    void ApplyState(const State& state);
 
 protected:
     // 供子类重写的钩子（保留原有接口）
@@ -83,6 +184,11 @@ protected:
     
     // 新增：内部辅助方法
     void UpdateAnimation(float deltaTime);
+    void GetStraightLaserEnd(float& endX, float& endY) const;
+    void ApplyMotionCurve();
+    void GetDrawParams(float& width, float& height, double& angleDeg, SDL_Color& color) const;
+    void UpdateFacingCache() const;
+    void InvalidateFacingCache() const;
 
     // 原有成员
     std::shared_ptr<Sprite> sprite;
@@ -92,19 +198,36 @@ protected:
     float livedMs;       // 已存活时间
     float accelX;
     float accelY;
+    uint8_t flags;       // BulletFlag 位
+    BulletMotion motion; // 闭式运动参数（INTEGRATED 时使用上面的速度/加速度积分）
+    float homingTurnRate;   // 追踪转向速率（弧度/毫秒）
+    float homingEndMs;      // 追踪结束时的存活时间，0 表示不结束
+    SDL_Color tint;         // 色调与透明度
     
     // 新增成员
-    const BulletConfig* config;  // 配置信息
-    std::string bulletType;      // 子弹类型名称
-    
-    // 新增：行为相关成员
-    
-    std::function<void(BulletBase*, float)> customUpdate;
-    
+    const BulletConfig* config;  // 配置信息（类型名称即 config->id）
     
+    uint32_t poolIndex;          // 所在池槽位，行为表用它引用子弹
+
     // 新增：动画相关成员
     int currentFrame;
     float frameTimer;
+
+    // 曲线激光轨迹（不属于子弹本身，快照中只保存槽位号）
+    LaserTrail* laserTrail;
+    uint16_t laserSlot;
+
+    // obb 碰撞体
+    bool orientedBox;
+    float boxHalfWidth;
+    float boxHalfHeight;
+
+    // 朝向缓存（由速度派生，不进快照）：记录上次计算时的速度，速度不变就不再开方/atan2
+    mutable float facingSourceX;
+    mutable float facingSourceY;
+    mutable float facingCos;
+    mutable float facingSin;
+    mutable float facingDeg;
 };
 
 #endif // BULLETBASE_H
\ No newline at end of file
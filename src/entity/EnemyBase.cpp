@@ -0,0 +1,263 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "EnemyBase.h"
+#include "BulletBase.h"
+#include "../bullet/BulletPattern.h"
+#include "../gamecore/Random.h"
+#include "../manager/BulletManager.h"
+#include "../snapshot/StateBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+
+    // 均匀 Catmull-Rom 插值
+    float CatmullRom(float p0, float p1, float p2, float p3, float u) {
+        float u2 = u * u;
+        float u3 = u2 * u;
+        return 0.5f * ((2.0f * p1) +
+                       (-p0 + p2) * u +
+                       (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2 +
+                       (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * u3);
+    }
+}
+
+EnemyBase::EnemyBase()
+    : EntityBase(EntityType::ENEMY),
+      config(nullptr),
+      hp(0.0f),
+      ageMs(0.0f),
+      spawnX(0.0f),
+      spawnY(0.0f),
+      pathSegment(0),
+      pathFinished(false),
+      killed(false),
+      patternStates{} {
+    SetActive(false);
+}
+
+bool EnemyBase::InitializeFromConfig(const EnemyConfig* enemyConfig, std::shared_ptr<Sprite> sharedSprite) {
+    if (!enemyConfig) {
+        return false;
+    }
+
+    config = enemyConfig;
+    sprite = std::move(sharedSprite);
+
+    // 尺寸：优先使用第一帧，否则用整张贴图
+    float w = 16.0f;
+    float h = 16.0f;
+    if (!config->frames.empty()) {
+        w = static_cast<float>(config->frames[0].w);
+        h = static_cast<float>(config->frames[0].h);
+    } else if (sprite && sprite->IsLoaded()) {
+        w = static_cast<float>(sprite->GetWidth());
+        h = static_cast<float>(sprite->GetHeight());
+    }
+    SetSize(w * config->renderScale, h * config->renderScale);
+
+    // 碰撞体以精灵中心为基准
+    if (config->collider.type == "rect") {
+        SetRectangleCollider(width * 0.5f - config->collider.w * 0.5f,
+                             height * 0.5f - config->collider.h * 0.5f,
+                             config->collider.w, config->collider.h);
+    } else {
+        SetCircleCollider(width * 0.5f, height * 0.5f, config->collider.radius);
+    }
+
+    return true;
+}
+
+void EnemyBase::Spawn(float centerX, float centerY) {
+    spawnX = centerX;
+    spawnY = centerY;
+    hp = config ? config->hp : 1.0f;
+    ageMs = 0.0f;
+    pathSegment = 0;
+    pathFinished = false;
+    killed = false;
+
+    for (size_t i = 0; i < patternStates.size(); ++i) {
+        patternStates[i].nextFireMs = (config && i < config->patterns.size()) ? config->patterns[i].startMs : 0.0f;
+        patternStates[i].firedRounds = 0;
+    }
+
+    ApplyPath();
+    SetActive(true);
+}
+
+void EnemyBase::Update(float deltaTime) {
+    if (!isActive) return;
+
+    ageMs += deltaTime;
+    ApplyPath();
+}
+
+void EnemyBase::ApplyPath() {
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+
+    if (config && !config->path.empty()) {
+        const auto& keys = config->path;
+        const int lastKey = static_cast<int>(keys.size()) - 1;
+
+        // 时间单调递增，段索引只需向前推进
+        while (pathSegment < lastKey && ageMs >= keys[pathSegment + 1].timeMs) {
+            pathSegment++;
+        }
+
+        if (pathSegment >= lastKey) {
+            offsetX = keys[lastKey].x;
+            offsetY = keys[lastKey].y;
+            // 只有一个关键帧时只是固定偏移，不算路径，固定位置的敌人和 Boss 不会因此被回收
+            pathFinished = lastKey > 0;
+        } else {
+            const EnemyPathKey& p0 = keys[std::max(pathSegment - 1, 0)];
+            const EnemyPathKey& p1 = keys[pathSegment];
+            const EnemyPathKey& p2 = keys[pathSegment + 1];
+            const EnemyPathKey& p3 = keys[std::min(pathSegment + 2, lastKey)];
+
+            float span = p2.timeMs - p1.timeMs;
+            float u = span > 0.0f ? std::clamp((ageMs - p1.timeMs) / span, 0.0f, 1.0f) : 1.0f;
+            offsetX = CatmullRom(p0.x, p1.x, p2.x, p3.x, u);
+            offsetY = CatmullRom(p0.y, p1.y, p2.y, p3.y, u);
+        }
+    }
+
+    x = spawnX + offsetX - width * 0.5f;
+    y = spawnY + offsetY - height * 0.5f;
+}
+
+void EnemyBase::UpdatePatterns(BulletManager* bulletManager, float targetX, float targetY, Random* random) {
+    if (!isActive || killed || !config || !bulletManager) return;
+
+    const int patternCount = std::min(static_cast<int>(config->patterns.size()), MAX_ENEMY_PATTERNS);
+    for (int i = 0; i < patternCount; ++i) {
+        const EnemyPatternConfig& pattern = config->patterns[i];
+        PatternState& state = patternStates[i];
+
+        while (ageMs >= state.nextFireMs && (pattern.repeat <= 0 || state.firedRounds < pattern.repeat)) {
+            FirePatternRound(bulletManager, pattern, targetX, targetY, random);
+            state.firedRounds++;
+
+            if (pattern.intervalMs <= 0.0f) {
+                // 没有间隔的脚本只发射一次
+                state.nextFireMs = std::numeric_limits<float>::max();
+                break;
+            }
+            state.nextFireMs += pattern.intervalMs;
+        }
+    }
+}
+
+void EnemyBase::FirePatternRound(BulletManager* bulletManager, const EnemyPatternConfig& pattern,
+                                 float targetX, float targetY, Random* random) {
+    float centerX = GetCenterX();
+    float centerY = GetCenterY();
+
+    float baseAngle = pattern.angleDeg * DEG_TO_RAD;
+    if (pattern.aimAtPlayer) {
+        // 双人时瞄准最近的自机；目标快照为空时退回到管理器给的目标点
+        bulletManager->GetTargets().FindNearestPlayer(centerX, centerY, targetX, targetY);
+        baseAngle = std::atan2(targetY - centerY, targetX - centerX);
+    }
+    if (pattern.jitterDeg > 0.0f && random) {
+        baseAngle += random->Range(-pattern.jitterDeg, pattern.jitterDeg) * DEG_TO_RAD;
+    }
+
+    if (pattern.homingTurnDeg > 0.0f) {
+        BulletPattern::FireHomingFan(bulletManager, pattern.bulletType, BulletOwner::ENEMY, centerX, centerY,
+                                     baseAngle, pattern.spreadDeg * DEG_TO_RAD, pattern.ways, pattern.speed,
+                                     pattern.homingTurnDeg * DEG_TO_RAD / 1000.0f, pattern.homingMs);
+        return;
+    }
+    BulletPattern::FireFan(bulletManager, pattern.bulletType, BulletOwner::ENEMY, centerX, centerY,
+                           baseAngle, pattern.spreadDeg * DEG_TO_RAD, pattern.ways, pattern.speed);
+}
+
+void EnemyBase::Render(Renderer* renderer) {
+    if (!isActive) return;
+
+    if (sprite && sprite->IsLoaded()) {
+        const SDL_Rect* frame = (config && !config->frames.empty()) ? &config->frames[0] : nullptr;
+        sprite->Render(*renderer, static_cast<int>(x), static_cast<int>(y),
+                       static_cast<int>(width), static_cast<int>(height), frame);
+    } else {
+        // 无贴图时用方块占位
+        SDL_FRect rect = {x, y, width, height};
+        SDL_SetRenderDrawColor(renderer->GetRenderer(), 0, 0, 255, 255);
+        SDL_RenderFillRect(renderer->GetRenderer(), &rect);
+    }
+}
+
+void EnemyBase::Submit(RenderQueue& queue) const {
+    if (!isActive) return;
+
+    const float centerX = x + width * 0.5f;
+    const float centerY = y + height * 0.5f;
+    if (sprite && sprite->IsLoaded()) {
+        const SDL_Rect* frame = (config && !config->frames.empty()) ? &config->frames[0] : nullptr;
+        queue.SubmitQuad(RenderLayer::ENEMIES, 0, sprite.get(), frame, centerX, centerY, width, height,
+                         0.0f, SDL_Color{255, 255, 255, 255}, BlendMode::ALPHA);
+    } else {
+        queue.SubmitQuad(RenderLayer::ENEMIES, 0, nullptr, nullptr, centerX, centerY, width, height,
+                         0.0f, SDL_Color{0, 0, 255, 255}, BlendMode::ALPHA);
+    }
+}
+
+void EnemyBase::OnCollision(EntityBase* other) {
+    if (!other || !isActive) return;
+
+    if (other->GetType() == EntityType::PLAYER_BULLET) {
+        TakeDamage(static_cast<BulletBase*>(other)->GetDamage());
+    }
+}
+
+void EnemyBase::TakeDamage(float amount) {
+    if (killed) return;
+
+    hp -= amount;
+    if (hp <= 0.0f) {
+        killed = true;
+        OnKilled();
+        SetActive(false);
+    }
+}
+
+bool EnemyBase::ShouldDespawn() const {
+    return pathFinished && config && config->despawnAtPathEnd;
+}
+
+void EnemyBase::SaveState(StateWriter& writer) const {
+    writer.Write(x);
+    writer.Write(y);
+    writer.Write(isActive);
+    writer.Write(hp);
+    writer.Write(ageMs);
+    writer.Write(spawnX);
+    writer.Write(spawnY);
+    writer.Write(pathSegment);
+    writer.Write(pathFinished);
+    writer.Write(killed);
+    writer.Write(patternStates);
+}
+
+bool EnemyBase::LoadState(StateReader& reader) {
+    reader.Read(x);
+    reader.Read(y);
+    reader.Read(isActive);
+    reader.Read(hp);
+    reader.Read(ageMs);
+    reader.Read(spawnX);
+    reader.Read(spawnY);
+    reader.Read(pathSegment);
+    reader.Read(pathFinished);
+    reader.Read(killed);
+    reader.Read(patternStates);
+    return !reader.HasFailed();
+}
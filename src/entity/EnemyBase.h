@@ -0,0 +1,89 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef ENEMYBASE_H
+#define ENEMYBASE_H
+
+#include <array>
+#include <memory>
+#include "EntityBase.h"
+#include "../enemy/EnemyConfig.h"
+#include "../graphics/Sprite.h"
+#include "../graphics/Renderer.h"
+#include "../graphics/RenderQueue.h"
+
+class BulletManager;
+class Random;
+class StateWriter;
+class StateReader;
+
+/**
+ * 敌人基类（池化对象）
+ * 外观、生命值、路径和弹幕脚本全部来自 EnemyConfig，
+ * 对象本身只保存运行状态，重复使用时不做任何动态分配
+ */
+class EnemyBase : public EntityBase {
+public:
+    EnemyBase();
+    ~EnemyBase() override = default;
+
+    // 从配置初始化外观和碰撞体
+    bool InitializeFromConfig(const EnemyConfig* enemyConfig, std::shared_ptr<Sprite> sharedSprite);
+
+    // 在指定中心点出生，重置运行状态
+    void Spawn(float centerX, float centerY);
+
+    // 更新路径与计时
+    void Update(float deltaTime) override;
+
+    // 推进弹幕脚本（targetX/targetY 为自机中心，用于自机狙；random 用于方向抖动，可为空）
+    void UpdatePatterns(BulletManager* bulletManager, float targetX, float targetY, Random* random);
+
+    void Render(Renderer* renderer) override;
+    void Submit(RenderQueue& queue) const;   // 合批路径：贴图帧或占位方块
+    void OnCollision(EntityBase* other) override;
+
+    // 生命值
+    void TakeDamage(float amount);
+    [[nodiscard]] float GetHp() const { return hp; }
+    [[nodiscard]] bool IsKilled() const { return killed; }
+
+    // 路径是否已走完且需要回收
+    [[nodiscard]] bool ShouldDespawn() const;
+
+    [[nodiscard]] float GetAgeMs() const { return ageMs; }
+    [[nodiscard]] const EnemyConfig* GetConfig() const { return config; }
+
+    // 运行状态快照（配置与贴图由管理器按类型id重新绑定）
+    void SaveState(StateWriter& writer) const;
+    bool LoadState(StateReader& reader);
+
+protected:
+    // 供子类重写的钩子
+    virtual void OnKilled() {}
+
+    // 内部辅助
+    void ApplyPath();
+    void FirePatternRound(BulletManager* bulletManager, const EnemyPatternConfig& pattern,
+                          float targetX, float targetY, Random* random);
+
+    const EnemyConfig* config;
+    std::shared_ptr<Sprite> sprite;
+
+    float hp;
+    float ageMs;            // 出生后经过的时间
+    float spawnX, spawnY;   // 出生点（中心）
+    int pathSegment;        // 当前所在路径段（单调推进）
+    bool pathFinished;
+    bool killed;
+
+    // 每个弹幕脚本的运行状态
+    struct PatternState {
+        float nextFireMs;
+        int firedRounds;
+    };
+    std::array<PatternState, MAX_ENEMY_PATTERNS> patternStates;
+};
+
+#endif //ENEMYBASE_H
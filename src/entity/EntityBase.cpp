@@ -63,6 +63,21 @@ float EntityBase::DistanceTo(const EntityBase& other) const{
     return std::sqrt(dx * dx + dy * dy);
 }
 
+bool EntityBase::IsCollidingWith(const EntityBase& other) const {
+    if (isCircleCollider && other.isCircleCollider) {
+        return IsCollidingWithCircle(other);
+    }
+    if (isCircleCollider != other.isCircleCollider) {
+        return IsCollidingWithMixed(other);
+    }
+
+    // 两个矩形：AABB 相交
+    SDL_FRect a = GetColliderBounds();
+    SDL_FRect b = other.GetColliderBounds();
+    return a.x < b.x + b.w && b.x < a.x + a.w &&
+           a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
 bool EntityBase::IsCollidingWithCircle(const EntityBase& other) const {
     if (!isCircleCollider || !other.isCircleCollider) {
         return false;  // 至少有一个不是圆形
@@ -161,16 +176,17 @@ bool EntityBase::IsCollidingWithMixed(const EntityBase& other) const {
         return false;  // 两个都是矩形或都是圆形，不适用混合检测
     }
     
-    // 找到矩形上最近的点
-    float rectRight = rectangle->x + rectangle->width;
-    float rectBottom = rectangle->y + rectangle->height;
+    // 找到矩形碰撞体上最近的点
+    SDL_FRect rect = rectangle->GetColliderBounds();
+    float circleX = circle->x + circle->colliderX + circle->colliderRadius;
+    float circleY = circle->y + circle->colliderY + circle->colliderRadius;
     
-    float closestX = std::clamp(circle->GetCenterX(), rectangle->x, rectRight);
-    float closestY = std::clamp(circle->GetCenterY(), rectangle->y, rectBottom);
+    float closestX = std::clamp(circleX, rect.x, rect.x + rect.w);
+    float closestY = std::clamp(circleY, rect.y, rect.y + rect.h);
     
     // 计算圆心到最近点的距离
-    float distanceX = circle->GetCenterX() - closestX;
-    float distanceY = circle->GetCenterY() - closestY;
+    float distanceX = circleX - closestX;
+    float distanceY = circleY - closestY;
     float distance = std::sqrt(distanceX * distanceX + distanceY * distanceY);
     
     return distance < circle->colliderRadius;
@@ -3,16 +3,18 @@
 //
 
 #include "SelfMachinesBase.h"
+#include "../snapshot/StateBuffer.h"
 
 
 SelfMachineBase::SelfMachineBase(InputHandler* inputHandler,int windowWidth, int windowHeight)
     : EntityBase(EntityType::PLAYER),
-      inputHandler(inputHandler),renderer(nullptr) ,windowWidth(windowWidth), windowHeight(windowHeight),
+      inputHandler(inputHandler),inputBits(0),renderer(nullptr) ,windowWidth(windowWidth), windowHeight(windowHeight),
       currentState(PlayerState::NORMAL),
       speed(2.0f), focusSpeed(1.0f),  // ✅ 合理的默认速度
       bombCount(3), power(1.0f), lives(3), bombFragments(0),
       invincibleTimer(0.0f), bombTimer(0.0f),
-      visualHitPointRadius(2.0f), showHitPoint(false), debugMode(false) { // ✅ 初始化所有成员
+      visualHitPointRadius(2.0f), showHitPoint(false),
+      debugMode(false), grazeRadius(24.0f), grazeCount(0), score(0) { // ✅ 初始化所有成员
     
     sprite = std::make_unique<Sprite>();
 }
@@ -55,6 +57,37 @@ void SelfMachineBase::Render(Renderer* renderer) {
     }
 }
 
+void SelfMachineBase::Submit(RenderQueue& queue, uint16_t depth) const {
+    if (sprite && sprite->IsLoaded()) {
+        const float spriteWidth = static_cast<float>(sprite->GetWidth());
+        const float spriteHeight = static_cast<float>(sprite->GetHeight());
+        queue.SubmitQuad(RenderLayer::PLAYER, depth, sprite.get(), nullptr,
+                         x + spriteWidth * 0.5f, y + spriteHeight * 0.5f, spriteWidth, spriteHeight,
+                         0.0f, SDL_Color{255, 255, 255, 255}, BlendMode::ALPHA);
+    }
+
+    // 判定点：绿色方块加白色中心点，与 RenderHitPoint 一致
+    if (showHitPoint) {
+        const float centerX = x + width / 2.0f;
+        const float centerY = y + height / 2.0f;
+        queue.SubmitRect(RenderLayer::PLAYER, depth,
+                         SDL_FRect{centerX - visualHitPointRadius, centerY - visualHitPointRadius,
+                                   visualHitPointRadius * 2, visualHitPointRadius * 2},
+                         SDL_Color{0, 255, 0, 255});
+        queue.SubmitRect(RenderLayer::PLAYER, depth, SDL_FRect{centerX - 1, centerY - 1, 2, 2},
+                         SDL_Color{255, 255, 255, 255});
+    }
+
+    // 调试模式：碰撞体（无敌时黄色闪烁）
+    if (debugMode) {
+        SDL_Color colliderColor = {255, 0, 0, 128};
+        if (IsInvincible() && static_cast<int>(invincibleTimer / 83.0f) % 2 == 0) {
+            colliderColor = {255, 255, 0, 128};
+        }
+        queue.SubmitRect(RenderLayer::PLAYER, depth, UseCustomCollider() ? GetColliderBounds() : GetBounds(),
+                         colliderColor);
+    }
+}
 
 void SelfMachineBase::Initialize(Renderer* renderer) {
     this->renderer = renderer;
@@ -84,7 +117,7 @@ void SelfMachineBase::OnCollision(EntityBase* other) {
 void SelfMachineBase::HandleInput(float deltaTime) {
     // 集中模式切换：按住左Shift进入 FOCUS，松开回 NORMAL（不在炸弹/死亡状态时才切换）
     if (currentState != PlayerState::BOMBING && currentState != PlayerState::DEAD && currentState != PlayerState::INVINCIBLE) {
-        if (inputHandler->IsKeyPressed(SDLK_LSHIFT)) {
+        if (inputBits & PlayerInput::FOCUS) {
             if (currentState != PlayerState::FOCUS) {
                 SetState(PlayerState::FOCUS);
             }
@@ -103,22 +136,22 @@ void SelfMachineBase::HandleInput(float deltaTime) {
 void SelfMachineBase::HandleMovement(float deltaTime) {
     float currentSpeed = (currentState == PlayerState::FOCUS) ? focusSpeed : speed;
     
-    if (inputHandler->IsKeyPressed(SDLK_LEFT)) x -= currentSpeed * deltaTime;
-    if (inputHandler->IsKeyPressed(SDLK_RIGHT)) x += currentSpeed * deltaTime;
-    if (inputHandler->IsKeyPressed(SDLK_UP)) y -= currentSpeed * deltaTime;
-    if (inputHandler->IsKeyPressed(SDLK_DOWN)) y += currentSpeed * deltaTime;
+    if (inputBits & PlayerInput::LEFT) x -= currentSpeed * deltaTime;
+    if (inputBits & PlayerInput::RIGHT) x += currentSpeed * deltaTime;
+    if (inputBits & PlayerInput::UP) y -= currentSpeed * deltaTime;
+    if (inputBits & PlayerInput::DOWN) y += currentSpeed * deltaTime;
     
     ClampToScreen();
 }
 
 void SelfMachineBase::HandleShooting() {
-    if (inputHandler->IsKeyPressed(SDLK_Z)) {  // 东方用Z射击
+    if (inputBits & PlayerInput::SHOOT) {  // 东方用Z射击
         DoShoot();
     }
 }
 
 void SelfMachineBase::HandleBomb() {
-    if (inputHandler->IsKeyPressed(SDLK_X) && bombCount > 0) {
+    if ((inputBits & PlayerInput::BOMB) && bombCount > 0) {
         UseBomb();
     }
 }
@@ -180,7 +213,8 @@ void SelfMachineBase::AddBombFragment() {
 }
 
 void SelfMachineBase::UseBomb() {
-    if (bombCount > 0 && !IsInBombMode()) {
+    // 死亡后不能放炸弹（炸弹结束会把状态切回 NORMAL，等于复活）
+    if (IsAlive() && bombCount > 0 && !IsInBombMode()) {
         bombCount--;
         SetState(PlayerState::BOMBING);
         DoBomb();
@@ -198,6 +232,12 @@ void SelfMachineBase::TakeDamage() {
         }
     }
 }
+
+void SelfMachineBase::AddGraze() {
+    grazeCount++;
+    OnGraze();
+}
+
 //辅助功能
 void SelfMachineBase::UpdateTimers(float deltaTime) {
     if (invincibleTimer > 0) {
@@ -261,4 +301,35 @@ void SelfMachineBase::SetupPlayerCollider() {
     SetRectangleCollider(0.0f, 0.0f, width, height);
 }
 
+void SelfMachineBase::SaveState(StateWriter& writer) const {
+    writer.Write(x);
+    writer.Write(y);
+    writer.Write(isActive);
+    writer.Write(currentState);
+    writer.Write(bombCount);
+    writer.Write(power);
+    writer.Write(lives);
+    writer.Write(bombFragments);
+    writer.Write(invincibleTimer);
+    writer.Write(bombTimer);
+    writer.Write(showHitPoint);
+    writer.Write(grazeCount);
+    writer.Write(score);
+}
 
+bool SelfMachineBase::LoadState(StateReader& reader) {
+    reader.Read(x);
+    reader.Read(y);
+    reader.Read(isActive);
+    reader.Read(currentState);
+    reader.Read(bombCount);
+    reader.Read(power);
+    reader.Read(lives);
+    reader.Read(bombFragments);
+    reader.Read(invincibleTimer);
+    reader.Read(bombTimer);
+    reader.Read(showHitPoint);
+    reader.Read(grazeCount);
+    reader.Read(score);
+    return !reader.HasFailed();
+}
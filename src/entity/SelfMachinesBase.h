@@ -10,8 +10,12 @@
 #include "EntityBase.h"
 #include "../graphics/Sprite.h"
 #include "../graphics/Renderer.h"
+#include "../graphics/RenderQueue.h"
 #include "../input/InputHandler.h"
+#include "../input/PlayerInput.h"
 
+class StateWriter;
+class StateReader;
 
 // 机体状态枚举
 enum class PlayerState {
@@ -52,9 +56,17 @@ protected:
     //碰撞体
     float visualHitPointRadius;
     bool showHitPoint;
+
+    // 擦弹：以判定点圆心为中心、grazeRadius 为半径的外圈
+    float grazeRadius;
+    int grazeCount;              // 累计擦弹数
+    int64_t score;               // 得分
     
     // 输入处理器引用
     InputHandler* inputHandler;
+
+    // 本 tick 的输入（由外部每 tick 设置，模拟逻辑只读这个值）
+    PlayerInputBits inputBits;
     Renderer *renderer;
 
 public:
@@ -67,9 +79,15 @@ public:
     void Render(Renderer* renderer) override;
     void Initialize(Renderer* renderer) override;
     void OnDestroy() override;
+
+    // 提交到渲染队列的自机层：贴图为四边形，判定点和调试碰撞体为纯色矩形（画在贴图之上）
+    // depth 区分多个自机（1P/2P）的先后
+    void Submit(RenderQueue& queue, uint16_t depth) const;
     void OnCollision(EntityBase* other) override;
 
     // 输入处理
+    void SetInput(PlayerInputBits bits) { inputBits = bits; }
+    PlayerInputBits GetInput() const { return inputBits; }
     void HandleInput(float deltaTime);
     void HandleMovement(float deltaTime);
     void HandleShooting();
@@ -81,13 +99,22 @@ public:
     bool IsInvincible() const;
     bool IsInBombMode() const;
 
+    // 炸弹清弹半径（以判定点为圆心），不在放炸弹时为 0
+    virtual float GetBombClearRadius() const { return 0.0f; }
+
     // 资源操作
     void AddPower(float amount);
     void AddBomb();
     void AddLife();
     void AddBombFragment();
+    void AddScore(int64_t amount) { score += amount; }
     void UseBomb();
     void TakeDamage();
+
+    // 擦弹（由 BulletManager 的自机碰撞遍历调用，每颗子弹只计一次）
+    void AddGraze();
+    bool IsAlive() const { return isActive && currentState != PlayerState::DEAD; }
+    bool CanGraze() const { return IsAlive(); }
     
     // 访问器
     float GetSpeed() const { return speed; }
@@ -97,6 +124,9 @@ public:
     int GetLives() const { return lives; }
     int GetBombFragments() const { return bombFragments; }
     int GetPowerLevel() const { return static_cast<int>(power); }
+    float GetGrazeRadius() const { return grazeRadius; }
+    int GetGrazeCount() const { return grazeCount; }
+    int64_t GetScore() const { return score; }
     
     // 设置器
     void SetSpeed(float speed) { this->speed = speed; }
@@ -105,6 +135,7 @@ public:
     void SetPower(float power) { this->power = std::clamp(power, 0.0f, 4.0f); }
     void SetLives(int lives) { this->lives = lives; }
     void SetBombFragments(int fragments) { this->bombFragments = fragments; }
+    void SetGrazeRadius(float radius) { this->grazeRadius = std::max(0.0f, radius); }
 
     // 边界限制
     void ClampToScreen();
@@ -115,6 +146,10 @@ public:
     // 继承相关的碰撞体设置
     virtual void SetupPlayerCollider();
 
+    // 状态快照（位置、资源、计时器、当前状态），子类追加自己的字段
+    virtual void SaveState(StateWriter& writer) const;
+    virtual bool LoadState(StateReader& reader);
+
     //debug
     void SetDebugMode(bool enable) { debugMode = enable; }
     void RenderDebugInfo(Renderer* renderer);
@@ -126,6 +161,7 @@ protected:
     virtual void OnPowerUp() {}                  // 火力提升时
     virtual void OnBombCollected() {}           // 收集炸弹时
     virtual void OnDeath() {}                    // 死亡时
+    virtual void OnGraze() {}                    // 擦弹时
 
     // 辅助方法
     void UpdateTimers(float deltaTime);
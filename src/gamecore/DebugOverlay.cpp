@@ -0,0 +1,76 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "DebugOverlay.h"
+#include "../graphics/GlyphCache.h"
+#include "../graphics/RenderQueue.h"
+
+#include <algorithm>
+
+DebugOverlay::DebugOverlay() : tickHistory{}, tickCursor(0), tickSamples(0) {
+}
+
+void DebugOverlay::RecordTick(double ms) {
+    tickHistory[tickCursor] = ms;
+    tickCursor = (tickCursor + 1) % HISTORY_SIZE;
+    tickSamples = std::min(tickSamples + 1, HISTORY_SIZE);
+}
+
+double DebugOverlay::GetAverageTickMs() const {
+    if (tickSamples == 0) return 0.0;
+
+    double total = 0.0;
+    for (size_t i = 0; i < tickSamples; ++i) {
+        total += tickHistory[i];
+    }
+    return total / static_cast<double>(tickSamples);
+}
+
+double DebugOverlay::GetMaxTickMs() const {
+    return *std::max_element(tickHistory.begin(), tickHistory.end());
+}
+
+float DebugOverlay::Submit(RenderQueue& queue, const GlyphCache& font, const Stats& stats, float x, float y) const {
+    if (!font.IsLoaded()) return 0.0f;
+
+    const float lineHeight = static_cast<float>(font.GetLineHeight());
+    const float width = 330.0f;
+    const float height = lineHeight * LINE_COUNT + 8.0f;
+    const SDL_Color textColor = {230, 255, 230, 255};
+    const SDL_Color warnColor = {255, 120, 100, 255};
+
+    // 底板深度 0，文字深度 1（文字与底板同层，按深度先后绘制）
+    queue.SubmitQuad(RenderLayer::OVERLAY, 0, nullptr, nullptr, x + width * 0.5f, y + height * 0.5f,
+                     width, height, 0.0f, SDL_Color{0, 0, 0, 170}, BlendMode::ALPHA);
+
+    // tick 超出预算（60Hz 下约 16.7ms）时标红
+    const double maxTickMs = GetMaxTickMs();
+    const float left = x + 6.0f;
+    float lineY = y + 4.0f;
+    font.SubmitFormat(queue, RenderLayer::OVERLAY, 1, left, lineY, textColor, "FPS %5.1f", stats.fps);
+    lineY += lineHeight;
+    font.SubmitFormat(queue, RenderLayer::OVERLAY, 1, left, lineY, maxTickMs > 1000.0 / 60.0 ? warnColor : textColor,
+                      "TICK %5.2f ms  avg %5.2f  max %5.2f", GetLastTickMs(), GetAverageTickMs(), maxTickMs);
+    lineY += lineHeight;
+    font.SubmitFormat(queue, RenderLayer::OVERLAY, 1, left, lineY, textColor, "BULLETS %zu  peak %zu",
+                      stats.activeBullets, stats.peakBullets);
+    lineY += lineHeight;
+    font.SubmitFormat(queue, RenderLayer::OVERLAY, 1, left, lineY, textColor, "POOL %zu  free %zu  enemies %zu",
+                      stats.bulletPoolSize, stats.freeBullets, stats.activeEnemies);
+    lineY += lineHeight;
+    font.SubmitFormat(queue, RenderLayer::OVERLAY, 1, left, lineY, textColor, "DRAW CALLS %d  tex %d  blend %d",
+                      stats.drawCalls, stats.textureSwitches, stats.blendSwitches);
+    lineY += lineHeight;
+    font.SubmitFormat(queue, RenderLayer::OVERLAY, 1, left, lineY, textColor, "QUEUE %zu cmds  INPUT p95 %.1f ms",
+                      stats.queueCommands, stats.inputLatencyP95Ms);
+    lineY += lineHeight;
+    font.SubmitFormat(queue, RenderLayer::OVERLAY, 1, left, lineY, textColor,
+                      "P95 frame %.1f  upd %.2f  col %.2f  rnd %.2f", stats.frameP95Ms, stats.updateP95Ms, stats.collisionP95Ms, stats.renderP95Ms);
+    lineY += lineHeight;
+    font.SubmitFormat(queue, RenderLayer::OVERLAY, 1, left, lineY, textColor, "SPAWNS %llu/s  POOL GROWTHS %llu",
+                      static_cast<unsigned long long>(stats.spawnsPerSecond),
+                      static_cast<unsigned long long>(stats.poolGrowths));
+
+    return height;
+}
@@ -0,0 +1,68 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef DEBUGOVERLAY_H
+#define DEBUGOVERLAY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class RenderQueue;
+class GlyphCache;
+
+/**
+ * 屏幕调试信息
+ * 模拟线程每 tick 记录一次耗时，构建渲染队列时把帧率、tick 耗时、子弹池和绘制统计
+ * 用字形缓存画在 OVERLAY 层左下角。耗时历史是定长环形缓冲，文字在栈上格式化，每帧不分配内存
+ */
+class DebugOverlay {
+public:
+    // 一帧要显示的统计（由 Game 从各管理器和渲染线程的原子量收集）
+    struct Stats {
+        double fps = 0.0;
+        size_t activeBullets = 0;
+        size_t peakBullets = 0;
+        size_t bulletPoolSize = 0;
+        size_t freeBullets = 0;
+        size_t activeEnemies = 0;
+        int drawCalls = 0;
+        int textureSwitches = 0;
+        int blendSwitches = 0;
+        size_t queueCommands = 0;
+
+        // MetricsRegistry 最近一秒的 p95（毫秒）与子弹生成/扩池
+        double frameP95Ms = 0.0;
+        double updateP95Ms = 0.0;
+        double collisionP95Ms = 0.0;
+        double renderP95Ms = 0.0;
+        double inputLatencyP95Ms = 0.0;     // 按键事件到消费它的 tick
+        uint64_t spawnsPerSecond = 0;
+        uint64_t poolGrowths = 0;
+    };
+
+    DebugOverlay();
+
+    // 记录一个 tick 的耗时（毫秒）
+    void RecordTick(double ms);
+
+    // 以 (x, y) 为左上角提交调试面板，返回面板高度；字体未加载时不提交
+    float Submit(RenderQueue& queue, const GlyphCache& font, const Stats& stats, float x, float y) const;
+
+    double GetLastTickMs() const { return tickHistory[(tickCursor + HISTORY_SIZE - 1) % HISTORY_SIZE]; }
+    double GetAverageTickMs() const;
+    double GetMaxTickMs() const;
+
+    static constexpr int LINE_COUNT = 8;
+
+private:
+    // 最近一秒（60 tick）的耗时
+    static constexpr size_t HISTORY_SIZE = 60;
+
+    std::array<double, HISTORY_SIZE> tickHistory;
+    size_t tickCursor;
+    size_t tickSamples;
+};
+
+#endif //DEBUGOVERLAY_H
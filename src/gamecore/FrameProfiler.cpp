@@ -0,0 +1,248 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "FrameProfiler.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+    constexpr const char* TRACK_NAMES[] = {"SIMULATION", "RENDER"};
+    constexpr const char* PHASE_NAMES[] = {"UPDATE", "BUILD_QUEUE", "SLEEP", "OVERSLEEP",
+                                           "EVENTS", "DRAW", "PRESENT", "FRAME_DELAY"};
+    constexpr const char* MARKER_NAMES[] = {"POOL_EXPANSION", "TEXTURE_LOAD", "CONFIG_LOAD",
+                                            "CHECKPOINT", "ROLLBACK", "SEEK"};
+
+    static_assert(std::size(TRACK_NAMES) == static_cast<size_t>(FrameTrack::COUNT));
+    static_assert(std::size(PHASE_NAMES) == static_cast<size_t>(FramePhase::COUNT));
+    static_assert(std::size(MARKER_NAMES) == static_cast<size_t>(FrameMarker::COUNT));
+}
+
+FrameProfiler& FrameProfiler::Instance() {
+    static FrameProfiler instance;
+    return instance;
+}
+
+FrameProfiler::FrameProfiler()
+    : startTime(std::chrono::steady_clock::now()),
+      markerNext(0),
+      markerCount(0),
+      saveRequested(false),
+      lastSaveMs(-SAVE_COOLDOWN_MS),
+      running(false),
+      thresholdMs(25.0),
+      windowMs(5000.0),
+      savedCount(0),
+      spikeCount(0) {
+    for (Track& track : tracks) {
+        track.frames.resize(CAPACITY);
+    }
+    markers.resize(MARKER_CAPACITY);
+}
+
+FrameProfiler::~FrameProfiler() {
+    Stop();
+}
+
+const char* FrameProfiler::GetTrackName(FrameTrack track) {
+    return track < FrameTrack::COUNT ? TRACK_NAMES[static_cast<size_t>(track)] : "UNKNOWN";
+}
+
+const char* FrameProfiler::GetPhaseName(FramePhase phase) {
+    return phase < FramePhase::COUNT ? PHASE_NAMES[static_cast<size_t>(phase)] : "UNKNOWN";
+}
+
+const char* FrameProfiler::GetMarkerName(FrameMarker marker) {
+    return marker < FrameMarker::COUNT ? MARKER_NAMES[static_cast<size_t>(marker)] : "UNKNOWN";
+}
+
+bool FrameProfiler::Start(const std::string& directory, double threshold, double windowSeconds) {
+    if (running.load(std::memory_order_acquire)) return true;
+
+    captureDirectory = directory;
+    thresholdMs.store(threshold, std::memory_order_relaxed);
+    windowMs = std::max(windowSeconds, 0.5) * 1000.0;
+    copyFrames.resize(CAPACITY);
+    copyMarkers.resize(MARKER_CAPACITY);
+
+    running.store(true, std::memory_order_release);
+    saver = std::thread(&FrameProfiler::SaverLoop, this);
+    return true;
+}
+
+void FrameProfiler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(saveMutex);
+        if (!running.exchange(false, std::memory_order_acq_rel)) return;
+    }
+    saveCondition.notify_all();
+    if (saver.joinable()) {
+        saver.join();
+    }
+}
+
+double FrameProfiler::Now() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void FrameProfiler::BeginFrame(FrameTrack track) {
+    Track& t = tracks[static_cast<size_t>(track)];
+    t.current = FrameRecord{};
+    t.current.frame = t.frameCounter++;
+    t.current.startMs = Now();
+}
+
+void FrameProfiler::AddPhase(FrameTrack track, FramePhase phase, double ms) {
+    if (phase >= FramePhase::COUNT) return;
+    tracks[static_cast<size_t>(track)].current.phases[static_cast<size_t>(phase)] += static_cast<float>(ms);
+}
+
+void FrameProfiler::EndFrame(FrameTrack track) {
+    Track& t = tracks[static_cast<size_t>(track)];
+    const double now = Now();
+    t.current.totalMs = static_cast<float>(now - t.current.startMs);
+    {
+        std::lock_guard<std::mutex> lock(t.mutex);
+        t.frames[t.next] = t.current;
+        t.next = (t.next + 1) % CAPACITY;
+        t.count = std::min(t.count + 1, CAPACITY);
+    }
+
+    if (t.current.totalMs <= thresholdMs.load(std::memory_order_relaxed)) return;
+    spikeCount.fetch_add(1, std::memory_order_relaxed);
+    if (!running.load(std::memory_order_acquire)) return;
+
+    // 冷却期内的连续超时视为同一次卡顿，不重复保存
+    std::lock_guard<std::mutex> lock(saveMutex);
+    if (saveRequested || now - lastSaveMs < SAVE_COOLDOWN_MS) return;
+    pendingRequest = SaveRequest{track, t.current.frame, t.current.startMs, t.current.totalMs};
+    saveRequested = true;
+    lastSaveMs = now;
+    saveCondition.notify_one();
+}
+
+void FrameProfiler::Mark(FrameMarker marker, double durationMs, const char* label) {
+    const double now = Now();
+    std::lock_guard<std::mutex> lock(markerMutex);
+    MarkerRecord& record = markers[markerNext];
+    // 标记在事件结束时打，记录事件开始的时间
+    record.timeMs = now - durationMs;
+    record.durationMs = static_cast<float>(durationMs);
+    record.type = marker;
+    record.label[0] = '\0';
+    if (label) {
+        // 超长时保留结尾（路径的文件名部分更有用）；空白换成下划线，捕获文件按空白分列
+        const size_t length = std::strlen(label);
+        const char* source = length >= LABEL_SIZE ? label + (length - (LABEL_SIZE - 1)) : label;
+        size_t i = 0;
+        for (; source[i] && i < LABEL_SIZE - 1; ++i) {
+            record.label[i] = (source[i] == ' ' || source[i] == '\t') ? '_' : source[i];
+        }
+        record.label[i] = '\0';
+    }
+    markerNext = (markerNext + 1) % MARKER_CAPACITY;
+    markerCount = std::min(markerCount + 1, MARKER_CAPACITY);
+}
+
+void FrameProfiler::RequestSave() {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    if (saveRequested) return;
+    pendingRequest = SaveRequest{FrameTrack::COUNT, 0, Now(), 0.0f};
+    saveRequested = true;
+    saveCondition.notify_one();
+}
+
+void FrameProfiler::SaverLoop() {
+    std::unique_lock<std::mutex> lock(saveMutex);
+    while (true) {
+        saveCondition.wait(lock, [this] { return saveRequested || !running.load(std::memory_order_acquire); });
+        if (!running.load(std::memory_order_acquire)) break;
+
+        SaveRequest request = pendingRequest;
+        lock.unlock();
+        WriteCapture(request);
+        lock.lock();
+        saveRequested = false;
+    }
+}
+
+void FrameProfiler::WriteCapture(const SaveRequest& request) {
+    std::error_code error;
+    std::filesystem::create_directories(captureDirectory, error);
+
+    char fileName[96];
+    std::snprintf(fileName, sizeof(fileName), "spike_%s_%llu_%.0f.fcap",
+                  request.track < FrameTrack::COUNT ? GetTrackName(request.track) : "MANUAL",
+                  static_cast<unsigned long long>(request.frame), request.timeMs);
+    const std::string path = (std::filesystem::path(captureDirectory) / fileName).string();
+
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        LOG_WARN("FrameProfiler: failed to write {}", path);
+        return;
+    }
+
+    // 表头：阶段和标记名写进文件，分析工具不依赖这里的枚举顺序
+    const double windowStart = request.timeMs - windowMs;
+    std::fprintf(file, "# frame capture v1\n");
+    std::fprintf(file, "threshold_ms %.3f\n", thresholdMs.load(std::memory_order_relaxed));
+    std::fprintf(file, "trigger %s %llu %.3f %.3f\n",
+                 request.track < FrameTrack::COUNT ? GetTrackName(request.track) : "MANUAL",
+                 static_cast<unsigned long long>(request.frame), request.timeMs, request.totalMs);
+    std::fprintf(file, "phases");
+    for (const char* name : PHASE_NAMES) {
+        std::fprintf(file, " %s", name);
+    }
+    std::fprintf(file, "\n");
+
+    // 帧：F 轨道 帧号 开始 总耗时 各阶段...（触发之后已经记录的帧也一起写出，便于看恢复过程）
+    for (size_t trackIndex = 0; trackIndex < TRACK_COUNT; ++trackIndex) {
+        Track& track = tracks[trackIndex];
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(track.mutex);
+            const size_t first = (track.next + CAPACITY - track.count) % CAPACITY;
+            for (size_t i = 0; i < track.count; ++i) {
+                const FrameRecord& frame = track.frames[(first + i) % CAPACITY];
+                if (frame.startMs + frame.totalMs >= windowStart) {
+                    copyFrames[count++] = frame;
+                }
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const FrameRecord& frame = copyFrames[i];
+            std::fprintf(file, "F %s %llu %.3f %.3f", TRACK_NAMES[trackIndex],
+                         static_cast<unsigned long long>(frame.frame), frame.startMs, frame.totalMs);
+            for (float phase : frame.phases) {
+                std::fprintf(file, " %.3f", phase);
+            }
+            std::fprintf(file, "\n");
+        }
+    }
+
+    // 标记：M 开始时间 耗时 类型 说明
+    size_t markerTotal = 0;
+    {
+        std::lock_guard<std::mutex> lock(markerMutex);
+        const size_t first = (markerNext + MARKER_CAPACITY - markerCount) % MARKER_CAPACITY;
+        for (size_t i = 0; i < markerCount; ++i) {
+            const MarkerRecord& marker = markers[(first + i) % MARKER_CAPACITY];
+            if (marker.timeMs + marker.durationMs >= windowStart) {
+                copyMarkers[markerTotal++] = marker;
+            }
+        }
+    }
+    for (size_t i = 0; i < markerTotal; ++i) {
+        const MarkerRecord& marker = copyMarkers[i];
+        std::fprintf(file, "M %.3f %.3f %s %s\n", marker.timeMs, marker.durationMs, GetMarkerName(marker.type),
+                     marker.label[0] ? marker.label : "-");
+    }
+
+    std::fclose(file);
+    savedCount.fetch_add(1, std::memory_order_relaxed);
+    LOG_INFO("FrameProfiler: saved capture {} ({} ms frame)", path, request.totalMs);
+}
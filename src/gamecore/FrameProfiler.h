@@ -0,0 +1,166 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 帧所属的线程（每条轨道只由一个线程写入）
+enum class FrameTrack : uint8_t {
+    SIMULATION,     // 模拟线程：一次循环 = 若干 tick + 构建渲染队列 + 睡眠
+    RENDER,         // 主线程：事件 + 绘制 + 呈现 + 帧率控制
+    COUNT
+};
+
+// 帧内阶段（毫秒）；各轨道只用到其中一部分
+enum class FramePhase : uint8_t {
+    UPDATE,         // 模拟：本次循环推进的所有 tick
+    BUILD_QUEUE,    // 模拟：提交并发布渲染队列
+    SLEEP,          // 模拟：按计划睡眠的部分
+    OVERSLEEP,      // 模拟/渲染：SDL_Delay 超出请求时长的部分
+    EVENTS,         // 渲染：事件泵
+    DRAW,           // 渲染：执行渲染队列
+    PRESENT,        // 渲染：呈现
+    FRAME_DELAY,    // 渲染：帧率控制的睡眠
+    COUNT
+};
+
+// 帧外事件标记
+enum class FrameMarker : uint8_t {
+    POOL_EXPANSION,     // 对象池扩容
+    TEXTURE_LOAD,       // 贴图加载/创建
+    CONFIG_LOAD,        // 配置/关卡文件加载
+    CHECKPOINT,         // 快照保存（整块序列化，类似 GC 的集中开销）
+    ROLLBACK,           // 回滚重算
+    SEEK,               // 练习模式跳转（恢复 + 快进）
+    COUNT
+};
+
+/**
+ * FrameProfiler - 卡顿捕获
+ * 职责：
+ * 1. 每条轨道保存最近 CAPACITY 帧的阶段耗时（环形缓冲，预先分配）
+ * 2. 任意线程可以打事件标记（池扩容、贴图加载等），附带耗时和简短说明
+ * 3. 某帧总耗时超过阈值时通知后台线程，把所有轨道最近 windowSeconds 秒的帧和标记写成文本文件
+ *    （同一次卡顿引起的连续超时只保存一次，两次保存至少间隔 SAVE_COOLDOWN_MS）
+ *
+ * 写入方每帧只在 EndFrame 时加一次（无竞争的）锁，文件写出全部在后台线程。
+ * 捕获文件用 tools/SpikeAnalyzer 分析
+ */
+class FrameProfiler {
+public:
+    static FrameProfiler& Instance();
+
+    ~FrameProfiler();
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    // 启动保存线程；捕获文件写到 directory 下
+    bool Start(const std::string& directory, double thresholdMs = 25.0, double windowSeconds = 5.0);
+    void Stop();
+
+    // 相对于分析器创建的毫秒时间（所有轨道和标记共用）
+    double Now() const;
+
+    // 帧记录（每条轨道只能由一个线程调用）
+    void BeginFrame(FrameTrack track);
+    void AddPhase(FrameTrack track, FramePhase phase, double ms);
+    void EndFrame(FrameTrack track);
+
+    // 事件标记（任意线程）；label 被拷贝，超长截断
+    void Mark(FrameMarker marker, double durationMs, const char* label = nullptr);
+
+    // 立即保存一次（调试热键用）
+    void RequestSave();
+
+    uint64_t GetSavedCount() const { return savedCount.load(std::memory_order_relaxed); }
+    uint64_t GetSpikeCount() const { return spikeCount.load(std::memory_order_relaxed); }
+
+    static const char* GetTrackName(FrameTrack track);
+    static const char* GetPhaseName(FramePhase phase);
+    static const char* GetMarkerName(FrameMarker marker);
+
+    static constexpr size_t CAPACITY = 1024;            // 每条轨道的帧数（60 帧/秒下约 17 秒）
+    static constexpr size_t MARKER_CAPACITY = 256;
+    static constexpr size_t LABEL_SIZE = 48;
+    static constexpr double SAVE_COOLDOWN_MS = 2000.0;
+
+private:
+    static constexpr size_t TRACK_COUNT = static_cast<size_t>(FrameTrack::COUNT);
+    static constexpr size_t PHASE_COUNT = static_cast<size_t>(FramePhase::COUNT);
+
+    struct FrameRecord {
+        uint64_t frame = 0;
+        double startMs = 0.0;
+        float totalMs = 0.0f;
+        std::array<float, PHASE_COUNT> phases{};
+    };
+
+    struct MarkerRecord {
+        double timeMs = 0.0;
+        float durationMs = 0.0f;
+        FrameMarker type = FrameMarker::POOL_EXPANSION;
+        char label[LABEL_SIZE] = {};
+    };
+
+    struct Track {
+        std::mutex mutex;                   // 保护 frames/next/count（写入方每帧一次，保存线程复制时）
+        std::vector<FrameRecord> frames;
+        size_t next = 0;
+        size_t count = 0;
+        FrameRecord current;                // 只有写入线程访问
+        uint64_t frameCounter = 0;
+    };
+
+    // 保存请求：触发的轨道与帧
+    struct SaveRequest {
+        FrameTrack track = FrameTrack::SIMULATION;
+        uint64_t frame = 0;
+        double timeMs = 0.0;
+        float totalMs = 0.0f;
+    };
+
+    FrameProfiler();
+
+    void SaverLoop();
+    void WriteCapture(const SaveRequest& request);
+
+    std::chrono::steady_clock::time_point startTime;
+    std::array<Track, TRACK_COUNT> tracks;
+
+    std::mutex markerMutex;
+    std::vector<MarkerRecord> markers;
+    size_t markerNext;
+    size_t markerCount;
+
+    // 保存线程
+    std::thread saver;
+    std::mutex saveMutex;
+    std::condition_variable saveCondition;
+    bool saveRequested;
+    SaveRequest pendingRequest;
+    double lastSaveMs;
+    std::atomic<bool> running;
+    std::atomic<double> thresholdMs;
+    double windowMs;
+    std::string captureDirectory;
+    std::atomic<uint64_t> savedCount;
+    std::atomic<uint64_t> spikeCount;
+
+    // 保存线程的复制缓冲（Start 时分配）
+    std::vector<FrameRecord> copyFrames;
+    std::vector<MarkerRecord> copyMarkers;
+};
+
+#endif //FRAMEPROFILER_H
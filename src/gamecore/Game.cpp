@@ -4,6 +4,34 @@
 
 #include "Game.h"
 #include "../player/TestPlayer.h"
+#include "../manager/BulletManager.h"
+#include "../manager/EnemyManager.h"
+#include "../manager/ItemManager.h"
+#include "../bullet/BulletPattern.h"
+#include "../net/LoopbackTransport.h"
+#include "../net/RollbackSession.h"
+#include "../net/UdpTransport.h"
+#include "../snapshot/StateBuffer.h"
+#include "FrameProfiler.h"
+#include "Logger.h"
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+namespace {
+    constexpr float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+
+    // HUD 和调试信息共用的字体，按顺序尝试；缓存全部可打印 ASCII
+    constexpr const char* TEXT_FONT_PATHS[] = {
+        "assert/font/hud.ttf",
+        "C:/Windows/Fonts/consola.ttf",
+        "C:/Windows/Fonts/arial.ttf",
+    };
+    constexpr float TEXT_FONT_SIZE = 16.0f;
+}
 
 Game::Game() {
   gameRunning = true;
@@ -21,23 +49,86 @@ int Game::Run() {
     return -1;
   }
 
+  // SDL 的窗口事件和渲染只能在主线程调用：主线程负责事件与绘制，模拟放到单独的线程。
+  // 模拟第 N+1 tick 与呈现第 N tick 重叠，呈现慢（等垂直同步等）不再挤占模拟时间
+  simulationThread = std::thread(&Game::SimulationLoop, this);
+
+  FrameProfiler& profiler = FrameProfiler::Instance();
   while (gameRunning) {
-    currentFrameTime = SDL_GetPerformanceCounter();
-    deltaTime = (double)((currentFrameTime - lastFrameTime) * 1000 / (double)SDL_GetPerformanceFrequency());
-    lastFrameTime = currentFrameTime;
+    renderFrameStart = SDL_GetPerformanceCounter();
+    profiler.BeginFrame(FrameTrack::RENDER);
 
+    double eventsBegin = profiler.Now();
     HandleEvents();
-    Update();
+    profiler.AddPhase(FrameTrack::RENDER, FramePhase::EVENTS, profiler.Now() - eventsBegin);
+
     Render();
     FrameRateControl();
+    profiler.EndFrame(FrameTrack::RENDER);
+  }
+
+  if (simulationThread.joinable()) {
+    simulationThread.join();
   }
 
   Cleanup();
   return 0;
 }
 
+void Game::SimulationLoop() {
+  FrameProfiler& profiler = FrameProfiler::Instance();
+  lastFrameTime = SDL_GetPerformanceCounter();
+
+  while (gameRunning) {
+    profiler.BeginFrame(FrameTrack::SIMULATION);
+    currentFrameTime = SDL_GetPerformanceCounter();
+    deltaTime = (double)((currentFrameTime - lastFrameTime) * 1000 / (double)SDL_GetPerformanceFrequency());
+    lastFrameTime = currentFrameTime;
+
+    // 固定步长：按累积时间推进整数个 tick（卡顿时最多追 250ms）
+    tickAccumulator += std::min(deltaTime, 250.0);
+    bool ticked = false;
+    while (tickAccumulator >= TICK_MS && gameRunning) {
+      Uint64 tickBegin = SDL_GetPerformanceCounter();
+      Update();
+      double tickMs = static_cast<double>(SDL_GetPerformanceCounter() - tickBegin) * 1000.0 /
+                      static_cast<double>(SDL_GetPerformanceFrequency());
+      debugOverlay.RecordTick(tickMs);
+      RecordTickMetrics(tickMs);
+      profiler.AddPhase(FrameTrack::SIMULATION, FramePhase::UPDATE, tickMs);
+      tickAccumulator -= TICK_MS;
+      ticked = true;
+    }
+
+    // 一批 tick 只发布最后的状态
+    if (ticked) {
+      double buildBegin = profiler.Now();
+      BuildRenderQueue();
+      profiler.AddPhase(FrameTrack::SIMULATION, FramePhase::BUILD_QUEUE, profiler.Now() - buildBegin);
+    }
+
+    // 睡到下一个 tick；实际睡眠超出请求的部分单独记为 OVERSLEEP
+    double waitMs = TICK_MS - tickAccumulator;
+    if (waitMs >= 1.0) {
+      Uint32 requestedMs = static_cast<Uint32>(waitMs);
+      double sleepBegin = profiler.Now();
+      SDL_Delay(requestedMs);
+      double sleptMs = profiler.Now() - sleepBegin;
+      profiler.AddPhase(FrameTrack::SIMULATION, FramePhase::SLEEP, std::min<double>(sleptMs, requestedMs));
+      profiler.AddPhase(FrameTrack::SIMULATION, FramePhase::OVERSLEEP, std::max(0.0, sleptMs - requestedMs));
+    }
+    profiler.EndFrame(FrameTrack::SIMULATION);
+  }
+}
+
 bool Game::Initialize(){
-    if(SDL_Init(SDL_INIT_VIDEO) < 0){
+    // 日志后台线程最先启动，帧内日志只写环形缓冲
+    Logger::Instance().Start();
+
+    // 卡顿捕获：超过 25ms 的帧触发保存最近 5 秒（初始化期间的加载标记也在窗口内）
+    FrameProfiler::Instance().Start("captures");
+
+    if(!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMEPAD)){
         std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
@@ -46,22 +137,149 @@ bool Game::Initialize(){
 
     gameRenderer = std::make_unique<Renderer>();
     gameInputHandler = std::make_unique<InputHandler>();
+    gameInputHandler->LoadBindings("assert/input.json");
 
     if(!gameRenderer->Initialize(windowTitle, windowWidth, windowHeight)){
         std::cout << "Failed to initialize renderer" << std::endl;
         return false;
     }
 
+    // HUD 与调试信息的字形图集（字体缺失时不显示文字）
+    textFont = std::make_unique<GlyphCache>();
+    if (TTF_Init()) {
+        for (const char* fontPath : TEXT_FONT_PATHS) {
+            if (textFont->Initialize(*gameRenderer, fontPath, TEXT_FONT_SIZE)) {
+                break;
+            }
+        }
+    } else {
+        std::cerr << "SDL_ttf could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+    }
+    renderTargetCache = std::make_unique<RenderTargetCache>(windowWidth, windowHeight);
+
     // 创建并初始化玩家
-    player = std::make_unique<TestPlayer>(gameInputHandler.get(), windowWidth, windowHeight);
+    player = std::make_shared<TestPlayer>(gameInputHandler.get(), windowWidth, windowHeight);
     player->Initialize(gameRenderer.get());
 
+    // 2P 在这里创建好：加载贴图要调用渲染器，联机开始时（模拟线程）只恢复初始状态
+    coopPlayerReserve = std::make_shared<TestPlayer>(gameInputHandler.get(), windowWidth, windowHeight);
+    coopPlayerReserve->Initialize(gameRenderer.get());
+    coopPlayerReserve->Move(80.0f, 0.0f);
+    StateWriter coopWriter(coopPlayerInitialState);
+    coopPlayerReserve->SaveState(coopWriter);
+
+    // 子弹管理器（配置缺失时不影响其余系统运行）
+    bulletManager = std::make_unique<BulletManager>();
+    if (!bulletManager->Initialize("assert/bullet_assert", *gameRenderer)) {
+        std::cerr << "BulletManager unavailable, bullets disabled" << std::endl;
+        bulletManager.reset();
+    }
+
+    // 道具池（固定容量，清弹转换和掉落共用）
+    itemManager = std::make_unique<ItemManager>();
+    itemManager->SetBottomBound(static_cast<float>(windowHeight));
+    clearedBulletPositions.reserve(10000);
+
+    // 敌人管理器
+    enemyManager = std::make_unique<EnemyManager>();
+    if (!enemyManager->Initialize("assert/enemy_assert", *gameRenderer, bulletManager.get())) {
+        std::cerr << "EnemyManager unavailable, enemies disabled" << std::endl;
+        enemyManager.reset();
+    } else {
+        enemyManager->SetRandom(&simulationRandom);
+        enemyManager->SetItemManager(itemManager.get());
+    }
+
+    // 关卡时间轴
+    stageTimeline = std::make_unique<StageTimeline>();
+    stageTimeline->SetEventHandler([this](const StageEvent& event, const StageData& data) {
+        HandleStageEvent(event, data);
+    });
+    if (stageTimeline->Load("assert/stage/stage1.json", "assert/stage/stage1.stgb")) {
+        // tick 0 的检查点保证任意位置都能跳转
+        std::vector<uint8_t> initialState;
+        CaptureCheckpoint(initialState);
+        stageTimeline->StoreCheckpoint(std::move(initialState));
+
+        // 背景贴图在主线程预先加载，模拟线程只按路径查表
+        const StageData& stageData = stageTimeline->GetStageData();
+        for (const StageEvent& event : stageData.events) {
+            const std::string& texturePath = stageData.GetString(event.nameIndex);
+            if (event.type != StageEventType::SET_BACKGROUND || texturePath.empty() ||
+                backgroundCache.count(texturePath)) {
+                continue;
+            }
+            auto sprite = std::make_unique<Sprite>();
+            if (!sprite->LoadFromFile(texturePath, *gameRenderer)) {
+                sprite.reset();
+            }
+            backgroundCache.emplace(texturePath, std::move(sprite));
+        }
+    }
+
+    // 更新调度器：保留一个核心给主线程
+    unsigned int hardwareThreads = std::max(2u, std::thread::hardware_concurrency());
+    scheduler = std::make_unique<SystemScheduler>(std::min(3u, hardwareThreads - 1));
+    RegisterSystemStages();
+
+    // 渲染队列：所有绘制按层/混合模式/贴图排序后合批，切换次数和呈现耗时显示在调度器调试视图中
+    renderExchange = std::make_unique<RenderExchange>();
+    drawCallCounter = scheduler->AddCounter("draw_calls");
+    textureSwitchCounter = scheduler->AddCounter("texture_switches");
+    blendSwitchCounter = scheduler->AddCounter("blend_switches");
+    presentCounter = scheduler->AddCounter("present_ms");
+    layerRedrawCounter = scheduler->AddCounter("layer_redraws");
+
+    // 运行期指标：在这里注册完，Start 之后注册表不再变化（管理器在各自 Initialize 中注册）
+    MetricsRegistry& metrics = MetricsRegistry::Instance();
+    frameMetric = metrics.AddLatencyHistogram("frame_ms");
+    updateMetric = metrics.AddLatencyHistogram("update_ms");
+    collisionMetric = metrics.AddLatencyHistogram("collision_ms");
+    renderMetric = metrics.AddLatencyHistogram("render_ms");
+    static constexpr double SPAWN_BOUNDS[] = {0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512};
+    spawnsPerTickMetric = metrics.AddHistogram("spawns_per_tick", SPAWN_BOUNDS,
+                                               static_cast<int>(std::size(SPAWN_BOUNDS)));
+    activeBulletsGauge = metrics.AddGauge("active_bullets");
+    activeEnemiesGauge = metrics.AddGauge("active_enemies");
+    metrics.Start();
+
     gameRunning = true;
 
     return true;
 }
 
 void Game::Cleanup(){
+    // 先停止模拟线程并结束联机会话，再停止调度器的工作线程，最后释放各系统
+    gameRunning = false;
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
+    StopNetSession();
+
+    if(scheduler){
+        scheduler.reset();
+    }
+
+    backgroundCache.clear();
+    renderTargetCache.reset();
+    textFont.reset();
+
+    if(stageTimeline){
+        stageTimeline.reset();
+    }
+
+    if(enemyManager){
+        enemyManager.reset();
+    }
+
+    if(itemManager){
+        itemManager.reset();
+    }
+
+    if(bulletManager){
+        bulletManager.reset();
+    }
+
     if(gameRenderer){
         gameRenderer->Cleanup();
         gameRenderer.reset();
@@ -74,42 +292,663 @@ void Game::Cleanup(){
     if(player){
         player.reset();
     }
-    
+    coopPlayerReserve.reset();
+    renderExchange.reset();
+
+    if (TTF_WasInit()) {
+        TTF_Quit();
+    }
     SDL_Quit();
+
+    MetricsRegistry::Instance().Stop();
+    MetricsRegistry::Instance().StopDump();
+    FrameProfiler::Instance().Stop();
+
+    // 写完剩余日志（之后的日志在调用线程上同步输出）
+    Logger::Instance().Stop();
+}
+
+void Game::RegisterSystemStages() {
+    using namespace SystemData;
+
+    // 输入：把本 tick 的输入位交给自机（键盘在 PollInput 中采样，联机时由回滚会话提供）
+    inputStage = scheduler->AddStage("Input", 0, INPUT | PLAYER, [this](float) {
+        if (player) {
+            player->SetInput(tickInputs[0]);
+        }
+        if (coopPlayer) {
+            coopPlayer->SetInput(tickInputs[1]);
+        }
+    });
+
+    // 自机：读输入，写自机状态
+    playerStage = scheduler->AddStage("Player", INPUT, PLAYER, [this](float deltaTime) {
+        if (player) {
+            player->Update(deltaTime);
+        }
+        if (coopPlayer) {
+            coopPlayer->Update(deltaTime);
+        }
+    });
+
+    // 瞄准目标快照：自机移动之后、任何发射和子弹移动之前生成一次，自机狙和追踪弹都读它
+    scheduler->AddStage("Targets", PLAYER | ENEMIES, BULLETS, [this](float) {
+        if (bulletManager) {
+            BulletTargets& targets = bulletManager->GetTargets();
+            targets.Clear();
+            for (TestPlayer* machine : {player.get(), coopPlayer.get()}) {
+                if (machine && machine->IsAlive()) {
+                    targets.AddPlayer(machine->GetCenterX(), machine->GetCenterY());
+                }
+            }
+            if (enemyManager) {
+                enemyManager->CollectTargets(targets);
+            }
+        }
+    });
+
+    // 关卡时间轴：派发本 tick 的事件（生成敌人、独立弹幕、背景、Boss 阶段）
+    scheduler->AddStage("Timeline", 0, ENEMIES | BULLETS | ITEMS | GAME_STATE, [this](float) {
+        if (stageTimeline) {
+            stageTimeline->Tick();
+        }
+    });
+
+    // 敌人：读自机位置（自机狙），写敌人并发射子弹
+    scheduler->AddStage("Enemies", PLAYER, ENEMIES | BULLETS | ITEMS, [this](float deltaTime) {
+        if (enemyManager) {
+            if (player) {
+                enemyManager->SetTargetPosition(player->GetCenterX(), player->GetCenterY());
+            }
+            enemyManager->Update(deltaTime);
+        }
+    });
+
+    // 子弹移动：只写子弹池
+    scheduler->AddStage("BulletMovement", 0, BULLETS, [this](float deltaTime) {
+        if (bulletManager) {
+            bulletManager->Update(deltaTime);
+        }
+    });
+
+    // 道具：下落、吸附与拾取，拾取结果结算到自机
+    scheduler->AddStage("Items", 0, ITEMS | PLAYER, [this](float deltaTime) {
+        if (itemManager) {
+            std::array<SelfMachineBase*, 2> collectors{player.get(), coopPlayer.get()};
+            itemManager->Update(deltaTime, collectors);
+        }
+    });
+
+    // 碰撞：需要自机和子弹都更新完毕（自机判定与擦弹共用一次敌弹遍历）
+    // 放炸弹的自机先清除清弹圈内的敌弹，再做判定
+    scheduler->AddStage("Collision", 0, BULLETS | PLAYER | ENEMIES | ITEMS, [this](float) {
+        Uint64 collisionBegin = SDL_GetPerformanceCounter();
+        if (bulletManager) {
+            for (TestPlayer* machine : {player.get(), coopPlayer.get()}) {
+                float radius = machine ? machine->GetBombClearRadius() : 0.0f;
+                if (radius > 0.0f) {
+                    ClearEnemyBulletsToItems(BulletClearRegion::Circle(machine->GetCenterX(),
+                                                                       machine->GetCenterY(), radius));
+                }
+            }
+            bulletManager->BuildPlayerCollisionCache();
+            bulletManager->CheckPlayerCollisions(player.get());
+            if (coopPlayer) {
+                bulletManager->CheckPlayerCollisions(coopPlayer.get());
+            }
+            if (enemyManager) {
+                enemyManager->CheckCollisions(bulletManager.get());
+            }
+        }
+        MetricsRegistry::Instance().Record(collisionMetric,
+            static_cast<double>(SDL_GetPerformanceCounter() - collisionBegin) * 1000.0 /
+            static_cast<double>(SDL_GetPerformanceFrequency()));
+    });
+}
+
+void Game::RecordTickMetrics(double tickMs) {
+    MetricsRegistry& metrics = MetricsRegistry::Instance();
+    metrics.Record(updateMetric, tickMs);
+
+    if (bulletManager) {
+        // 跳转/回滚会让累计数倒退，这种 tick 记为 0
+        size_t created = bulletManager->GetTotalCreatedCount();
+        metrics.Record(spawnsPerTickMetric,
+                       created >= lastBulletsCreated ? static_cast<double>(created - lastBulletsCreated) : 0.0);
+        lastBulletsCreated = created;
+        metrics.SetGauge(activeBulletsGauge, static_cast<double>(bulletManager->GetActiveBulletCount()));
+    }
+    if (enemyManager) {
+        metrics.SetGauge(activeEnemiesGauge, static_cast<double>(enemyManager->GetActiveEnemyCount()));
+    }
 }
 
 void Game::Update() {
-    // 输入处理更新
+    PollInput();
+
+    if (netSession) {
+        UpdateNetSession();
+    } else if (!paused) {
+        tickInputs = {localInput, localCoopInput};
+        SimulateTick();
+    }
+
+    if (!stageTimeline) return;
+
+    if (stageTimeline->IsCheckpointDue()) {
+        std::vector<uint8_t> state;
+        CaptureCheckpoint(state);
+        stageTimeline->StoreCheckpoint(std::move(state));
+    }
+
+    if (pendingSeekTick >= 0) {
+        SeekToTick(static_cast<uint32_t>(pendingSeekTick));
+        pendingSeekTick = -1;
+    }
+}
+
+void Game::PollInput() {
+    // 取出主线程事件泵送来的按键事件（两个 tick 之间的短按也会在这一 tick 生效）
     gameInputHandler->Update();
-    
+    localInput = gameInputHandler->SamplePlayerInput(0);
+    localCoopInput = gameInputHandler->SamplePlayerInput(1);
+
+    // 本机双人：第 2 个手柄接入后 2P 加入（联机时 2P 由会话控制，拔出后 2P 留在场上、输入为 0）
+    if (!netSession && !coopPlayer && gameInputHandler->HasGamepad(1)) {
+        ActivateCoopPlayer();
+        LOG_INFO("Player 2 joined");
+    }
+
     // ESC键退出 - 从main.cpp移植
-    if (gameInputHandler->IsKeyPressed(SDLK_ESCAPE)) {
+    if (gameInputHandler->IsKeyPressed(SDL_SCANCODE_ESCAPE)) {
         gameRunning = false;
     }
-    
-    // 测试射击按键
-    if (gameInputHandler->IsKeyPressed(SDLK_SPACE)) {
-        std::cout << "Shooting...\n";
+
+    // 暂停（联机时双方必须同步推进，不允许单方暂停）
+    if ((gameInputHandler->IsActionJustPressed(InputAction::PAUSE, 0) ||
+         gameInputHandler->IsActionJustPressed(InputAction::PAUSE, 1)) && !netSession) {
+        paused = !paused;
     }
-    
-    // 更新玩家
+
+    // F2 切换屏幕调试信息
+    if (gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F2)) {
+        showDebugOverlay = !showDebugOverlay;
+    }
+
+    // F4 开始/停止把每秒指标写入 metrics.csv
+    if (gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F4)) {
+        MetricsRegistry& metrics = MetricsRegistry::Instance();
+        if (metrics.IsDumping()) {
+            metrics.StopDump();
+        } else {
+            metrics.StartDump("metrics.csv");
+        }
+    }
+
+    // F3 切换调度器调试视图，打开时顺便输出一次调度表
+    if (gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F3)) {
+        showScheduleDebug = !showScheduleDebug;
+        if (showScheduleDebug) {
+            scheduler->LogSchedule();
+        }
+    }
+
+    // F9 回环联机测试，F10 本机 UDP 联机测试（再按一次结束）
+    if (gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F9) || gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F10)) {
+        if (netSession) {
+            StopNetSession();
+        } else {
+            paused = false;
+            StartNetSession(gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F10));
+        }
+    }
+
+    // 以下调试功能会让本机状态脱离联机同步，联机时禁用
+    if (netSession) return;
+
+    // 练习模式跳转：F5 后退 5 秒，F6 前进 5 秒（在本 tick 结束后执行）
+    if (stageTimeline && stageTimeline->IsLoaded()) {
+        const int64_t step = STAGE_TICKS_PER_SECOND * 5;
+        int64_t now = stageTimeline->GetCurrentTick();
+        if (gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F5)) {
+            pendingSeekTick = std::max<int64_t>(0, now - step);
+        } else if (gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F6)) {
+            pendingSeekTick = now + step;
+        }
+    }
+
+    // F7 立即保存一次卡顿捕获（最近 5 秒）
+    if (gameInputHandler->IsKeyJustPressed(SDL_SCANCODE_F7)) {
+        FrameProfiler::Instance().RequestSave();
+    }
+}
+
+void Game::SimulateTick() {
+    scheduler->Run(static_cast<float>(TICK_MS));
+}
+
+void Game::HandleStageEvent(const StageEvent& event, const StageData& data) {
+    const std::string& name = data.GetString(event.nameIndex);
+
+    switch (event.type) {
+        case StageEventType::SPAWN_ENEMY:
+            if (enemyManager) {
+                enemyManager->SpawnEnemy(name, event.x, event.y);
+            }
+            break;
+
+        case StageEventType::START_PATTERN:
+            BulletPattern::FireFan(bulletManager.get(), name, BulletOwner::ENEMY, event.x, event.y,
+                                   event.angle * DEG_TO_RAD, event.spread * DEG_TO_RAD, event.count, event.speed);
+            break;
+
+        case StageEventType::START_AIMED_PATTERN:
+            BulletPattern::FireAimedFan(bulletManager.get(), name, BulletOwner::ENEMY, event.x, event.y,
+                                        event.angle * DEG_TO_RAD, event.spread * DEG_TO_RAD, event.count, event.speed);
+            break;
+
+        case StageEventType::SET_BACKGROUND:
+            backgroundIndex = event.nameIndex;
+            break;
+
+        case StageEventType::BOSS_PHASE:
+            // 转阶段时整屏敌弹换成点数道具
+            ClearEnemyBulletsToItems(BulletClearRegion::Screen());
+            bossPhase = event.count;
+            if (!name.empty() && enemyManager) {
+                enemyManager->SpawnEnemy(name, event.x, event.y);
+            }
+            LOG_INFO("Stage: boss phase {}", bossPhase);
+            break;
+
+        case StageEventType::END_STAGE:
+            LOG_INFO("Stage: clear");
+            break;
+    }
+}
+
+SimulationState Game::GetSimulationState() {
+    SimulationState simulation;
+    simulation.timeline = stageTimeline.get();
+    simulation.players = {player.get(), coopPlayer.get()};
+    simulation.enemies = enemyManager.get();
+    simulation.bullets = bulletManager.get();
+    simulation.items = itemManager.get();
+    simulation.random = &simulationRandom;
+    simulation.backgroundIndex = &backgroundIndex;
+    simulation.bossPhase = &bossPhase;
+    return simulation;
+}
+
+void Game::ClearEnemyBulletsToItems(const BulletClearRegion& region) {
+    if (!bulletManager) return;
+
+    clearedBulletPositions.clear();
+    bulletManager->ClearBullets(region, BulletClearOwner::ENEMY,
+                                itemManager ? &clearedBulletPositions : nullptr);
+    if (itemManager && !clearedBulletPositions.empty()) {
+        itemManager->SpawnItems(ItemType::POINT, clearedBulletPositions.data(), clearedBulletPositions.size());
+    }
+}
+
+void Game::CaptureCheckpoint(std::vector<uint8_t>& state) {
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    double begin = profiler.Now();
+    SimulationSnapshot::Capture(GetSimulationState(), state);
+
+    char label[32];
+    std::snprintf(label, sizeof(label), "%zu bytes", state.size());
+    profiler.Mark(FrameMarker::CHECKPOINT, profiler.Now() - begin, label);
+}
+
+bool Game::RestoreCheckpoint(const std::vector<uint8_t>& state) {
+    // 合作自机是否在场以快照为准：槽位 1 总由预备自机接收，快照中没有则下场
+    SimulationState simulation = GetSimulationState();
+    simulation.players[1] = coopPlayerReserve.get();
+
+    std::array<bool, SIMULATION_MAX_PLAYERS> presentPlayers{};
+    if (!SimulationSnapshot::Restore(simulation, state, &presentPlayers)) {
+        return false;
+    }
+
+    if (presentPlayers[1] && coopPlayerReserve) {
+        coopPlayer = coopPlayerReserve;
+    } else {
+        coopPlayer.reset();
+    }
+    return true;
+}
+
+void Game::SeekToTick(uint32_t tick) {
+    const StageTimeline::Checkpoint* checkpoint = stageTimeline->FindCheckpoint(tick);
+    if (!checkpoint) {
+        LOG_WARN("Seek failed: no checkpoint before tick {}", tick);
+        return;
+    }
+
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    double seekBegin = profiler.Now();
+
+    // 复制一份：快进过程中可能保存新检查点并丢弃旧的
+    std::vector<uint8_t> state = checkpoint->state;
+    if (!RestoreCheckpoint(state)) {
+        LOG_WARN("Seek failed: corrupted checkpoint");
+        return;
+    }
+
+    // 从检查点快进到目标 tick，期间不处理输入和自机
+    scheduler->SetStageEnabled(inputStage, false);
+    scheduler->SetStageEnabled(playerStage, false);
+
+    while (stageTimeline->GetCurrentTick() < tick && !stageTimeline->IsFinished()) {
+        scheduler->Run(static_cast<float>(TICK_MS));
+        if (stageTimeline->IsCheckpointDue()) {
+            std::vector<uint8_t> newState;
+            CaptureCheckpoint(newState);
+            stageTimeline->StoreCheckpoint(std::move(newState));
+        }
+    }
+
+    scheduler->SetStageEnabled(inputStage, true);
+    scheduler->SetStageEnabled(playerStage, true);
+
+    char label[32];
+    std::snprintf(label, sizeof(label), "tick %u", stageTimeline->GetCurrentTick());
+    profiler.Mark(FrameMarker::SEEK, profiler.Now() - seekBegin, label);
+
+    LOG_INFO("Seek to tick {}", stageTimeline->GetCurrentTick());
+}
+
+bool Game::StartNetSession(bool useUdp) {
+    if (netSession) return true;
+
+    // 测试用网络条件：单程 50ms ± 10ms，5% 丢包
+    NetConditions conditions;
+    conditions.latencyMs = 50.0f;
+    conditions.jitterMs = 10.0f;
+    conditions.lossRate = 0.05f;
+
+    if (useUdp) {
+        auto local = std::make_unique<UdpTransport>();
+        auto peer = std::make_unique<UdpTransport>();
+        if (!local->Open(7001, "127.0.0.1", 7002) || !peer->Open(7002, "127.0.0.1", 7001)) {
+            LOG_WARN("Net session: failed to open UDP ports");
+            return false;
+        }
+        netTransport = std::move(local);
+        peerTransport = std::move(peer);
+    } else {
+        auto pair = LoopbackTransport::CreatePair();
+        netTransport = std::move(pair.first);
+        peerTransport = std::move(pair.second);
+    }
+    netTransport->SetConditions(conditions);
+    peerTransport->SetConditions(conditions);
+
+    // 2P 加入模拟（参与碰撞和快照），从初始状态开始
+    ActivateCoopPlayer();
+
+    RollbackConfig config;
+    config.localPlayer = 0;
+    netSession = std::make_unique<RollbackSession>(netTransport.get(), config);
+    netSession->SetCallbacks(
+        [this](std::vector<uint8_t>& state) { CaptureCheckpoint(state); },
+        [this](const std::vector<uint8_t>& state) { return RestoreCheckpoint(state); },
+        [this](const RollbackSession::Inputs& inputs) {
+            tickInputs = inputs;
+            SimulateTick();
+        });
+
+    // 对端只产生输入，不运行模拟
+    RollbackConfig peerConfig = config;
+    peerConfig.localPlayer = 1;
+    peerSession = std::make_unique<RollbackSession>(peerTransport.get(), peerConfig);
+
+    netFrameCounter = 0;
+    LOG_INFO("Net session started ({}, {}ms, {}% loss)", useUdp ? "UDP localhost" : "loopback",
+             conditions.latencyMs, conditions.lossRate * 100.0f);
+    return true;
+}
+
+void Game::ActivateCoopPlayer() {
+    coopPlayer = coopPlayerReserve;
+    StateReader coopReader(coopPlayerInitialState);
+    coopPlayer->LoadState(coopReader);
+}
+
+void Game::StopNetSession() {
+    if (!netSession) return;
+
+    netSession->LogStats();
+
+    netSession.reset();
+    peerSession.reset();
+    netTransport.reset();
+    peerTransport.reset();
+
+    coopPlayer.reset();
+    tickInputs = {};
+    LOG_INFO("Net session stopped");
+}
+
+void Game::UpdateNetSession() {
+    if (peerSession) {
+        peerSession->AdvanceFrame(GetScriptedPeerInput(peerSession->GetCurrentTick()));
+    }
+    netSession->AdvanceFrame(localInput);
+
+    // 每 5 秒报告一次回滚开销
+    if (++netFrameCounter % (STAGE_TICKS_PER_SECOND * 5) == 0) {
+        netSession->LogStats();
+    }
+}
+
+PlayerInputBits Game::GetScriptedPeerInput(int64_t tick) {
+    // 左右往返、不定期集中，保证对端输入经常变化以触发回滚
+    PlayerInputBits bits = PlayerInput::SHOOT;
+    bits |= ((tick / 45) % 2 == 0) ? PlayerInput::LEFT : PlayerInput::RIGHT;
+    if ((tick / 100) % 3 == 0) {
+        bits |= PlayerInput::FOCUS;
+    }
+    return bits;
+}
+
+void Game::BuildRenderQueue() {
+    // 各系统只提交命令，层序由排序键决定，与提交顺序无关
+    RenderQueue& queue = renderExchange->BeginWrite();
+
+    // 关卡背景
+    SubmitBackground(queue);
+
+    // 玩家
     if (player) {
-        player->Update(static_cast<float>(deltaTime));
+        player->Submit(queue, 0);
+    }
+    if (coopPlayer) {
+        coopPlayer->Submit(queue, 1);
+    }
+
+    if (enemyManager) {
+        enemyManager->Submit(queue);
+    }
+    if (itemManager) {
+        itemManager->Submit(queue);
+    }
+    if (bulletManager) {
+        bulletManager->Submit(queue);
+    }
+
+    SubmitHud(queue);
+
+    if (paused && textFont && textFont->IsLoaded()) {
+        textFont->SubmitText(queue, RenderLayer::OVERLAY, 1, windowWidth * 0.5f - 28.0f, windowHeight * 0.5f,
+                             "PAUSED", SDL_Color{255, 230, 120, 255});
+    }
+
+    // 渲染线程上一帧的统计（调试视图落后一帧）
+    scheduler->SetCounter(drawCallCounter, lastDrawCalls.load(std::memory_order_relaxed));
+    scheduler->SetCounter(textureSwitchCounter, lastTextureSwitches.load(std::memory_order_relaxed));
+    scheduler->SetCounter(blendSwitchCounter, lastBlendSwitches.load(std::memory_order_relaxed));
+    scheduler->SetCounter(presentCounter, lastPresentMicros.load(std::memory_order_relaxed) / 1000.0);
+    scheduler->SetCounter(layerRedrawCounter, lastLayerRedraws.load(std::memory_order_relaxed));
+
+    // 调度器甘特图
+    if (showScheduleDebug) {
+        scheduler->SubmitDebug(queue, 10.0f, 10.0f, 300.0f);
+    }
+
+    // 屏幕调试信息（左下角）
+    if (showDebugOverlay && textFont && textFont->IsLoaded()) {
+        DebugOverlay::Stats stats;
+        stats.fps = lastFpsTenths.load(std::memory_order_relaxed) / 10.0;
+        if (bulletManager) {
+            stats.activeBullets = bulletManager->GetActiveBulletCount();
+            stats.peakBullets = bulletManager->GetPeakActiveCount();
+            stats.bulletPoolSize = bulletManager->GetPoolSize();
+            stats.freeBullets = bulletManager->GetAvailableBulletCount();
+        }
+        if (enemyManager) {
+            stats.activeEnemies = enemyManager->GetActiveEnemyCount();
+        }
+        stats.drawCalls = lastDrawCalls.load(std::memory_order_relaxed);
+        stats.textureSwitches = lastTextureSwitches.load(std::memory_order_relaxed);
+        stats.blendSwitches = lastBlendSwitches.load(std::memory_order_relaxed);
+        stats.queueCommands = static_cast<size_t>(lastQueueCommands.load(std::memory_order_relaxed));
+
+        const MetricsRegistry& metrics = MetricsRegistry::Instance();
+        stats.frameP95Ms = metrics.GetHistogram(frameMetric).p95;
+        stats.updateP95Ms = metrics.GetHistogram(updateMetric).p95;
+        stats.collisionP95Ms = metrics.GetHistogram(collisionMetric).p95;
+        stats.renderP95Ms = metrics.GetHistogram(renderMetric).p95;
+        stats.inputLatencyP95Ms = metrics.GetHistogram(gameInputHandler->GetLatencyMetric()).p95;
+        stats.spawnsPerSecond = bulletManager ? metrics.GetCounterRate(bulletManager->GetSpawnMetric()) : 0;
+        stats.poolGrowths = bulletManager ? metrics.GetCounterTotal(bulletManager->GetPoolGrowthMetric()) : 0;
+
+        const float panelHeight = static_cast<float>(textFont->GetLineHeight()) * DebugOverlay::LINE_COUNT + 8.0f;
+        debugOverlay.Submit(queue, *textFont, stats, 10.0f, static_cast<float>(windowHeight) - panelHeight - 10.0f);
+    }
+
+    renderExchange->Publish();
+}
+
+void Game::SubmitBackground(RenderQueue& queue) {
+    if (!stageTimeline || backgroundIndex < 0) return;
+
+    const std::string& texturePath = stageTimeline->GetStageData().GetString(backgroundIndex);
+    if (texturePath.empty()) return;
+
+    // 背景贴图在 Initialize 中预先加载（这里在模拟线程，不能创建贴图）
+    auto it = backgroundCache.find(texturePath);
+    if (it != backgroundCache.end() && it->second) {
+        // 背景只随关卡事件切换，以背景编号作为缓存版本
+        queue.SetLayerCache(RenderLayer::BACKGROUND, static_cast<uint64_t>(backgroundIndex) + 1);
+        queue.SubmitQuad(RenderLayer::BACKGROUND, 0, it->second.get(), nullptr,
+                         windowWidth * 0.5f, windowHeight * 0.5f,
+                         static_cast<float>(windowWidth), static_cast<float>(windowHeight),
+                         0.0f, SDL_Color{255, 255, 255, 255}, BlendMode::ALPHA);
+    }
+}
+
+void Game::SubmitHud(RenderQueue& queue) {
+    if (!player || !textFont || !textFont->IsLoaded()) return;
+
+    // 脏标记：任一显示值变化就换一个版本，渲染线程据此重画 HUD 目标，否则只拷贝一次
+    HudState state;
+    state.score = player->GetScore();
+    state.lives = player->GetLives();
+    state.bombs = player->GetBombCount();
+    state.powerHundredths = static_cast<int>(std::lround(player->GetPower() * 100.0f));
+    if (state != hudState) {
+        hudState = state;
+        hudVersion++;
     }
+    queue.SetLayerCache(RenderLayer::HUD, hudVersion);
+
+    const float lineHeight = static_cast<float>(textFont->GetLineHeight());
+    const float left = static_cast<float>(windowWidth) - 190.0f;
+    const float valueX = left + 70.0f;
+    const SDL_Color labelColor = {255, 255, 255, 255};
+    const SDL_Color valueColor = {255, 230, 120, 255};
+
+    // 半透明底板（白色背景上也能看清文字）
+    queue.SubmitQuad(RenderLayer::HUD, 0, nullptr, nullptr, left + 85.0f, 10.0f + lineHeight * 2.0f + 2.0f,
+                     180.0f, lineHeight * 4.0f + 12.0f, 0.0f, SDL_Color{0, 0, 0, 160}, BlendMode::ALPHA);
+
+    char buffer[32];
+    float y = 14.0f;
+    textFont->SubmitText(queue, RenderLayer::HUD, 1, left, y, "SCORE", labelColor);
+    std::snprintf(buffer, sizeof(buffer), "%09lld", static_cast<long long>(state.score));
+    textFont->SubmitText(queue, RenderLayer::HUD, 1, valueX, y, buffer, valueColor);
+
+    // 残机和炸弹画成图标，最多 8 个
+    y += lineHeight;
+    textFont->SubmitText(queue, RenderLayer::HUD, 1, left, y, "LIVES", labelColor);
+    for (int i = 0; i < std::min(state.lives, 8); ++i) {
+        queue.SubmitQuad(RenderLayer::HUD, 1, nullptr, nullptr, valueX + 6.0f + i * 13.0f, y + lineHeight * 0.5f,
+                         10.0f, 10.0f, 45.0f, SDL_Color{255, 90, 160, 255}, BlendMode::ALPHA);
+    }
+
+    y += lineHeight;
+    textFont->SubmitText(queue, RenderLayer::HUD, 1, left, y, "BOMBS", labelColor);
+    for (int i = 0; i < std::min(state.bombs, 8); ++i) {
+        queue.SubmitQuad(RenderLayer::HUD, 1, nullptr, nullptr, valueX + 6.0f + i * 13.0f, y + lineHeight * 0.5f,
+                         10.0f, 10.0f, 0.0f, SDL_Color{90, 220, 120, 255}, BlendMode::ALPHA);
+    }
+
+    y += lineHeight;
+    textFont->SubmitText(queue, RenderLayer::HUD, 1, left, y, "POWER", labelColor);
+    std::snprintf(buffer, sizeof(buffer), "%d.%02d", state.powerHundredths / 100, state.powerHundredths % 100);
+    textFont->SubmitText(queue, RenderLayer::HUD, 1, valueX, y, buffer, valueColor);
 }
 
 void Game::Render() {
     // 设置白色背景并清除屏幕 - 从main.cpp移植
     gameRenderer->SetDrawColor(255, 255, 255, 255);
     gameRenderer->Clear();
-    
-    // 渲染玩家
-    if (player) {
-        player->Render(gameRenderer.get());
+
+    // 最新发布的一帧；模拟还没发布新帧时重画上一帧
+    const RenderQueue* queue = renderExchange->AcquireLatest();
+    if (queue) {
+        Uint64 drawBegin = SDL_GetPerformanceCounter();
+        const RenderQueue::FrameStats renderStats = queue->Draw(gameRenderer.get(), spriteBatch,
+                                                                renderTargetCache.get());
+        double drawMs = static_cast<double>(SDL_GetPerformanceCounter() - drawBegin) * 1000.0 /
+                        static_cast<double>(SDL_GetPerformanceFrequency());
+        MetricsRegistry::Instance().Record(renderMetric, drawMs);
+        FrameProfiler::Instance().AddPhase(FrameTrack::RENDER, FramePhase::DRAW, drawMs);
+        lastDrawCalls.store(renderStats.drawCalls, std::memory_order_relaxed);
+        lastTextureSwitches.store(renderStats.textureSwitches, std::memory_order_relaxed);
+        lastBlendSwitches.store(renderStats.blendSwitches, std::memory_order_relaxed);
+        lastLayerRedraws.store(renderStats.layerRedraws, std::memory_order_relaxed);
+        lastQueueCommands.store(static_cast<int>(renderStats.commands), std::memory_order_relaxed);
     }
-    
+
     // 呈现画面
+    Uint64 presentBegin = SDL_GetPerformanceCounter();
     gameRenderer->Present();
+    Uint64 presentTicks = SDL_GetPerformanceCounter() - presentBegin;
+    FrameProfiler::Instance().AddPhase(FrameTrack::RENDER, FramePhase::PRESENT,
+        static_cast<double>(presentTicks) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()));
+    lastPresentMicros.store(static_cast<int>(presentTicks * 1000000 / SDL_GetPerformanceFrequency()),
+                            std::memory_order_relaxed);
+
+    // 帧间隔与帧率：帧率每满半秒按实际呈现次数更新一次
+    fpsFrames++;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastPresentTime != 0) {
+        MetricsRegistry::Instance().Record(frameMetric, static_cast<double>(now - lastPresentTime) * 1000.0 /
+                                                        static_cast<double>(SDL_GetPerformanceFrequency()));
+    }
+    lastPresentTime = now;
+    if (fpsWindowStart == 0) {
+        fpsWindowStart = now;
+        fpsFrames = 0;
+    } else if (now - fpsWindowStart >= SDL_GetPerformanceFrequency() / 2) {
+        double seconds = static_cast<double>(now - fpsWindowStart) / static_cast<double>(SDL_GetPerformanceFrequency());
+        lastFpsTenths.store(static_cast<int>(fpsFrames * 10.0 / seconds + 0.5), std::memory_order_relaxed);
+        fpsWindowStart = now;
+        fpsFrames = 0;
+    }
 }
 
 void Game::HandleEvents() {
@@ -119,20 +958,37 @@ void Game::HandleEvents() {
         if (event.type == SDL_EVENT_QUIT) {
             gameRunning = false;
         }
+        // 按键事件连同时间戳交给模拟线程，下一个 tick 开始时消费（按住重复不算新的按下）
+        if ((event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) && !event.key.repeat) {
+            gameInputHandler->PushKeyEvent(event.key.scancode, event.key.down, event.key.timestamp);
+        }
+        // 手柄接入/拔出在主线程打开/关闭设备，按键和摇杆与键盘走同一条队列
+        gameInputHandler->HandleGamepadEvent(event);
+        // 渲染设备重置后目标贴图的内容丢失，缓存的层全部重画
+        if (event.type == SDL_EVENT_RENDER_TARGETS_RESET || event.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+            if (renderTargetCache) {
+                renderTargetCache->Invalidate();
+            }
+        }
     }
 }
 
 void Game::FrameRateControl() {
-    // 从main.cpp移植的帧率控制逻辑
+    // 从main.cpp移植的帧率控制逻辑；从本次主循环开始计时，只睡剩余的部分
     const int FPS = 60;
-    const int frameLength = 1000 / FPS;
-    
-    Uint32 frameStart = SDL_GetTicks();
-    Uint32 frameTime = SDL_GetTicks() - frameStart;
-    
-    if (frameTime < frameLength) {
-        SDL_Delay(frameLength - frameTime);
-    }
+    const double frameLength = 1000.0 / FPS;
+
+    double frameTime = static_cast<double>(SDL_GetPerformanceCounter() - renderFrameStart) * 1000.0 /
+                       static_cast<double>(SDL_GetPerformanceFrequency());
+    if (frameTime + 1.0 > frameLength) return;
+
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    Uint32 requestedMs = static_cast<Uint32>(frameLength - frameTime);
+    double sleepBegin = profiler.Now();
+    SDL_Delay(requestedMs);
+    double sleptMs = profiler.Now() - sleepBegin;
+    profiler.AddPhase(FrameTrack::RENDER, FramePhase::FRAME_DELAY, std::min<double>(sleptMs, requestedMs));
+    profiler.AddPhase(FrameTrack::RENDER, FramePhase::OVERSLEEP, std::max(0.0, sleptMs - requestedMs));
 }
 
 
@@ -13,15 +13,37 @@
 #include <SDL3_image/SDL_image.h>
 #include <windows.h>
 #include <cstdio>
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "../graphics/Renderer.h"
+#include "../graphics/RenderExchange.h"
+#include "../graphics/RenderTargetCache.h"
+#include "../graphics/GlyphCache.h"
 #include "../input/InputHandler.h"
+#include "../input/PlayerInput.h"
 #include "../graphics/Sprite.h"
+#include "Random.h"
+#include "SystemScheduler.h"
+#include "DebugOverlay.h"
+#include "../stage/StageTimeline.h"
+#include "../snapshot/SimulationSnapshot.h"
 
 
 class TestPlayer;
+class BulletManager;
+class EnemyManager;
+class ItemManager;
+struct BulletClearRegion;
+class EntityBase;
+class NetTransport;
+class RollbackSession;
 
 class Game {
 
@@ -41,18 +63,116 @@ private:
     std::unique_ptr<Renderer> gameRenderer;
     std::unique_ptr<InputHandler> gameInputHandler;
     std::unique_ptr<Sprite> gameSprite;
-    std::unique_ptr<TestPlayer> player;
+    std::shared_ptr<TestPlayer> player;
+    std::shared_ptr<TestPlayer> coopPlayer;      // 2P（联机时存在）
+    std::shared_ptr<TestPlayer> coopPlayerReserve;  // 2P 实例：贴图在主线程预先加载，联机开始时复用
+    std::vector<uint8_t> coopPlayerInitialState;    // 2P 的初始状态（每次联机开始时恢复）
+    std::unique_ptr<BulletManager> bulletManager;
+    std::unique_ptr<EnemyManager> enemyManager;
+    std::unique_ptr<ItemManager> itemManager;
+    std::unique_ptr<SystemScheduler> scheduler;
+    std::unique_ptr<StageTimeline> stageTimeline;
+    // 模拟线程与渲染（主）线程之间的双缓冲渲染队列；合批器只在渲染线程使用
+    std::unique_ptr<RenderExchange> renderExchange;
+    SpriteBatch spriteBatch;
+
+    // 背景和 HUD 画进渲染目标，内容版本不变时每帧只拷贝一次（渲染线程使用）
+    std::unique_ptr<RenderTargetCache> renderTargetCache;
+
+    // HUD 与调试信息：字形缓存在主线程初始化后只读；HUD 状态和版本由模拟线程维护
+    struct HudState {
+        int64_t score = -1;
+        int lives = -1;
+        int bombs = -1;
+        int powerHundredths = -1;
+
+        bool operator==(const HudState& other) const = default;
+    };
+    std::unique_ptr<GlyphCache> textFont;
+    HudState hudState;
+    uint64_t hudVersion = 0;
+
+    // 屏幕调试信息（F2）：tick 耗时由模拟线程记录
+    DebugOverlay debugOverlay;
+    bool showDebugOverlay = false;
+
+    // 模拟线程：固定步长推进并在每批 tick 之后发布渲染队列
+    std::thread simulationThread;
+
+    // 渲染统计：渲染线程写，模拟线程读出后显示在调度器调试视图中
+    std::atomic<int> lastDrawCalls{0};
+    std::atomic<int> lastTextureSwitches{0};
+    std::atomic<int> lastBlendSwitches{0};
+    std::atomic<int> lastPresentMicros{0};
+    std::atomic<int> lastLayerRedraws{0};
+    std::atomic<int> lastQueueCommands{0};
+    std::atomic<int> lastFpsTenths{0};     // 帧率 x10
+    int drawCallCounter = -1;
+    int textureSwitchCounter = -1;
+    int blendSwitchCounter = -1;
+    int presentCounter = -1;
+    int layerRedrawCounter = -1;
+
+    // MetricsRegistry 编号：帧间隔/渲染（渲染线程）、tick/碰撞/每 tick 生成数与活跃数（模拟线程）
+    int frameMetric = -1;
+    int updateMetric = -1;
+    int collisionMetric = -1;
+    int renderMetric = -1;
+    int spawnsPerTickMetric = -1;
+    int activeBulletsGauge = -1;
+    int activeEnemiesGauge = -1;
+    size_t lastBulletsCreated = 0;
+
+    // 清弹转道具的位置缓冲（按子弹池上限预留，清弹时不分配）
+    std::vector<SDL_FPoint> clearedBulletPositions;
+
+    // 模拟用随机数：所有影响模拟结果的随机都从这里取，随快照保存
+    Random simulationRandom;
+
+    // 输入：本帧采样的本地输入与本 tick 实际生效的双方输入
+    PlayerInputBits localInput = 0;
+    PlayerInputBits localCoopInput = 0;    // 本机 2P（第 2 个手柄）
+    std::array<PlayerInputBits, 2> tickInputs{};
+    bool paused = false;                   // 本机暂停（PAUSE 动作切换，联机时无效）
+
+    // 回滚联机（peer 为回环另一端的脚本对手，只发送输入、不运行模拟）
+    std::unique_ptr<NetTransport> netTransport;
+    std::unique_ptr<NetTransport> peerTransport;
+    std::unique_ptr<RollbackSession> netSession;
+    std::unique_ptr<RollbackSession> peerSession;
+    uint64_t netFrameCounter = 0;
 
     
-    //游戏状态
-    bool gameRunning;
+    //游戏状态（两个线程都会读写）
+    std::atomic<bool> gameRunning;
+    bool showScheduleDebug = false;
 
 
-    //时间管理
+    //时间管理（模拟线程）
     Uint64 lastFrameTime;
     Uint64 currentFrameTime;
     double deltaTime;
 
+    // 帧率统计窗口（渲染线程）
+    Uint64 fpsWindowStart = 0;
+    int fpsFrames = 0;
+    Uint64 lastPresentTime = 0;
+    Uint64 renderFrameStart = 0;           // 本次主循环开始的时刻（帧率控制从这里算起）
+
+    // 固定步长模拟：每 tick 的毫秒数与累积时间
+    static constexpr double TICK_MS = 1000.0 / STAGE_TICKS_PER_SECOND;
+    double tickAccumulator = 0.0;
+
+    // 关卡状态
+    int32_t backgroundIndex = -1;          // 当前背景（关卡字符串表索引）
+    int bossPhase = 0;
+    int64_t pendingSeekTick = -1;          // 练习模式跳转请求（-1 表示无）
+    std::map<std::string, std::unique_ptr<Sprite>> backgroundCache;
+
+    // 调度器阶段编号（跳转快进时需要暂停输入和自机）
+    int inputStage = -1;
+    int playerStage = -1;
+
     //窗口
     const int windowWidth = 800;
     const int windowHeight = 600;
@@ -65,10 +185,37 @@ private:
     // 初始化和清理
     bool Initialize();
     void Cleanup();
+
+    // 注册更新阶段到调度器
+    void RegisterSystemStages();
     
+    // 关卡事件与检查点
+    void HandleStageEvent(const StageEvent& event, const StageData& data);
+    SimulationState GetSimulationState();
+
+    // 区域清除敌弹并把每颗子弹换成点数道具
+    void ClearEnemyBulletsToItems(const BulletClearRegion& region);
+    void CaptureCheckpoint(std::vector<uint8_t>& state);
+    bool RestoreCheckpoint(const std::vector<uint8_t>& state);
+    void SeekToTick(uint32_t tick);
+
+    // 回滚联机测试：本机 1P，对端 2P 由脚本输入驱动
+    bool StartNetSession(bool useUdp);
+    void StopNetSession();
+    void ActivateCoopPlayer();             // 2P 以初始状态加入模拟（联机开始或本机第 2 个手柄接入）
+    void UpdateNetSession();
+    static PlayerInputBits GetScriptedPeerInput(int64_t tick);
+
     // 游戏循环核心方法
-    void Update();
-    void Render();
+    void SimulationLoop();  // 模拟线程主循环
+    void Update();      // 推进一个固定 tick
+    void RecordTickMetrics(double tickMs);   // tick 耗时、本 tick 生成的子弹数和活跃数写入指标
+    void PollInput();   // 模拟线程：刷新键盘、处理热键、采样本地输入
+    void SimulateTick();  // 以 tickInputs 运行一次调度器
+    void BuildRenderQueue();   // 模拟线程：把当前状态写入渲染队列并发布
+    void SubmitBackground(RenderQueue& queue);   // 提交背景到渲染队列（可缓存层）
+    void SubmitHud(RenderQueue& queue);          // 提交分数/残机/炸弹/火力（可缓存层）
+    void Render();      // 主线程：绘制最新发布的渲染队列并呈现
     void HandleEvents();
     
     // 帧率控制
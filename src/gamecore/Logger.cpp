@@ -0,0 +1,249 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "Logger.h"
+
+#include <cinttypes>
+#include <cstring>
+
+namespace {
+    constexpr const char* LEVEL_NAMES[] = {"TRACE", "DEBUG", "INFO ", "WARN ", "ERROR"};
+    constexpr int64_t RATE_WINDOW_NS = 1000000000;
+    constexpr auto IDLE_WAIT = std::chrono::milliseconds(2);
+
+    // __FILE__ 可能是完整路径，只输出文件名
+    const char* BaseName(const char* path) {
+        const char* base = path;
+        for (const char* c = path; *c; ++c) {
+            if (*c == '/' || *c == '\\') {
+                base = c + 1;
+            }
+        }
+        return base;
+    }
+}
+
+Logger& Logger::Instance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger()
+    : cells(std::make_unique<Cell[]>(CAPACITY)),
+      enqueuePos(0),
+      dequeuePos(0),
+      running(false),
+      minLevel(LogLevel::TRACE),
+      rateLimit(20),
+      writtenCount(0),
+      droppedCount(0),
+      suppressedCount(0),
+      startTime(std::chrono::steady_clock::now()),
+      logFile(nullptr) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    lineBuffer.reserve(512);
+}
+
+Logger::~Logger() {
+    Stop();
+}
+
+bool Logger::Start(const char* filePath) {
+    if (running.load(std::memory_order_acquire)) return true;
+
+    if (filePath && *filePath) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        logFile = std::fopen(filePath, "a");
+        if (!logFile) {
+            std::fprintf(stderr, "Logger: failed to open %s\n", filePath);
+        }
+    }
+
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&Logger::WriterLoop, this);
+    return true;
+}
+
+void Logger::Stop() {
+    if (!running.exchange(false, std::memory_order_acq_rel)) return;
+
+    if (writer.joinable()) {
+        writer.join();
+    }
+    // 停止前刚领取槽位的生产者可能晚于写线程退出才发布
+    Drain();
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    if (logFile) {
+        std::fclose(logFile);
+        logFile = nullptr;
+    }
+}
+
+int64_t Logger::Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+bool Logger::PassRateLimit(LogSite& site, uint32_t& suppressedBefore) {
+    const int64_t now = Now();
+    int64_t windowStart = site.windowStart.load(std::memory_order_relaxed);
+    // 新的一秒：抢到窗口切换的线程清零计数并带走上一窗口省略的条数
+    if ((now - windowStart >= RATE_WINDOW_NS || site.windowCount.load(std::memory_order_relaxed) == 0) &&
+        site.windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+        site.windowCount.store(0, std::memory_order_relaxed);
+        suppressedBefore = site.suppressed.exchange(0, std::memory_order_relaxed);
+    }
+
+    if (site.windowCount.fetch_add(1, std::memory_order_relaxed) < rateLimit.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    suppressedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+Logger::Cell* Logger::AcquireCell() {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[pos & (CAPACITY - 1)];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &cell;
+            }
+        } else if (diff < 0) {
+            // 写线程还没读走一圈之前的记录：缓冲已满
+            return nullptr;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::PublishCell(Cell* cell) {
+    // 槽位在 cells 中的位置对应 sequence，发布后 sequence = 领取时的位置 + 1
+    cell->sequence.store(cell->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void Logger::StoreText(Record& record, Arg& arg, std::string_view text) {
+    const size_t available = TEXT_SIZE - record.textUsed;
+    const size_t length = text.size() < available ? text.size() : available;
+    std::memcpy(record.text + record.textUsed, text.data(), length);
+
+    arg.type = ArgType::TEXT;
+    arg.textOffset = record.textUsed;
+    arg.textLength = static_cast<uint16_t>(length);
+    record.textUsed = static_cast<uint16_t>(record.textUsed + length);
+}
+
+void Logger::FormatRecord(const Record& record, std::string& out) {
+    char number[64];
+    std::snprintf(number, sizeof(number), "[%10.3f] ", static_cast<double>(record.time) / 1000000.0);
+    out.assign(number);
+    out.append(LEVEL_NAMES[static_cast<size_t>(record.level)]);
+    out.push_back(' ');
+
+    // "{}" 依次替换为参数，多余的参数附在末尾
+    int nextArg = 0;
+    auto appendArg = [&](const Arg& arg) {
+        switch (arg.type) {
+            case ArgType::I64:
+                std::snprintf(number, sizeof(number), "%" PRId64, arg.value.i);
+                out.append(number);
+                break;
+            case ArgType::U64:
+                std::snprintf(number, sizeof(number), "%" PRIu64, arg.value.u);
+                out.append(number);
+                break;
+            case ArgType::F64:
+                std::snprintf(number, sizeof(number), "%.3f", arg.value.d);
+                out.append(number);
+                break;
+            case ArgType::BOOL:
+                out.append(arg.value.u ? "true" : "false");
+                break;
+            case ArgType::CHAR:
+                out.push_back(static_cast<char>(arg.value.i));
+                break;
+            case ArgType::TEXT:
+                out.append(record.text + arg.textOffset, arg.textLength);
+                break;
+            case ArgType::POINTER:
+                std::snprintf(number, sizeof(number), "%p", arg.value.p);
+                out.append(number);
+                break;
+        }
+    };
+
+    for (const char* c = record.format; c && *c; ++c) {
+        if (c[0] == '{' && c[1] == '}' && nextArg < record.argCount) {
+            appendArg(record.args[nextArg++]);
+            ++c;
+        } else {
+            out.push_back(*c);
+        }
+    }
+    for (; nextArg < record.argCount; ++nextArg) {
+        out.push_back(' ');
+        appendArg(record.args[nextArg]);
+    }
+
+    if (record.suppressed > 0) {
+        std::snprintf(number, sizeof(number), " (+%u suppressed)", record.suppressed);
+        out.append(number);
+    }
+    if (record.level >= LogLevel::WARN && record.file) {
+        std::snprintf(number, sizeof(number), " (%.40s:%d)", BaseName(record.file), record.line);
+        out.append(number);
+    }
+    out.push_back('\n');
+}
+
+void Logger::WriteLine(LogLevel level, const std::string& line) {
+    std::fwrite(line.data(), 1, line.size(), level >= LogLevel::WARN ? stderr : stdout);
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (logFile) {
+            std::fwrite(line.data(), 1, line.size(), logFile);
+        }
+    }
+    writtenCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Logger::Drain() {
+    bool any = false;
+    while (true) {
+        Cell& cell = cells[dequeuePos & (CAPACITY - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) break;
+
+        FormatRecord(cell.record, lineBuffer);
+        const LogLevel level = cell.record.level;
+        // 槽位格式化完就可以还给生产者，写出不占用缓冲
+        cell.sequence.store(dequeuePos + CAPACITY, std::memory_order_release);
+        dequeuePos++;
+        WriteLine(level, lineBuffer);
+        any = true;
+    }
+
+    if (any) {
+        std::fflush(stdout);
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (logFile) {
+            std::fflush(logFile);
+        }
+    }
+    return any;
+}
+
+void Logger::WriterLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        if (!Drain()) {
+            std::this_thread::sleep_for(IDLE_WAIT);
+        }
+    }
+    Drain();
+}
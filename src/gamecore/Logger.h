@@ -0,0 +1,268 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// 日志级别（windows.h 定义了 ERROR 宏，错误级别命名为 ERR）
+enum class LogLevel : uint8_t {
+    TRACE,
+    DEBUG,
+    INFO,
+    WARN,
+    ERR,
+    COUNT
+};
+
+// 编译期过滤：低于该级别的 LOG_* 宏展开为空语句，参数不求值（0 TRACE ... 4 ERR）
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 2
+#else
+#define LOG_MIN_LEVEL 1
+#endif
+#endif
+
+// 每个调用点的限流状态（由 LOG_* 宏定义为静态变量）
+struct LogSite {
+    std::atomic<int64_t> windowStart{0};
+    std::atomic<uint32_t> windowCount{0};
+    std::atomic<uint32_t> suppressed{0};
+};
+
+/**
+ * Logger - 异步日志
+ * 职责：
+ * 1. 调用线程只把格式串指针和参数值写进无锁环形缓冲（多生产者），不格式化、不加锁、不做系统调用
+ * 2. 后台线程取出记录，按 "{}" 占位符格式化后批量写到 stdout（WARN 及以上写 stderr）
+ * 3. 每个调用点每秒最多输出 rateLimit 条，多出的只计数，下一条输出时附带被省略的条数
+ * 4. 缓冲满时丢弃新记录并计数，从不阻塞调用线程
+ *
+ * 格式串必须是字符串常量（只保存指针）；字符串参数会被拷贝，每条记录最多 TEXT_SIZE 字节。
+ * Start 之前和 Stop 之后日志在调用线程上同步输出，初始化和退出阶段的日志不会丢失
+ */
+class Logger {
+public:
+    static Logger& Instance();
+
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // 启动后台写线程；filePath 不为空时同时追加写入该文件
+    bool Start(const char* filePath = nullptr);
+
+    // 写完缓冲中的记录后停止后台线程
+    void Stop();
+
+    // 运行期级别（编译期过滤之后的第二道过滤）
+    void SetLevel(LogLevel level) { minLevel.store(level, std::memory_order_relaxed); }
+    LogLevel GetLevel() const { return minLevel.load(std::memory_order_relaxed); }
+
+    // 每个调用点每秒的最大条数
+    void SetRateLimit(uint32_t perSecond) { rateLimit.store(perSecond, std::memory_order_relaxed); }
+
+    template <typename... Args>
+    void Log(LogSite& site, LogLevel level, const char* file, int line, const char* format, const Args&... args);
+
+    uint64_t GetWrittenCount() const { return writtenCount.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+    uint64_t GetSuppressedCount() const { return suppressedCount.load(std::memory_order_relaxed); }
+
+    static constexpr size_t CAPACITY = 4096;       // 2 的幂
+    static constexpr int MAX_ARGS = 8;
+    static constexpr size_t TEXT_SIZE = 128;
+
+private:
+    enum class ArgType : uint8_t { I64, U64, F64, BOOL, CHAR, TEXT, POINTER };
+
+    struct Arg {
+        ArgType type;
+        uint16_t textOffset;    // TEXT：在 Record::text 中的区间
+        uint16_t textLength;
+        union {
+            int64_t i;
+            uint64_t u;
+            double d;
+            const void* p;
+        } value;
+    };
+
+    struct Record {
+        int64_t time;           // 相对于 Logger 创建的纳秒
+        const char* format;
+        const char* file;
+        int line;
+        LogLevel level;
+        uint8_t argCount;
+        uint16_t textUsed;
+        uint32_t suppressed;    // 此前被限流省略的条数
+        Arg args[MAX_ARGS];
+        char text[TEXT_SIZE];
+    };
+
+    // 有界多生产者队列的槽位：sequence 表示该槽位可写（== 位置）或可读（== 位置 + 1）
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    Logger();
+
+    int64_t Now() const;
+    bool PassRateLimit(LogSite& site, uint32_t& suppressedBefore);
+
+    // 领取一个可写槽位，缓冲满时返回 nullptr
+    Cell* AcquireCell();
+    void PublishCell(Cell* cell);
+
+    template <typename T>
+    static void StoreArg(Record& record, const T& value);
+    static void StoreText(Record& record, Arg& arg, std::string_view text);
+
+    static void FormatRecord(const Record& record, std::string& out);
+    void WriteLine(LogLevel level, const std::string& line);
+
+    void WriterLoop();
+    bool Drain();
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) size_t dequeuePos;
+
+    std::atomic<bool> running;
+    std::atomic<LogLevel> minLevel;
+    std::atomic<uint32_t> rateLimit;
+    std::atomic<uint64_t> writtenCount;
+    std::atomic<uint64_t> droppedCount;
+    std::atomic<uint64_t> suppressedCount;
+
+    std::chrono::steady_clock::time_point startTime;
+    std::thread writer;
+    std::string lineBuffer;     // 后台线程的格式化缓冲（复用）
+    std::mutex outputMutex;     // 同步输出与后台线程互斥写文件
+    FILE* logFile;
+};
+
+template <typename... Args>
+void Logger::Log(LogSite& site, LogLevel level, const char* file, int line, const char* format, const Args&... args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "Logger: too many arguments");
+    if (level < minLevel.load(std::memory_order_relaxed)) return;
+
+    uint32_t suppressedBefore = 0;
+    if (!PassRateLimit(site, suppressedBefore)) return;
+
+    const bool async = running.load(std::memory_order_acquire);
+    Record local;
+    Cell* cell = nullptr;
+    if (async) {
+        cell = AcquireCell();
+        if (!cell) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    Record& record = cell ? cell->record : local;
+    record.time = Now();
+    record.format = format;
+    record.file = file;
+    record.line = line;
+    record.level = level;
+    record.argCount = 0;
+    record.textUsed = 0;
+    record.suppressed = suppressedBefore;
+    (StoreArg(record, args), ...);
+
+    if (cell) {
+        PublishCell(cell);
+        return;
+    }
+
+    // 后台线程未运行：在调用线程上直接输出
+    std::string out;
+    FormatRecord(record, out);
+    WriteLine(level, out);
+}
+
+template <typename T>
+void Logger::StoreArg(Record& record, const T& value) {
+    Arg& arg = record.args[record.argCount++];
+    if constexpr (std::is_same_v<T, bool>) {
+        arg.type = ArgType::BOOL;
+        arg.value.u = value ? 1 : 0;
+    } else if constexpr (std::is_same_v<T, char>) {
+        arg.type = ArgType::CHAR;
+        arg.value.i = value;
+    } else if constexpr (std::is_enum_v<T>) {
+        arg.type = ArgType::I64;
+        arg.value.i = static_cast<int64_t>(value);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        arg.type = ArgType::I64;
+        arg.value.i = value;
+    } else if constexpr (std::is_integral_v<T>) {
+        arg.type = ArgType::U64;
+        arg.value.u = value;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        arg.type = ArgType::F64;
+        arg.value.d = value;
+    } else if constexpr (std::is_array_v<T>) {
+        StoreText(record, arg, std::string_view(value));
+    } else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, std::string_view>) {
+        StoreText(record, arg, value ? std::string_view(value) : std::string_view("(null)"));
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        StoreText(record, arg, std::string_view(value));
+    } else if constexpr (std::is_pointer_v<T>) {
+        arg.type = ArgType::POINTER;
+        arg.value.p = value;
+    } else {
+        static_assert(std::is_pointer_v<T>, "Logger: unsupported argument type");
+    }
+}
+
+#define LOG_AT(level, ...)                                                                  \
+    do {                                                                                    \
+        static LogSite logSite;                                                             \
+        Logger::Instance().Log(logSite, level, __FILE__, __LINE__, __VA_ARGS__);            \
+    } while (0)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_TRACE(...) LOG_AT(LogLevel::TRACE, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG(...) LOG_AT(LogLevel::DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 2
+#define LOG_INFO(...) LOG_AT(LogLevel::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 3
+#define LOG_WARN(...) LOG_AT(LogLevel::WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#define LOG_ERROR(...) LOG_AT(LogLevel::ERR, __VA_ARGS__)
+
+#endif //LOGGER_H
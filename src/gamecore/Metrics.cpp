@@ -0,0 +1,345 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "Metrics.h"
+#include "Logger.h"
+
+#include <algorithm>
+
+namespace {
+    // 默认延迟分桶（毫秒），覆盖 0.05ms 的小阶段到掉帧级别的 100ms
+    constexpr double LATENCY_BOUNDS_MS[] = {0.05, 0.1, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 12.0, 16.7, 20.0, 33.3, 50.0, 100.0};
+    constexpr auto SAMPLE_INTERVAL = std::chrono::seconds(1);
+
+    bool EndsWith(const std::string& text, const char* suffix) {
+        const std::string tail(suffix);
+        return text.size() >= tail.size() && text.compare(text.size() - tail.size(), tail.size(), tail) == 0;
+    }
+}
+
+MetricsRegistry& MetricsRegistry::Instance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::MetricsRegistry()
+    : frozen(false),
+      slots(std::make_unique<ThreadSlot[]>(MAX_THREADS)),
+      slotCount(0),
+      gauges{},
+      lastCounterTotals{},
+      lastBuckets{},
+      lastSums{},
+      windowCounters{},
+      totalCounters{},
+      running(false),
+      startTime(std::chrono::steady_clock::now()),
+      dumping(false),
+      dumpFile(nullptr),
+      dumpJson(false) {
+    counterNames.reserve(MAX_COUNTERS);
+    gaugeNames.reserve(MAX_GAUGES);
+    histograms.reserve(MAX_HISTOGRAMS);
+}
+
+MetricsRegistry::~MetricsRegistry() {
+    Stop();
+    StopDump();
+}
+
+int MetricsRegistry::FindName(const std::vector<std::string>& names, const std::string& name) {
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int MetricsRegistry::AddCounter(const std::string& name) {
+    int existing = FindName(counterNames, name);
+    if (existing >= 0) return existing;
+    if (frozen.load(std::memory_order_acquire) || counterNames.size() >= MAX_COUNTERS) {
+        LOG_WARN("Metrics: cannot register counter {}", name);
+        return -1;
+    }
+    counterNames.push_back(name);
+    return static_cast<int>(counterNames.size() - 1);
+}
+
+int MetricsRegistry::AddGauge(const std::string& name) {
+    int existing = FindName(gaugeNames, name);
+    if (existing >= 0) return existing;
+    if (frozen.load(std::memory_order_acquire) || gaugeNames.size() >= MAX_GAUGES) {
+        LOG_WARN("Metrics: cannot register gauge {}", name);
+        return -1;
+    }
+    gaugeNames.push_back(name);
+    return static_cast<int>(gaugeNames.size() - 1);
+}
+
+int MetricsRegistry::AddHistogram(const std::string& name, const double* upperBounds, int boundCount) {
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        if (histograms[i].name == name) return static_cast<int>(i);
+    }
+    if (frozen.load(std::memory_order_acquire) || histograms.size() >= MAX_HISTOGRAMS ||
+        !upperBounds || boundCount <= 0 || boundCount > MAX_BUCKETS - 1) {
+        LOG_WARN("Metrics: cannot register histogram {}", name);
+        return -1;
+    }
+
+    HistogramInfo info;
+    info.name = name;
+    info.upperBounds.fill(0.0);
+    std::copy(upperBounds, upperBounds + boundCount, info.upperBounds.begin());
+    std::sort(info.upperBounds.begin(), info.upperBounds.begin() + boundCount);
+    info.boundCount = boundCount;
+    histograms.push_back(info);
+    return static_cast<int>(histograms.size() - 1);
+}
+
+int MetricsRegistry::AddLatencyHistogram(const std::string& name) {
+    return AddHistogram(name, LATENCY_BOUNDS_MS, static_cast<int>(std::size(LATENCY_BOUNDS_MS)));
+}
+
+MetricsRegistry::ThreadSlot& MetricsRegistry::GetSlot() {
+    // 每个线程第一次记录时领取槽位，之后直接命中
+    thread_local ThreadSlot* slot = nullptr;
+    if (!slot) {
+        int index = slotCount.fetch_add(1, std::memory_order_relaxed);
+        slot = &slots[std::min(index, MAX_THREADS - 1)];
+    }
+    return *slot;
+}
+
+void MetricsRegistry::Increment(int counter, uint64_t amount) {
+    if (counter < 0 || counter >= MAX_COUNTERS) return;
+    GetSlot().counters[counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::SetGauge(int gauge, double value) {
+    if (gauge < 0 || gauge >= MAX_GAUGES) return;
+    gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Record(int histogram, double value) {
+    // 注册表在 Start 之后不变，记录线程可以直接读分桶
+    if (histogram < 0 || histogram >= static_cast<int>(histograms.size())) return;
+
+    const HistogramInfo& info = histograms[histogram];
+    int bucket = 0;
+    while (bucket < info.boundCount && value > info.upperBounds[bucket]) {
+        ++bucket;
+    }
+    ThreadSlot& slot = GetSlot();
+    slot.buckets[histogram][bucket].fetch_add(1, std::memory_order_relaxed);
+    slot.sums[histogram].fetch_add(value, std::memory_order_relaxed);
+}
+
+bool MetricsRegistry::Start() {
+    if (running.load(std::memory_order_acquire)) return true;
+
+    frozen.store(true, std::memory_order_release);
+    running.store(true, std::memory_order_release);
+    sampler = std::thread(&MetricsRegistry::SamplerLoop, this);
+    return true;
+}
+
+void MetricsRegistry::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(samplerMutex);
+        if (!running.exchange(false, std::memory_order_acq_rel)) return;
+    }
+    samplerCondition.notify_all();
+    if (sampler.joinable()) {
+        sampler.join();
+    }
+}
+
+bool MetricsRegistry::StartDump(const std::string& path) {
+    std::lock_guard<std::mutex> lock(dumpMutex);
+    if (dumpFile) {
+        std::fclose(dumpFile);
+    }
+    dumpFile = std::fopen(path.c_str(), "w");
+    if (!dumpFile) {
+        LOG_WARN("Metrics: failed to open {}", path);
+        dumping.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    dumpJson = EndsWith(path, ".json") || EndsWith(path, ".jsonl");
+    WriteHeader();
+    dumping.store(true, std::memory_order_relaxed);
+    LOG_INFO("Metrics: dumping to {}", path);
+    return true;
+}
+
+void MetricsRegistry::StopDump() {
+    std::lock_guard<std::mutex> lock(dumpMutex);
+    if (dumpFile) {
+        std::fclose(dumpFile);
+        dumpFile = nullptr;
+    }
+    dumping.store(false, std::memory_order_relaxed);
+}
+
+uint64_t MetricsRegistry::GetCounterRate(int counter) const {
+    if (counter < 0 || counter >= MAX_COUNTERS) return 0;
+    return windowCounters[counter].load(std::memory_order_relaxed);
+}
+
+uint64_t MetricsRegistry::GetCounterTotal(int counter) const {
+    if (counter < 0 || counter >= MAX_COUNTERS) return 0;
+    return totalCounters[counter].load(std::memory_order_relaxed);
+}
+
+double MetricsRegistry::GetGauge(int gauge) const {
+    if (gauge < 0 || gauge >= MAX_GAUGES) return 0.0;
+    return gauges[gauge].load(std::memory_order_relaxed);
+}
+
+MetricsRegistry::HistogramSummary MetricsRegistry::GetHistogram(int histogram) const {
+    HistogramSummary summary;
+    if (histogram < 0 || histogram >= MAX_HISTOGRAMS) return summary;
+
+    const WindowHistogram& window = windowHistograms[histogram];
+    summary.count = window.count.load(std::memory_order_relaxed);
+    summary.mean = window.mean.load(std::memory_order_relaxed);
+    summary.p50 = window.p50.load(std::memory_order_relaxed);
+    summary.p95 = window.p95.load(std::memory_order_relaxed);
+    summary.p99 = window.p99.load(std::memory_order_relaxed);
+    return summary;
+}
+
+void MetricsRegistry::SamplerLoop() {
+    auto nextSample = std::chrono::steady_clock::now() + SAMPLE_INTERVAL;
+    std::unique_lock<std::mutex> lock(samplerMutex);
+    while (running.load(std::memory_order_acquire)) {
+        if (samplerCondition.wait_until(lock, nextSample) == std::cv_status::timeout) {
+            const double seconds = std::chrono::duration<double>(nextSample - startTime).count();
+            Sample(seconds);
+            nextSample += SAMPLE_INTERVAL;
+        }
+    }
+}
+
+void MetricsRegistry::Sample(double timeSeconds) {
+    const int slotsInUse = std::min(slotCount.load(std::memory_order_relaxed), MAX_THREADS);
+
+    for (size_t c = 0; c < counterNames.size(); ++c) {
+        uint64_t total = 0;
+        for (int s = 0; s < slotsInUse; ++s) {
+            total += slots[s].counters[c].load(std::memory_order_relaxed);
+        }
+        windowCounters[c].store(total - lastCounterTotals[c], std::memory_order_relaxed);
+        totalCounters[c].store(total, std::memory_order_relaxed);
+        lastCounterTotals[c] = total;
+    }
+
+    for (size_t h = 0; h < histograms.size(); ++h) {
+        std::array<uint64_t, MAX_BUCKETS> totals{};
+        double sum = 0.0;
+        for (int s = 0; s < slotsInUse; ++s) {
+            for (int b = 0; b <= histograms[h].boundCount; ++b) {
+                totals[b] += slots[s].buckets[h][b].load(std::memory_order_relaxed);
+            }
+            sum += slots[s].sums[h].load(std::memory_order_relaxed);
+        }
+
+        // 这一秒内的增量
+        std::array<uint64_t, MAX_BUCKETS> window{};
+        uint64_t count = 0;
+        for (int b = 0; b <= histograms[h].boundCount; ++b) {
+            window[b] = totals[b] - lastBuckets[h][b];
+            count += window[b];
+        }
+        const double windowSum = sum - lastSums[h];
+        lastBuckets[h] = totals;
+        lastSums[h] = sum;
+
+        WindowHistogram& result = windowHistograms[h];
+        result.count.store(count, std::memory_order_relaxed);
+        result.mean.store(count > 0 ? windowSum / static_cast<double>(count) : 0.0, std::memory_order_relaxed);
+        result.p50.store(Percentile(static_cast<int>(h), window, count, 0.50), std::memory_order_relaxed);
+        result.p95.store(Percentile(static_cast<int>(h), window, count, 0.95), std::memory_order_relaxed);
+        result.p99.store(Percentile(static_cast<int>(h), window, count, 0.99), std::memory_order_relaxed);
+    }
+
+    WriteRow(timeSeconds);
+}
+
+double MetricsRegistry::Percentile(int histogram, const std::array<uint64_t, MAX_BUCKETS>& counts, uint64_t total,
+                                   double quantile) const {
+    if (total == 0) return 0.0;
+
+    const HistogramInfo& info = histograms[histogram];
+    const double target = quantile * static_cast<double>(total);
+    uint64_t cumulative = 0;
+    for (int b = 0; b <= info.boundCount; ++b) {
+        cumulative += counts[b];
+        if (static_cast<double>(cumulative) >= target) {
+            return info.upperBounds[std::min(b, info.boundCount - 1)];
+        }
+    }
+    return info.upperBounds[info.boundCount - 1];
+}
+
+void MetricsRegistry::WriteHeader() {
+    // JSON Lines 每行自带字段名，不需要表头
+    if (!dumpFile || dumpJson) return;
+
+    std::fprintf(dumpFile, "time_s");
+    for (const std::string& name : counterNames) {
+        std::fprintf(dumpFile, ",%s", name.c_str());
+    }
+    for (const std::string& name : gaugeNames) {
+        std::fprintf(dumpFile, ",%s", name.c_str());
+    }
+    for (const HistogramInfo& info : histograms) {
+        const char* name = info.name.c_str();
+        std::fprintf(dumpFile, ",%s_count,%s_mean,%s_p50,%s_p95,%s_p99", name, name, name, name, name);
+    }
+    std::fprintf(dumpFile, "\n");
+    std::fflush(dumpFile);
+}
+
+void MetricsRegistry::WriteRow(double timeSeconds) {
+    std::lock_guard<std::mutex> lock(dumpMutex);
+    if (!dumpFile) return;
+
+    if (dumpJson) {
+        std::fprintf(dumpFile, "{\"time_s\":%.3f,\"counters\":{", timeSeconds);
+        for (size_t c = 0; c < counterNames.size(); ++c) {
+            std::fprintf(dumpFile, "%s\"%s\":%llu", c ? "," : "", counterNames[c].c_str(),
+                         static_cast<unsigned long long>(windowCounters[c].load(std::memory_order_relaxed)));
+        }
+        std::fprintf(dumpFile, "},\"gauges\":{");
+        for (size_t g = 0; g < gaugeNames.size(); ++g) {
+            std::fprintf(dumpFile, "%s\"%s\":%.3f", g ? "," : "", gaugeNames[g].c_str(),
+                         gauges[g].load(std::memory_order_relaxed));
+        }
+        std::fprintf(dumpFile, "},\"histograms\":{");
+        for (size_t h = 0; h < histograms.size(); ++h) {
+            HistogramSummary summary = GetHistogram(static_cast<int>(h));
+            std::fprintf(dumpFile, "%s\"%s\":{\"count\":%llu,\"mean\":%.4f,\"p50\":%.4f,\"p95\":%.4f,\"p99\":%.4f}",
+                         h ? "," : "", histograms[h].name.c_str(), static_cast<unsigned long long>(summary.count),
+                         summary.mean, summary.p50, summary.p95, summary.p99);
+        }
+        std::fprintf(dumpFile, "}}\n");
+    } else {
+        std::fprintf(dumpFile, "%.3f", timeSeconds);
+        for (size_t c = 0; c < counterNames.size(); ++c) {
+            std::fprintf(dumpFile, ",%llu",
+                         static_cast<unsigned long long>(windowCounters[c].load(std::memory_order_relaxed)));
+        }
+        for (size_t g = 0; g < gaugeNames.size(); ++g) {
+            std::fprintf(dumpFile, ",%.3f", gauges[g].load(std::memory_order_relaxed));
+        }
+        for (size_t h = 0; h < histograms.size(); ++h) {
+            HistogramSummary summary = GetHistogram(static_cast<int>(h));
+            std::fprintf(dumpFile, ",%llu,%.4f,%.4f,%.4f,%.4f", static_cast<unsigned long long>(summary.count),
+                         summary.mean, summary.p50, summary.p95, summary.p99);
+        }
+        std::fprintf(dumpFile, "\n");
+    }
+    std::fflush(dumpFile);
+}
@@ -0,0 +1,145 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * MetricsRegistry - 运行期指标
+ * 职责：
+ * 1. 启动时注册计数器、仪表（最新值）和固定分桶直方图，返回编号；Start 之后不再接受注册
+ * 2. 记录只写调用线程自己的槽位（原子加，无锁、无分配）；编号为 -1 时忽略，未注册的系统照常运行
+ * 3. 后台线程每秒汇总所有线程槽位，计算这一秒的计数增量和直方图分位数，供调试信息显示
+ * 4. 可选把每秒的结果追加写入 CSV 或 JSON Lines（按扩展名 .csv / .json 选择），用于离线分析
+ *
+ * 直方图的分位数取所在桶的上界，精度由分桶决定；超出最后一个上界的值计入溢出桶，按最后一个上界报告
+ */
+class MetricsRegistry {
+public:
+    // 一秒窗口内的直方图摘要
+    struct HistogramSummary {
+        uint64_t count = 0;
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+    };
+
+    static MetricsRegistry& Instance();
+
+    ~MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // 注册（同名重复注册返回已有编号）；超出容量或已经 Start 时返回 -1
+    int AddCounter(const std::string& name);
+    int AddGauge(const std::string& name);
+    int AddHistogram(const std::string& name, const double* upperBounds, int boundCount);
+    int AddLatencyHistogram(const std::string& name);    // 默认毫秒分桶
+
+    // 记录（任意线程，无分配）
+    void Increment(int counter, uint64_t amount = 1);
+    void SetGauge(int gauge, double value);
+    void Record(int histogram, double value);
+
+    // 冻结注册表并启动每秒采样线程
+    bool Start();
+    void Stop();
+
+    // 把每秒的采样结果追加写入文件（.json 写 JSON Lines，其余写 CSV）
+    bool StartDump(const std::string& path);
+    void StopDump();
+    bool IsDumping() const { return dumping.load(std::memory_order_relaxed); }
+
+    // 查询：最近一个完整窗口（1 秒）的值；计数器另有累计总数
+    uint64_t GetCounterRate(int counter) const;
+    uint64_t GetCounterTotal(int counter) const;
+    double GetGauge(int gauge) const;
+    HistogramSummary GetHistogram(int histogram) const;
+
+    static constexpr int MAX_COUNTERS = 32;
+    static constexpr int MAX_GAUGES = 16;
+    static constexpr int MAX_HISTOGRAMS = 16;
+    static constexpr int MAX_BUCKETS = 16;      // 含溢出桶
+    static constexpr int MAX_THREADS = 16;      // 超出的线程共用最后一个槽位
+
+private:
+    // 每个线程一份；只有所属线程写入（共用槽位时原子加仍然正确），采样线程只读
+    struct ThreadSlot {
+        std::array<std::atomic<uint64_t>, MAX_COUNTERS> counters;
+        std::array<std::array<std::atomic<uint64_t>, MAX_BUCKETS>, MAX_HISTOGRAMS> buckets;
+        std::array<std::atomic<double>, MAX_HISTOGRAMS> sums;
+    };
+
+    struct HistogramInfo {
+        std::string name;
+        std::array<double, MAX_BUCKETS - 1> upperBounds;
+        int boundCount;
+    };
+
+    // 采样线程写、其它线程读的窗口结果
+    struct WindowHistogram {
+        std::atomic<uint64_t> count{0};
+        std::atomic<double> mean{0.0};
+        std::atomic<double> p50{0.0};
+        std::atomic<double> p95{0.0};
+        std::atomic<double> p99{0.0};
+    };
+
+    MetricsRegistry();
+
+    ThreadSlot& GetSlot();
+    static int FindName(const std::vector<std::string>& names, const std::string& name);
+
+    void SamplerLoop();
+    void Sample(double timeSeconds);
+    double Percentile(int histogram, const std::array<uint64_t, MAX_BUCKETS>& counts, uint64_t total,
+                      double quantile) const;
+    void WriteHeader();
+    void WriteRow(double timeSeconds);
+
+    std::vector<std::string> counterNames;
+    std::vector<std::string> gaugeNames;
+    std::vector<HistogramInfo> histograms;
+    std::atomic<bool> frozen;
+
+    std::unique_ptr<ThreadSlot[]> slots;
+    std::atomic<int> slotCount;
+    std::array<std::atomic<double>, MAX_GAUGES> gauges;
+
+    // 采样线程的上一次累计值（用于求一秒内的增量）
+    std::array<uint64_t, MAX_COUNTERS> lastCounterTotals;
+    std::array<std::array<uint64_t, MAX_BUCKETS>, MAX_HISTOGRAMS> lastBuckets;
+    std::array<double, MAX_HISTOGRAMS> lastSums;
+
+    std::array<std::atomic<uint64_t>, MAX_COUNTERS> windowCounters;
+    std::array<std::atomic<uint64_t>, MAX_COUNTERS> totalCounters;
+    std::array<WindowHistogram, MAX_HISTOGRAMS> windowHistograms;
+
+    std::atomic<bool> running;
+    std::thread sampler;
+    std::mutex samplerMutex;
+    std::condition_variable samplerCondition;
+    std::chrono::steady_clock::time_point startTime;
+
+    std::mutex dumpMutex;
+    std::atomic<bool> dumping;
+    FILE* dumpFile;
+    bool dumpJson;
+};
+
+#endif //METRICS_H
@@ -0,0 +1,47 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "Random.h"
+
+Random::Random(uint64_t seed, uint64_t stream) : state(0), increment(0) {
+    Seed(seed, stream);
+}
+
+void Random::Seed(uint64_t seed, uint64_t stream) {
+    state = 0;
+    increment = (stream << 1u) | 1u;
+    NextUInt();
+    state += seed;
+    NextUInt();
+}
+
+uint32_t Random::NextUInt() {
+    uint64_t oldState = state;
+    state = oldState * 6364136223846793005ULL + increment;
+    uint32_t xorShifted = static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+    uint32_t rotation = static_cast<uint32_t>(oldState >> 59u);
+    return (xorShifted >> rotation) | (xorShifted << ((~rotation + 1u) & 31u));
+}
+
+uint32_t Random::NextUInt(uint32_t bound) {
+    if (bound == 0) return 0;
+
+    // 拒绝采样，去掉取模偏差
+    uint32_t threshold = (~bound + 1u) % bound;
+    while (true) {
+        uint32_t value = NextUInt();
+        if (value >= threshold) {
+            return value % bound;
+        }
+    }
+}
+
+float Random::NextFloat() {
+    // 取高 24 位，保证结果严格小于 1
+    return static_cast<float>(NextUInt() >> 8) * (1.0f / 16777216.0f);
+}
+
+float Random::Range(float minValue, float maxValue) {
+    return minValue + (maxValue - minValue) * NextFloat();
+}
@@ -0,0 +1,41 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/**
+ * Random - 模拟用确定性随机数（PCG32）
+ * 同一种子在任何平台上产生相同序列；状态只有两个整数，可直接写入快照。
+ * 模拟逻辑只使用这个类，不使用 rand()/std::random_device
+ */
+class Random {
+public:
+    struct State {
+        uint64_t state;
+        uint64_t increment;
+    };
+
+    explicit Random(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t stream = 0xda3e39cb94b95bdbULL);
+
+    void Seed(uint64_t seed, uint64_t stream = 0xda3e39cb94b95bdbULL);
+
+    // 随机数
+    uint32_t NextUInt();
+    uint32_t NextUInt(uint32_t bound);      // [0, bound)
+    float NextFloat();                      // [0, 1)
+    float Range(float minValue, float maxValue);
+
+    // 状态读写（快照用）
+    State GetState() const { return {state, increment}; }
+    void SetState(const State& newState) { state = newState.state; increment = newState.increment; }
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
+
+#endif //RANDOM_H
@@ -0,0 +1,298 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "SystemScheduler.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+
+SystemScheduler::SystemScheduler(size_t workerCount)
+    : parallel(workerCount > 0),
+      graphDirty(true),
+      enabledStageCount(0),
+      completedStageCount(0),
+      frameStartTicks(0),
+      lastFrameMs(0.0) {
+    if (workerCount > 0) {
+        threadPool = std::make_unique<ThreadPool>(workerCount);
+    }
+}
+
+SystemScheduler::~SystemScheduler() = default;
+
+int SystemScheduler::AddStage(const std::string& name, uint32_t reads, uint32_t writes,
+                              StageFunction function, bool mainThreadOnly) {
+    Stage stage;
+    stage.name = name;
+    stage.reads = reads;
+    stage.writes = writes;
+    stage.function = std::move(function);
+    stage.mainThreadOnly = mainThreadOnly;
+    stages.push_back(std::move(stage));
+
+    graphDirty = true;
+    return static_cast<int>(stages.size()) - 1;
+}
+
+void SystemScheduler::SetStageEnabled(int stageIndex, bool enabled) {
+    if (stageIndex < 0 || stageIndex >= static_cast<int>(stages.size())) return;
+    if (stages[stageIndex].enabled != enabled) {
+        stages[stageIndex].enabled = enabled;
+        graphDirty = true;
+    }
+}
+
+bool SystemScheduler::IsStageEnabled(int stageIndex) const {
+    if (stageIndex < 0 || stageIndex >= static_cast<int>(stages.size())) return false;
+    return stages[stageIndex].enabled;
+}
+
+void SystemScheduler::BuildGraph() {
+    enabledStageCount = 0;
+
+    for (auto& stage : stages) {
+        stage.successors.clear();
+        stage.dependencyCount = 0;
+        stage.level = 0;
+    }
+
+    // 只在先注册 -> 后注册之间加边，注册顺序本身就是一个合法的拓扑序
+    for (size_t i = 0; i < stages.size(); ++i) {
+        Stage& before = stages[i];
+        if (!before.enabled) continue;
+        enabledStageCount++;
+
+        for (size_t j = i + 1; j < stages.size(); ++j) {
+            Stage& after = stages[j];
+            if (!after.enabled) continue;
+
+            bool writeThenAccess = (before.writes & (after.reads | after.writes)) != 0;
+            bool readThenWrite = (before.reads & after.writes) != 0;
+            if (writeThenAccess || readThenWrite) {
+                before.successors.push_back(static_cast<int>(j));
+                after.dependencyCount++;
+                after.level = std::max(after.level, before.level + 1);
+            }
+        }
+    }
+
+    pendingDependencies = std::make_unique<std::atomic<int>[]>(stages.size());
+    mainThreadReady.reserve(stages.size());
+    graphDirty = false;
+}
+
+void SystemScheduler::Run(float deltaTime) {
+    if (graphDirty) {
+        BuildGraph();
+    }
+
+    frameStartTicks = SDL_GetPerformanceCounter();
+
+    if (parallel && threadPool) {
+        RunParallel(deltaTime);
+    } else {
+        RunSerial(deltaTime);
+    }
+
+    lastFrameMs = TicksToMs(SDL_GetPerformanceCounter() - frameStartTicks);
+}
+
+void SystemScheduler::RunSerial(float deltaTime) {
+    for (size_t i = 0; i < stages.size(); ++i) {
+        if (stages[i].enabled) {
+            ExecuteStage(static_cast<int>(i), deltaTime);
+        }
+    }
+}
+
+void SystemScheduler::RunParallel(float deltaTime) {
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        completedStageCount = 0;
+        mainThreadReady.clear();
+    }
+
+    for (size_t i = 0; i < stages.size(); ++i) {
+        pendingDependencies[i].store(stages[i].dependencyCount, std::memory_order_relaxed);
+    }
+
+    // 派发没有依赖的阶段
+    for (size_t i = 0; i < stages.size(); ++i) {
+        if (stages[i].enabled && stages[i].dependencyCount == 0) {
+            DispatchStage(static_cast<int>(i), deltaTime);
+        }
+    }
+
+    // 主线程：执行只允许在主线程运行的阶段，空闲时帮忙处理线程池任务
+    while (true) {
+        int mainStage = -1;
+        int seenCompleted = 0;
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            if (completedStageCount >= enabledStageCount) break;
+            if (!mainThreadReady.empty()) {
+                mainStage = mainThreadReady.back();
+                mainThreadReady.pop_back();
+            }
+            seenCompleted = completedStageCount;
+        }
+
+        if (mainStage >= 0) {
+            ExecuteStage(mainStage, deltaTime);
+            OnStageFinished(mainStage, deltaTime);
+            continue;
+        }
+
+        if (threadPool->TryRunPendingTask()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(frameMutex);
+        frameCondition.wait(lock, [this, seenCompleted] {
+            return completedStageCount != seenCompleted || !mainThreadReady.empty();
+        });
+    }
+}
+
+void SystemScheduler::DispatchStage(int stageIndex, float deltaTime) {
+    if (stages[stageIndex].mainThreadOnly) {
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            mainThreadReady.push_back(stageIndex);
+        }
+        frameCondition.notify_all();
+        return;
+    }
+
+    threadPool->Submit([this, stageIndex, deltaTime] {
+        ExecuteStage(stageIndex, deltaTime);
+        OnStageFinished(stageIndex, deltaTime);
+    });
+}
+
+void SystemScheduler::OnStageFinished(int stageIndex, float deltaTime) {
+    // 先释放后继，再标记完成，保证主线程看到“全部完成”时不会有遗漏的派发
+    for (int successor : stages[stageIndex].successors) {
+        if (pendingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            DispatchStage(successor, deltaTime);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        completedStageCount++;
+    }
+    frameCondition.notify_all();
+}
+
+void SystemScheduler::ExecuteStage(int stageIndex, float deltaTime) {
+    Stage& stage = stages[stageIndex];
+    Uint64 begin = SDL_GetPerformanceCounter();
+
+    if (stage.function) {
+        stage.function(deltaTime);
+    }
+
+    Uint64 end = SDL_GetPerformanceCounter();
+    stage.timing.startMs = TicksToMs(begin - frameStartTicks);
+    stage.timing.endMs = TicksToMs(end - frameStartTicks);
+    stage.timing.threadIndex = ThreadPool::GetCurrentThreadIndex();
+
+    // 指数平滑，避免调试视图跳动
+    double duration = stage.timing.endMs - stage.timing.startMs;
+    stage.timing.averageMs = stage.timing.averageMs * 0.9 + duration * 0.1;
+}
+
+double SystemScheduler::TicksToMs(Uint64 ticks) const {
+    return static_cast<double>(ticks) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+int SystemScheduler::AddCounter(const std::string& name) {
+    counters.push_back(Counter{name, 0.0, 0.0});
+    return static_cast<int>(counters.size()) - 1;
+}
+
+void SystemScheduler::SetCounter(int counterIndex, double value) {
+    if (counterIndex < 0 || counterIndex >= static_cast<int>(counters.size())) return;
+    Counter& counter = counters[counterIndex];
+    counter.value = value;
+    counter.peak = std::max(counter.peak, value);
+}
+
+void SystemScheduler::LogSchedule() const {
+    LOG_INFO("SystemScheduler: {} stages, {} workers, {}, last frame {} ms", stages.size(), GetWorkerCount(),
+             parallel && threadPool ? "parallel" : "serial", lastFrameMs);
+
+    for (size_t i = 0; i < stages.size(); ++i) {
+        const Stage& stage = stages[i];
+
+        // 后继列表先拼进栈上缓冲（日志参数个数有限，超长截断）
+        char suffix[96];
+        int used = std::snprintf(suffix, sizeof(suffix), "%s", stage.successors.empty() ? "" : " ->");
+        for (int successor : stage.successors) {
+            if (used < 0 || used >= static_cast<int>(sizeof(suffix))) break;
+            used += std::snprintf(suffix + used, sizeof(suffix) - used, " %s", stages[successor].name.c_str());
+        }
+        if (!stage.enabled && used >= 0 && used < static_cast<int>(sizeof(suffix))) {
+            std::snprintf(suffix + used, sizeof(suffix) - used, " (disabled)");
+        }
+
+        LOG_INFO("  [{}] {} level={} thread={} start={} end={} avg={} ms{}", i, stage.name, stage.level,
+                 stage.timing.threadIndex, stage.timing.startMs, stage.timing.endMs, stage.timing.averageMs, suffix);
+    }
+
+    for (const Counter& counter : counters) {
+        LOG_INFO("  counter {} value={} peak={}", counter.name, counter.value, counter.peak);
+    }
+}
+
+void SystemScheduler::SubmitDebug(RenderQueue& queue, float x, float y, float width) const {
+    if (stages.empty()) return;
+
+    // 纯色四边形全部进同一个批次，深度 0 为底板，1 为条形
+    auto submitRect = [&queue](uint16_t depth, const SDL_FRect& rect, const SDL_Color& color) {
+        queue.SubmitQuad(RenderLayer::OVERLAY, depth, nullptr, nullptr, rect.x + rect.w * 0.5f, rect.y + rect.h * 0.5f,
+                         rect.w, rect.h, 0.0f, color, BlendMode::ALPHA);
+    };
+
+    // 甘特图：每个线程一行，横轴为本帧时间
+    const float laneHeight = 10.0f;
+    const int laneCount = static_cast<int>(GetWorkerCount()) + 1;
+    double spanMs = std::max(lastFrameMs, 0.001);
+
+    submitRect(0, SDL_FRect{x, y, width, laneHeight * laneCount + 4.0f}, SDL_Color{0, 0, 0, 160});
+
+    for (size_t i = 0; i < stages.size(); ++i) {
+        const Stage& stage = stages[i];
+        if (!stage.enabled) continue;
+
+        float barX = x + static_cast<float>(stage.timing.startMs / spanMs) * width;
+        float barW = static_cast<float>((stage.timing.endMs - stage.timing.startMs) / spanMs) * width;
+        SDL_FRect bar = {
+            barX,
+            y + 2.0f + laneHeight * stage.timing.threadIndex,
+            std::max(barW, 1.0f),
+            laneHeight - 2.0f
+        };
+
+        // 按阶段编号取颜色，同一阶段每帧颜色固定
+        Uint8 r = static_cast<Uint8>(80 + (i * 67) % 176);
+        Uint8 g = static_cast<Uint8>(80 + (i * 131) % 176);
+        Uint8 b = static_cast<Uint8>(80 + (i * 197) % 176);
+        submitRect(1, bar, SDL_Color{r, g, b, 255});
+    }
+
+    // 计数器：每个一行，长度为当前值 / 历史峰值
+    float counterY = y + laneHeight * laneCount + 6.0f;
+    for (size_t i = 0; i < counters.size(); ++i) {
+        const Counter& counter = counters[i];
+        submitRect(0, SDL_FRect{x, counterY, width, 4.0f}, SDL_Color{0, 0, 0, 160});
+        if (counter.peak > 0.0) {
+            SDL_FRect bar = {x, counterY, static_cast<float>(counter.value / counter.peak) * width, 4.0f};
+            submitRect(1, bar, SDL_Color{255, static_cast<Uint8>(200 - (i * 60) % 160), 60, 255});
+        }
+        counterY += 6.0f;
+    }
+}
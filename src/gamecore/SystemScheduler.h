@@ -0,0 +1,146 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef SYSTEMSCHEDULER_H
+#define SYSTEMSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <SDL3/SDL.h>
+
+#include "ThreadPool.h"
+#include "../graphics/RenderQueue.h"
+
+// 阶段读写的数据块（位掩码），用于推导阶段间的依赖关系
+namespace SystemData {
+    constexpr uint32_t INPUT       = 1u << 0;   // 输入状态
+    constexpr uint32_t PLAYER      = 1u << 1;   // 自机
+    constexpr uint32_t ENEMIES     = 1u << 2;   // 敌人
+    constexpr uint32_t EMITTERS    = 1u << 3;   // 发射器/弹幕脚本
+    constexpr uint32_t BULLETS     = 1u << 4;   // 子弹池
+    constexpr uint32_t ANIMATION   = 1u << 5;   // 动画状态
+    constexpr uint32_t RENDER_LIST = 1u << 6;   // 渲染列表
+    constexpr uint32_t GAME_STATE  = 1u << 7;   // 游戏全局状态（运行标志等）
+    constexpr uint32_t ITEMS       = 1u << 8;   // 道具池
+}
+
+/**
+ * SystemScheduler - 按读写声明并行执行更新阶段
+ * 职责：
+ * 1. 注册更新阶段（名称、读集合、写集合、执行函数）
+ * 2. 根据读写冲突建立依赖图：先注册的阶段写了后注册阶段要读/写的数据，
+ *    或者读了后注册阶段要写的数据，则两者之间加一条边
+ * 3. 每帧在线程池上执行依赖图，互不冲突的阶段并发运行
+ * 4. 记录每个阶段的起止时间和执行线程，提供文本/甘特图两种调试视图
+ * 5. 附带少量每帧计数器（如渲染的绘制调用/状态切换次数），与阶段计时一起显示
+ *
+ * 注册顺序即串行语义：并行执行的结果与按注册顺序串行执行一致
+ */
+class SystemScheduler {
+public:
+    using StageFunction = std::function<void(float)>;
+
+    // 单个阶段的计时信息（毫秒，相对于本帧开始）
+    struct StageTiming {
+        double startMs = 0.0;
+        double endMs = 0.0;
+        double averageMs = 0.0;   // 平滑后的耗时
+        int threadIndex = 0;      // 0 为主线程
+    };
+
+    // workerCount 为0时按注册顺序串行执行
+    explicit SystemScheduler(size_t workerCount = 0);
+    ~SystemScheduler();
+
+    // 注册阶段，返回阶段编号；mainThreadOnly 的阶段只在主线程执行（如调用SDL的阶段）
+    int AddStage(const std::string& name, uint32_t reads, uint32_t writes,
+                 StageFunction function, bool mainThreadOnly = false);
+
+    // 启用/禁用阶段（依赖图会在下一帧重建）
+    void SetStageEnabled(int stageIndex, bool enabled);
+    bool IsStageEnabled(int stageIndex) const;
+
+    // 并行开关（调试用，关闭后退化为串行）
+    void SetParallel(bool enable) { parallel = enable; }
+    bool IsParallel() const { return parallel; }
+
+    // 执行一帧
+    void Run(float deltaTime);
+
+    // 每帧计数器：注册返回编号，之后每帧 SetCounter 覆盖当前值（同时记录峰值）
+    int AddCounter(const std::string& name);
+    void SetCounter(int counterIndex, double value);
+
+    // 调度表（层级、后继、各阶段耗时与计数器）写入日志，每个阶段一行
+    void LogSchedule() const;
+
+    // 调试视图（甘特图下方按峰值比例画出各计数器的条形），提交到渲染队列的覆盖层
+    void SubmitDebug(RenderQueue& queue, float x, float y, float width) const;
+
+    // 统计查询
+    size_t GetStageCount() const { return stages.size(); }
+    const std::string& GetStageName(int stageIndex) const { return stages[stageIndex].name; }
+    const StageTiming& GetStageTiming(int stageIndex) const { return stages[stageIndex].timing; }
+    double GetLastFrameMs() const { return lastFrameMs; }
+    size_t GetCounterCount() const { return counters.size(); }
+    double GetCounterValue(int counterIndex) const { return counters[counterIndex].value; }
+    size_t GetWorkerCount() const { return threadPool ? threadPool->GetThreadCount() : 0; }
+
+private:
+    struct Stage {
+        std::string name;
+        uint32_t reads = 0;
+        uint32_t writes = 0;
+        StageFunction function;
+        bool mainThreadOnly = false;
+        bool enabled = true;
+
+        // 依赖图（BuildGraph 生成）
+        std::vector<int> successors;
+        int dependencyCount = 0;
+        int level = 0;
+
+        StageTiming timing;
+    };
+
+    struct Counter {
+        std::string name;
+        double value = 0.0;
+        double peak = 0.0;
+    };
+
+    void BuildGraph();
+    void RunSerial(float deltaTime);
+    void RunParallel(float deltaTime);
+    void ExecuteStage(int stageIndex, float deltaTime);
+    void DispatchStage(int stageIndex, float deltaTime);
+    void OnStageFinished(int stageIndex, float deltaTime);
+    double TicksToMs(Uint64 ticks) const;
+
+    std::vector<Stage> stages;
+    std::vector<Counter> counters;
+    std::unique_ptr<ThreadPool> threadPool;
+    bool parallel;
+    bool graphDirty;
+
+    // 每帧执行状态
+    std::unique_ptr<std::atomic<int>[]> pendingDependencies;
+    std::vector<int> mainThreadReady;    // 等待主线程执行的阶段
+    std::mutex frameMutex;
+    std::condition_variable frameCondition;
+    int enabledStageCount;
+    int completedStageCount;
+
+    // 计时
+    Uint64 frameStartTicks;
+    double lastFrameMs;
+};
+
+#endif //SYSTEMSCHEDULER_H
@@ -0,0 +1,74 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "ThreadPool.h"
+
+namespace {
+    thread_local int currentThreadIndex = 0;
+}
+
+ThreadPool::ThreadPool(size_t threadCount) : stopping(false) {
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, static_cast<int>(i + 1));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        tasks.push_back(std::move(task));
+    }
+    queueCondition.notify_one();
+}
+
+bool ThreadPool::TryRunPendingTask() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+int ThreadPool::GetCurrentThreadIndex() {
+    return currentThreadIndex;
+}
+
+void ThreadPool::WorkerLoop(int threadIndex) {
+    currentThreadIndex = threadIndex;
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
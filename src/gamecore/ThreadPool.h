@@ -0,0 +1,55 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * ThreadPool - 固定线程数的任务池
+ * 职责：
+ * - 启动时创建工作线程，运行期间不再创建/销毁线程
+ * - 接收任务并分发给空闲的工作线程
+ * - 允许提交线程（主线程）在等待时顺便执行队列里的任务
+ *
+ * 线程编号：主线程为 0，工作线程为 1..N，供调度器做可视化分道
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 提交任务
+    void Submit(std::function<void()> task);
+
+    // 在调用线程上执行一个待处理任务，没有任务时返回false
+    bool TryRunPendingTask();
+
+    // 工作线程数量（不含主线程）
+    size_t GetThreadCount() const { return workers.size(); }
+
+    // 当前线程编号：主线程（或任何非池线程）为0
+    static int GetCurrentThreadIndex();
+
+private:
+    void WorkerLoop(int threadIndex);
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    bool stopping;
+};
+
+#endif //THREADPOOL_H
@@ -0,0 +1,155 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "GlyphCache.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+#include <SDL3_ttf/SDL_ttf.h>
+
+GlyphCache::GlyphCache() : glyphs{}, lineHeight(0), spaceAdvance(0) {
+}
+
+bool GlyphCache::Initialize(Renderer& renderer, const std::string& fontPath, float pointSize, const char* characters) {
+    // 默认：全部可打印 ASCII
+    char printable[96];
+    if (!characters || !*characters) {
+        for (int i = 0; i < 95; ++i) {
+            printable[i] = static_cast<char>(' ' + i);
+        }
+        printable[95] = '\0';
+        characters = printable;
+    }
+
+    TTF_Font* font = TTF_OpenFont(fontPath.c_str(), pointSize);
+    if (!font) {
+        std::cerr << "GlyphCache: failed to open font " << fontPath << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    lineHeight = TTF_GetFontHeight(font);
+    int advance = 0;
+    spaceAdvance = TTF_GetGlyphMetrics(font, ' ', nullptr, nullptr, nullptr, nullptr, &advance) ? advance
+                                                                                                 : lineHeight / 2;
+
+    // 先逐个光栅化并按行排布（行宽不超过 MAX_ATLAS_WIDTH），算出贴图尺寸后再拼接
+    std::array<SDL_Surface*, GLYPH_COUNT> surfaces{};
+    int atlasWidth = 0;
+    int penX = 0;
+    int rowY = 0;
+    int rowHeight = 0;
+    for (const char* c = characters; *c; ++c) {
+        const unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch >= GLYPH_COUNT || surfaces[ch] || ch == ' ') continue;
+
+        surfaces[ch] = TTF_RenderGlyph_Blended(font, ch, SDL_Color{255, 255, 255, 255});
+        if (!surfaces[ch]) continue;
+
+        if (!TTF_GetGlyphMetrics(font, ch, nullptr, nullptr, nullptr, nullptr, &advance)) {
+            advance = surfaces[ch]->w;
+        }
+        if (penX > 0 && penX + surfaces[ch]->w > MAX_ATLAS_WIDTH) {
+            penX = 0;
+            rowY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        // 相邻字形之间留 1 像素，线性过滤时不会采到隔壁
+        glyphs[ch] = Glyph{SDL_Rect{penX, rowY, surfaces[ch]->w, surfaces[ch]->h}, advance};
+        penX += surfaces[ch]->w + 1;
+        atlasWidth = std::max(atlasWidth, penX);
+        rowHeight = std::max(rowHeight, surfaces[ch]->h);
+    }
+    const int atlasHeight = rowY + rowHeight;
+
+    bool created = false;
+    SDL_Surface* atlasSurface = atlasWidth > 0 && atlasHeight > 0
+                                    ? SDL_CreateSurface(atlasWidth, atlasHeight, SDL_PIXELFORMAT_RGBA32)
+                                    : nullptr;
+    if (atlasSurface) {
+        SDL_FillSurfaceRect(atlasSurface, nullptr, 0);
+        for (int ch = 0; ch < GLYPH_COUNT; ++ch) {
+            if (!surfaces[ch]) continue;
+            // 直接拷贝像素（含透明度），不与空白底色混合
+            SDL_SetSurfaceBlendMode(surfaces[ch], SDL_BLENDMODE_NONE);
+            SDL_Rect dest = glyphs[ch].src;
+            SDL_BlitSurface(surfaces[ch], nullptr, atlasSurface, &dest);
+        }
+        created = atlas.CreateFromSurface(atlasSurface, renderer);
+        SDL_DestroySurface(atlasSurface);
+    }
+
+    for (SDL_Surface* surface : surfaces) {
+        if (surface) {
+            SDL_DestroySurface(surface);
+        }
+    }
+    TTF_CloseFont(font);
+
+    if (!created) {
+        std::cerr << "GlyphCache: failed to build glyph atlas for " << fontPath << std::endl;
+        glyphs.fill(Glyph{});
+        return false;
+    }
+    return true;
+}
+
+float GlyphCache::SubmitText(RenderQueue& queue, RenderLayer layer, uint16_t depth, float x, float y,
+                             const char* text, const SDL_Color& color) const {
+    if (!text || !atlas.IsLoaded()) return 0.0f;
+
+    float penX = x;
+    float penY = y;
+    float maxWidth = 0.0f;
+    for (const char* c = text; *c; ++c) {
+        const unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch == '\n') {
+            maxWidth = std::max(maxWidth, penX - x);
+            penX = x;
+            penY += static_cast<float>(lineHeight);
+            continue;
+        }
+        const Glyph* glyph = ch < GLYPH_COUNT ? &glyphs[ch] : nullptr;
+        if (!glyph || glyph->src.w == 0) {
+            penX += static_cast<float>(spaceAdvance);
+            continue;
+        }
+        const float w = static_cast<float>(glyph->src.w);
+        const float h = static_cast<float>(glyph->src.h);
+        queue.SubmitQuad(layer, depth, &atlas, &glyph->src, penX + w * 0.5f, penY + h * 0.5f, w, h, 0.0f, color,
+                         BlendMode::ALPHA);
+        penX += static_cast<float>(glyph->advance);
+    }
+    return std::max(maxWidth, penX - x);
+}
+
+float GlyphCache::SubmitFormat(RenderQueue& queue, RenderLayer layer, uint16_t depth, float x, float y,
+                               const SDL_Color& color, const char* format, ...) const {
+    if (!format || !atlas.IsLoaded()) return 0.0f;
+
+    char buffer[MAX_FORMAT_LENGTH + 1];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return SubmitText(queue, layer, depth, x, y, buffer, color);
+}
+
+float GlyphCache::MeasureText(const char* text) const {
+    if (!text) return 0.0f;
+
+    int width = 0;
+    int maxWidth = 0;
+    for (const char* c = text; *c; ++c) {
+        const unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch == '\n') {
+            maxWidth = std::max(maxWidth, width);
+            width = 0;
+            continue;
+        }
+        width += (ch < GLYPH_COUNT && glyphs[ch].src.w > 0) ? glyphs[ch].advance : spaceAdvance;
+    }
+    return static_cast<float>(std::max(maxWidth, width));
+}
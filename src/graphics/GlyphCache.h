@@ -0,0 +1,61 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef GLYPHCACHE_H
+#define GLYPHCACHE_H
+
+#include <array>
+#include <string>
+#include <SDL3/SDL.h>
+#include "Renderer.h"
+#include "RenderQueue.h"
+#include "Sprite.h"
+
+/**
+ * 字形缓存（文字渲染器）
+ * 初始化时用 SDL3_ttf 把字符逐个光栅化（白色），按行装进一张图集贴图；
+ * 之后绘制文字只是按字符查表、提交带颜色的四边形，同一图集的文字与其它四边形一起合批，
+ * 不再调用 TTF，也不创建贴图或分配内存。
+ * 初始化之后只读，模拟线程可以直接用它向渲染队列提交文字
+ */
+class GlyphCache {
+public:
+    GlyphCache();
+
+    // 加载字体并缓存 characters 中的字符（只支持 ASCII，为空时缓存全部可打印字符），失败时返回 false，文字不显示
+    bool Initialize(Renderer& renderer, const std::string& fontPath, float pointSize,
+                    const char* characters = nullptr);
+
+    bool IsLoaded() const { return atlas.IsLoaded(); }
+    int GetLineHeight() const { return lineHeight; }
+
+    // 以 (x, y) 为左上角提交文字（'\n' 换行），返回最宽一行的宽度；未缓存的字符按空格宽度跳过
+    float SubmitText(RenderQueue& queue, RenderLayer layer, uint16_t depth, float x, float y,
+                     const char* text, const SDL_Color& color) const;
+
+    // printf 风格：在栈上格式化（最长 MAX_FORMAT_LENGTH 个字符，超出截断）后提交
+    float SubmitFormat(RenderQueue& queue, RenderLayer layer, uint16_t depth, float x, float y,
+                       const SDL_Color& color, const char* format, ...) const;
+
+    // 文字的宽度（多行时取最宽一行）
+    float MeasureText(const char* text) const;
+
+    static constexpr int MAX_FORMAT_LENGTH = 255;
+
+private:
+    struct Glyph {
+        SDL_Rect src;       // 在贴图中的区域（w 为 0 表示未缓存）
+        int advance;        // 笔位前进量
+    };
+
+    static constexpr int GLYPH_COUNT = 128;
+    static constexpr int MAX_ATLAS_WIDTH = 512;    // 超出换行装填
+
+    std::array<Glyph, GLYPH_COUNT> glyphs;
+    Sprite atlas;
+    int lineHeight;
+    int spaceAdvance;
+};
+
+#endif //GLYPHCACHE_H
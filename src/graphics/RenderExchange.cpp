@@ -0,0 +1,50 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "RenderExchange.h"
+
+RenderQueue& RenderExchange::BeginWrite() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        writeSlot = readSlot == 0 ? 1 : 0;
+        // 上一 tick 发布的帧还没被取走，就在同一个槽上覆盖
+        if (publishedSlot == writeSlot) {
+            publishedSlot = NO_SLOT;
+            droppedCount++;
+        }
+    }
+    slots[writeSlot].Begin();
+    return slots[writeSlot];
+}
+
+void RenderExchange::Publish() {
+    if (writeSlot == NO_SLOT) return;
+
+    // 排序在模拟线程完成，渲染线程拿到的是排好序的只读队列
+    slots[writeSlot].Close();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    publishedSlot = writeSlot;
+    writeSlot = NO_SLOT;
+    publishedCount++;
+}
+
+const RenderQueue* RenderExchange::AcquireLatest() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (publishedSlot != NO_SLOT) {
+        readSlot = publishedSlot;
+        publishedSlot = NO_SLOT;
+    }
+    return readSlot == NO_SLOT ? nullptr : &slots[readSlot];
+}
+
+uint64_t RenderExchange::GetPublishedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return publishedCount;
+}
+
+uint64_t RenderExchange::GetDroppedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return droppedCount;
+}
@@ -0,0 +1,54 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef RENDEREXCHANGE_H
+#define RENDEREXCHANGE_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include "RenderQueue.h"
+
+/**
+ * 模拟线程与渲染线程之间的双缓冲渲染队列
+ * 模拟线程每 tick 结束时写满一个队列并发布；渲染线程每帧取最新发布的队列绘制。
+ * 渲染线程持有的队列（读槽）永远不会被写，写槽总是另一个，两边只在交接时短暂加锁。
+ *
+ *   模拟：BeginWrite -> Submit... -> Publish      （写槽 = 非读槽）
+ *   渲染：AcquireLatest -> Draw                   （有新发布时切换读槽，否则重画上一帧）
+ *
+ * 渲染跟不上时，未被取走的帧会被下一 tick 直接覆盖（计入丢弃数），模拟从不等待渲染
+ */
+class RenderExchange {
+public:
+    RenderExchange() = default;
+
+    // 模拟线程：取得本 tick 的写队列（已 Begin）
+    RenderQueue& BeginWrite();
+
+    // 模拟线程：排序并发布写队列
+    void Publish();
+
+    // 渲染线程：取最新发布的队列；没有新发布时返回上一次的队列，从未发布过时返回空
+    const RenderQueue* AcquireLatest();
+
+    // 统计
+    uint64_t GetPublishedCount() const;
+    uint64_t GetDroppedCount() const;
+
+private:
+    static constexpr int NO_SLOT = -1;
+
+    std::array<RenderQueue, 2> slots;
+
+    mutable std::mutex mutex;
+    int writeSlot = NO_SLOT;     // 仅模拟线程使用
+    int readSlot = NO_SLOT;      // 渲染线程正在绘制的槽
+    int publishedSlot = NO_SLOT; // 已发布、尚未被渲染线程取走的槽
+
+    uint64_t publishedCount = 0;
+    uint64_t droppedCount = 0;
+};
+
+#endif //RENDEREXCHANGE_H
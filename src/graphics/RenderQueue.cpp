@@ -0,0 +1,186 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "RenderQueue.h"
+#include "Sprite.h"
+#include "RenderTargetCache.h"
+
+#include <array>
+
+RenderQueue::RenderQueue(size_t reserveCommands) : lastTextureSlot(0) {
+    commands.reserve(reserveCommands);
+    items.reserve(reserveCommands);
+    scratch.reserve(reserveCommands);
+}
+
+void RenderQueue::Begin() {
+    commands.clear();
+    items.clear();
+    geometries.clear();
+    geometryVertices.clear();
+    geometryIndices.clear();
+    layerVersions.fill(0);
+}
+
+uint16_t RenderQueue::GetTextureId(const Sprite* sprite) {
+    SDL_Texture* texture = (sprite && sprite->IsLoaded()) ? sprite->GetTexture() : nullptr;
+    if (!texture) return 0;
+
+    // 贴图种类很少，线性查找；连续提交同一贴图时直接命中
+    if (lastTextureSlot < textureIds.size() && textureIds[lastTextureSlot] == texture) {
+        return static_cast<uint16_t>(lastTextureSlot + 1);
+    }
+    for (size_t i = 0; i < textureIds.size(); ++i) {
+        if (textureIds[i] == texture) {
+            lastTextureSlot = i;
+            return static_cast<uint16_t>(i + 1);
+        }
+    }
+    if (textureIds.size() >= 0xFFFE) {
+        return 0xFFFF;
+    }
+    textureIds.push_back(texture);
+    lastTextureSlot = textureIds.size() - 1;
+    return static_cast<uint16_t>(textureIds.size());
+}
+
+void RenderQueue::SubmitQuad(RenderLayer layer, uint16_t depth, const Sprite* sprite, const SDL_Rect* src,
+                             float centerX, float centerY, float width, float height, float angleDeg,
+                             const SDL_Color& color, BlendMode blend) {
+    items.push_back(SortItem{MakeKey(layer, static_cast<uint8_t>(blend), GetTextureId(sprite), depth),
+                             static_cast<uint32_t>(commands.size())});
+    commands.push_back(Command{sprite, NO_GEOMETRY, src ? *src : SDL_Rect{0, 0, 0, 0},
+                               centerX, centerY, width, height, angleDeg, color, blend, src != nullptr});
+}
+
+void RenderQueue::SubmitGeometry(RenderLayer layer, uint16_t depth, const Sprite* sprite,
+                                 const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount,
+                                 BlendMode blend) {
+    if (!vertices || !indices || vertexCount <= 0 || indexCount <= 0) return;
+
+    // 贴图编号固定为 0：同层同深度的几何命令严格按提交顺序绘制
+    items.push_back(SortItem{MakeKey(layer, GEOMETRY_BLEND, 0, depth), static_cast<uint32_t>(commands.size())});
+    commands.push_back(Command{sprite, static_cast<uint32_t>(geometries.size()), SDL_Rect{0, 0, 0, 0},
+                               0.0f, 0.0f, 0.0f, 0.0f, 0.0f, SDL_Color{255, 255, 255, 255}, blend, false});
+    geometries.push_back(GeometryRange{static_cast<uint32_t>(geometryVertices.size()), static_cast<uint32_t>(vertexCount),
+                                       static_cast<uint32_t>(geometryIndices.size()), static_cast<uint32_t>(indexCount)});
+    geometryVertices.insert(geometryVertices.end(), vertices, vertices + vertexCount);
+    geometryIndices.insert(geometryIndices.end(), indices, indices + indexCount);
+}
+
+void RenderQueue::SubmitRect(RenderLayer layer, uint16_t depth, const SDL_FRect& rect, const SDL_Color& color) {
+    const SDL_FColor fcolor = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+    const SDL_Vertex vertices[4] = {
+        {{rect.x, rect.y}, fcolor, {0.0f, 0.0f}},
+        {{rect.x + rect.w, rect.y}, fcolor, {1.0f, 0.0f}},
+        {{rect.x, rect.y + rect.h}, fcolor, {0.0f, 1.0f}},
+        {{rect.x + rect.w, rect.y + rect.h}, fcolor, {1.0f, 1.0f}},
+    };
+    static constexpr int indices[6] = {0, 1, 2, 2, 1, 3};
+    SubmitGeometry(layer, depth, nullptr, vertices, 4, indices, 6, BlendMode::ALPHA);
+}
+
+void RenderQueue::SortItems() {
+    const size_t count = items.size();
+    if (count < 2) return;
+    scratch.resize(count);
+
+    // 低 16 位保留不用，从第 2 个字节开始
+    for (int shift = 16; shift < 64; shift += 8) {
+        std::array<uint32_t, 256> histogram{};
+        for (const SortItem& item : items) {
+            histogram[(item.key >> shift) & 0xFF]++;
+        }
+        // 所有键在该字节上相同（常见于层/混合模式），这一趟不改变顺序
+        if (histogram[(items[0].key >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram) {
+            uint32_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (const SortItem& item : items) {
+            scratch[histogram[(item.key >> shift) & 0xFF]++] = item;
+        }
+        items.swap(scratch);
+    }
+}
+
+void RenderQueue::SetLayerCache(RenderLayer layer, uint64_t version) {
+    if (layer >= RenderLayer::COUNT) return;
+    layerVersions[static_cast<size_t>(layer)] = version;
+}
+
+void RenderQueue::Close() {
+    SortItems();
+}
+
+RenderQueue::FrameStats RenderQueue::Draw(Renderer* renderer, SpriteBatch& batch, RenderTargetCache* cache) const {
+    FrameStats stats;
+    stats.commands = commands.size();
+    if (!renderer || items.empty()) return stats;
+
+    batch.Begin();
+    const size_t count = items.size();
+    size_t i = 0;
+    while (i < count) {
+        // 排序后同层的命令连续，逐层处理，层与层之间 Flush 一次
+        const uint8_t layer = static_cast<uint8_t>(items[i].key >> 56);
+        size_t end = i + 1;
+        while (end < count && static_cast<uint8_t>(items[end].key >> 56) == layer) {
+            ++end;
+        }
+
+        const uint64_t version = layer < layerVersions.size() ? layerVersions[layer] : 0;
+        const RenderLayer renderLayer = static_cast<RenderLayer>(layer);
+        if (cache && version != 0) {
+            if (cache->IsValid(renderLayer, version)) {
+                cache->Composite(renderer, renderLayer);
+                stats.cachedLayers++;
+                i = end;
+                continue;
+            }
+            if (cache->BeginRedraw(renderer, renderLayer)) {
+                for (size_t k = i; k < end; ++k) {
+                    DrawCommand(commands[items[k].index], renderer, batch, stats);
+                }
+                batch.Flush(renderer);
+                cache->EndRedraw(renderer, renderLayer, version);
+                cache->Composite(renderer, renderLayer);
+                stats.layerRedraws++;
+                i = end;
+                continue;
+            }
+        }
+
+        for (size_t k = i; k < end; ++k) {
+            DrawCommand(commands[items[k].index], renderer, batch, stats);
+        }
+        batch.Flush(renderer);
+        i = end;
+    }
+
+    stats.drawCalls = batch.GetDrawCallCount();
+    stats.textureSwitches = batch.GetTextureSwitchCount();
+    stats.blendSwitches = batch.GetBlendSwitchCount();
+    return stats;
+}
+
+void RenderQueue::DrawCommand(const Command& command, Renderer* renderer, SpriteBatch& batch,
+                              FrameStats& stats) const {
+    if (command.geometry != NO_GEOMETRY) {
+        const GeometryRange& range = geometries[command.geometry];
+        batch.DrawGeometry(renderer, command.sprite, &geometryVertices[range.firstVertex],
+                           static_cast<int>(range.vertexCount), &geometryIndices[range.firstIndex],
+                           static_cast<int>(range.indexCount), command.blend);
+        stats.geometries++;
+        return;
+    }
+
+    const SDL_FColor color = {command.color.r / 255.0f, command.color.g / 255.0f,
+                              command.color.b / 255.0f, command.color.a / 255.0f};
+    batch.Draw(command.sprite, command.hasSrc ? &command.src : nullptr,
+               command.x, command.y, command.w, command.h, command.angle, color, command.blend);
+}
@@ -0,0 +1,149 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <SDL3/SDL.h>
+#include "Renderer.h"
+#include "SpriteBatch.h"
+
+class Sprite;
+class RenderTargetCache;
+
+// 渲染层（从下到上），排序键的最高字节
+enum class RenderLayer : uint8_t {
+    BACKGROUND,
+    PLAYER,
+    ENEMIES,
+    ITEMS,
+    PLAYER_BULLETS,
+    LASERS,
+    ENEMY_BULLETS,
+    HUD,
+    OVERLAY,
+    COUNT
+};
+
+/**
+ * 分层渲染队列
+ * 每次绘制提交一个 64 位排序键和一条定长命令，帧末按键做基数排序后送入 SpriteBatch：
+ *
+ *   [63..56] 层   [55..48] 混合模式   [47..32] 贴图编号   [31..16] 深度   [15..0] 保留
+ *
+ * 同层内相同混合模式、相同贴图的绘制排在一起，贴图和混合状态的切换降到最少；
+ * 基数排序是稳定的，键相同的命令保持提交顺序。层与层之间 SpriteBatch 会 Flush 一次，保证层序。
+ *
+ * 非四边形的绘制（激光三角形带、自机的判定点等）以几何命令提交，顶点和索引拷贝进队列自己的缓冲：
+ * 执行前先 Flush 已累积的四边形，同层内几何命令排在所有四边形之后，彼此保持提交顺序。
+ *
+ * 队列只引用常驻资源（Sprite），不引用任何实体：模拟线程 Begin/Submit/Close 生成一帧，
+ * Close 之后内容不再改变，渲染线程可以反复 Draw 同一帧（见 RenderExchange）。
+ * 命令和排序缓冲跨帧复用，稳定后不再分配
+ */
+class RenderQueue {
+public:
+    // 每帧统计（Draw 的返回值）
+    struct FrameStats {
+        size_t commands = 0;
+        int drawCalls = 0;
+        int textureSwitches = 0;
+        int blendSwitches = 0;
+        int geometries = 0;
+        int cachedLayers = 0;     // 直接拷贝缓存目标的层数
+        int layerRedraws = 0;     // 重画进缓存目标的层数
+    };
+
+    explicit RenderQueue(size_t reserveCommands = 16384);
+
+    // 开始新的一帧
+    void Begin();
+
+    // 提交一个四边形（参数含义同 SpriteBatch::Draw），depth 越小越先画
+    void SubmitQuad(RenderLayer layer, uint16_t depth, const Sprite* sprite, const SDL_Rect* src,
+                    float centerX, float centerY, float width, float height, float angleDeg,
+                    const SDL_Color& color, BlendMode blend);
+
+    // 提交一组三角形（顶点和索引被拷贝，索引相对于本组第一个顶点）
+    void SubmitGeometry(RenderLayer layer, uint16_t depth, const Sprite* sprite,
+                        const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount,
+                        BlendMode blend);
+
+    // 提交一个纯色矩形（按几何命令提交，同层内保持提交顺序）
+    void SubmitRect(RenderLayer layer, uint16_t depth, const SDL_FRect& rect, const SDL_Color& color);
+
+    // 把一层标记为可缓存：version 为该层内容的版本（非 0），内容变化时提交方必须换一个版本。
+    // 每帧仍需完整提交该层，渲染时版本与缓存一致就整层跳过，只拷贝一次缓存目标
+    void SetLayerCache(RenderLayer layer, uint64_t version);
+
+    // 结束本帧的提交并排序，之后到下一次 Begin 之前内容不变
+    void Close();
+
+    // 按排序结果绘制（只读，可以对同一帧重复调用）；batch 和 cache 由调用方持有，跨帧复用
+    // cache 为空时可缓存的层也直接画到屏幕
+    FrameStats Draw(Renderer* renderer, SpriteBatch& batch, RenderTargetCache* cache = nullptr) const;
+
+    size_t GetCommandCount() const { return commands.size(); }
+
+    static uint64_t MakeKey(RenderLayer layer, uint8_t blend, uint16_t textureId, uint16_t depth) {
+        return (static_cast<uint64_t>(layer) << 56) | (static_cast<uint64_t>(blend) << 48) |
+               (static_cast<uint64_t>(textureId) << 32) | (static_cast<uint64_t>(depth) << 16);
+    }
+
+private:
+    // 几何命令的混合模式字段取 COUNT，排在同层所有四边形之后
+    static constexpr uint8_t GEOMETRY_BLEND = static_cast<uint8_t>(BlendMode::COUNT);
+    static constexpr uint32_t NO_GEOMETRY = 0xFFFFFFFF;
+
+    struct Command {
+        const Sprite* sprite;
+        uint32_t geometry;          // geometries 中的下标，四边形为 NO_GEOMETRY
+        SDL_Rect src;
+        float x, y, w, h;
+        float angle;
+        SDL_Color color;
+        BlendMode blend;
+        bool hasSrc;
+    };
+
+    // 几何命令在顶点/索引缓冲中的区间
+    struct GeometryRange {
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+    };
+
+    struct SortItem {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // 贴图 -> 16 位编号（0 为无贴图），按首次出现顺序分配
+    uint16_t GetTextureId(const Sprite* sprite);
+
+    // 8 位一趟的 LSD 基数排序，所有键该字节相同的趟直接跳过
+    void SortItems();
+
+    // 绘制一条命令（四边形进批次，几何命令先 Flush 再单独绘制）
+    void DrawCommand(const Command& command, Renderer* renderer, SpriteBatch& batch, FrameStats& stats) const;
+
+    std::vector<Command> commands;
+    std::vector<SortItem> items;
+    std::vector<SortItem> scratch;
+    std::vector<GeometryRange> geometries;
+    std::vector<SDL_Vertex> geometryVertices;
+    std::vector<int> geometryIndices;
+
+    // 每层的缓存版本（0 表示不缓存）
+    std::array<uint64_t, static_cast<size_t>(RenderLayer::COUNT)> layerVersions{};
+
+    std::vector<SDL_Texture*> textureIds;
+    size_t lastTextureSlot;
+};
+
+#endif //RENDERQUEUE_H
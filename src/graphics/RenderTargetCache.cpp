@@ -0,0 +1,59 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "RenderTargetCache.h"
+
+RenderTargetCache::RenderTargetCache(int width, int height) : width(width), height(height) {
+}
+
+bool RenderTargetCache::IsValid(RenderLayer layer, uint64_t version) const {
+    const Entry& entry = entries[static_cast<size_t>(layer)];
+    if (version == 0 || entry.version != version || !entry.target) return false;
+    hitCount++;
+    return true;
+}
+
+bool RenderTargetCache::BeginRedraw(Renderer* renderer, RenderLayer layer) {
+    if (!renderer) return false;
+    Entry& entry = entries[static_cast<size_t>(layer)];
+
+    if (!entry.target) {
+        auto target = std::make_unique<Sprite>();
+        if (!target->CreateRenderTarget(width, height, *renderer)) {
+            return false;
+        }
+        entry.target = std::move(target);
+    }
+
+    SDL_Renderer* sdlRenderer = renderer->GetRenderer();
+    if (!SDL_SetRenderTarget(sdlRenderer, entry.target->GetTexture())) {
+        return false;
+    }
+    SDL_SetRenderDrawColor(sdlRenderer, 0, 0, 0, 0);
+    SDL_RenderClear(sdlRenderer);
+    return true;
+}
+
+void RenderTargetCache::EndRedraw(Renderer* renderer, RenderLayer layer, uint64_t version) {
+    if (!renderer) return;
+    SDL_SetRenderTarget(renderer->GetRenderer(), nullptr);
+    entries[static_cast<size_t>(layer)].version = version;
+    redrawCount++;
+}
+
+void RenderTargetCache::Composite(Renderer* renderer, RenderLayer layer) const {
+    const Entry& entry = entries[static_cast<size_t>(layer)];
+    if (!renderer || !entry.target) return;
+
+    // 透明底上按普通混合画出的内容颜色已经乘过透明度，拷贝时按预乘混合，半透明边缘不会发暗
+    SDL_Texture* texture = entry.target->GetTexture();
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    SDL_RenderTexture(renderer->GetRenderer(), texture, nullptr, nullptr);
+}
+
+void RenderTargetCache::Invalidate() {
+    for (Entry& entry : entries) {
+        entry.version = 0;
+    }
+}
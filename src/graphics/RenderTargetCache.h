@@ -0,0 +1,58 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef RENDERTARGETCACHE_H
+#define RENDERTARGETCACHE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include "Renderer.h"
+#include "RenderQueue.h"
+#include "Sprite.h"
+
+/**
+ * 渲染目标缓存（渲染线程使用）
+ * 内容很少变化的层（背景、HUD）画进一张与窗口同尺寸的目标贴图，之后每帧只拷贝一次；
+ * 层内容由提交方给出的版本号标识（见 RenderQueue::SetLayerCache），版本变化时才重画。
+ * 目标贴图在第一次需要时创建；渲染设备重置后贴图内容丢失，调用 Invalidate 全部重画
+ */
+class RenderTargetCache {
+public:
+    RenderTargetCache(int width, int height);
+
+    // 缓存的内容是否就是这个版本
+    bool IsValid(RenderLayer layer, uint64_t version) const;
+
+    // 开始重画：绑定该层的目标并清成透明；失败时返回 false，调用方直接画到屏幕
+    bool BeginRedraw(Renderer* renderer, RenderLayer layer);
+
+    // 结束重画：恢复默认目标，记录版本
+    void EndRedraw(Renderer* renderer, RenderLayer layer, uint64_t version);
+
+    // 把该层的目标整张拷贝到屏幕
+    void Composite(Renderer* renderer, RenderLayer layer) const;
+
+    // 所有层标记为失效（设备重置、窗口尺寸变化）
+    void Invalidate();
+
+    // 统计
+    uint64_t GetRedrawCount() const { return redrawCount; }
+    uint64_t GetHitCount() const { return hitCount; }
+
+private:
+    struct Entry {
+        std::unique_ptr<Sprite> target;
+        uint64_t version = 0;    // 0 表示无效
+    };
+
+    std::array<Entry, static_cast<size_t>(RenderLayer::COUNT)> entries;
+    int width;
+    int height;
+
+    uint64_t redrawCount = 0;
+    mutable uint64_t hitCount = 0;
+};
+
+#endif //RENDERTARGETCACHE_H
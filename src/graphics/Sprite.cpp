@@ -3,6 +3,7 @@
 //
 
 #include "Sprite.h"
+#include "../gamecore/FrameProfiler.h"
 
 #include <iostream>
 #include <SDL3_image/SDL_image.h>
@@ -21,7 +22,10 @@ bool Sprite::LoadFromFile(const std::string& filePath, Renderer& renderer) {
     Free();
     
     // 直接加载为Texture
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    double loadBegin = profiler.Now();
     texture = IMG_LoadTexture(renderer.GetRenderer(), filePath.c_str());
+    profiler.Mark(FrameMarker::TEXTURE_LOAD, profiler.Now() - loadBegin, filePath.c_str());
     if (!texture) {
         std::cerr << "Unable to load texture from " << filePath << "! Error: " << SDL_GetError() << std::endl;
         return false;
@@ -35,6 +39,42 @@ bool Sprite::LoadFromFile(const std::string& filePath, Renderer& renderer) {
     return true;
 }
 
+bool Sprite::CreateFromSurface(SDL_Surface* surface, Renderer& renderer) {
+    Free();
+    if (!surface) return false;
+
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    double createBegin = profiler.Now();
+    texture = SDL_CreateTextureFromSurface(renderer.GetRenderer(), surface);
+    profiler.Mark(FrameMarker::TEXTURE_LOAD, profiler.Now() - createBegin, "surface");
+    if (!texture) {
+        std::cerr << "Unable to create texture from surface! Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    width = surface->w;
+    height = surface->h;
+    isLoaded = true;
+    return true;
+}
+
+bool Sprite::CreateRenderTarget(int targetWidth, int targetHeight, Renderer& renderer) {
+    Free();
+
+    texture = SDL_CreateTexture(renderer.GetRenderer(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                targetWidth, targetHeight);
+    if (!texture) {
+        std::cerr << "Unable to create render target " << targetWidth << "x" << targetHeight
+                  << "! Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    width = targetWidth;
+    height = targetHeight;
+    isLoaded = true;
+    return true;
+}
+
 void Sprite::Free() {
     if (texture) {
         SDL_DestroyTexture(texture);
@@ -76,6 +116,21 @@ void Sprite::Render(Renderer &renderer, int x, int y, int renderWidth, int rende
     Render(renderer, x, y, renderWidth, renderHeight, src ? &srcF : nullptr);
 }
 
+void Sprite::RenderRotated(Renderer& renderer, const SDL_FRect& dest, const SDL_Rect* src, double angleDeg) const {
+    if (!isLoaded || !texture) {
+        return;
+    }
+
+    SDL_FRect srcF {
+        src ? static_cast<float>(src->x) : 0.0f,
+        src ? static_cast<float>(src->y) : 0.0f,
+        src ? static_cast<float>(src->w) : 0.0f,
+        src ? static_cast<float>(src->h) : 0.0f
+    };
+    // center 传空表示绕 dest 中心旋转
+    SDL_RenderTextureRotated(renderer.GetRenderer(), texture, src ? &srcF : nullptr, &dest, angleDeg, nullptr, SDL_FLIP_NONE);
+}
+
 void Sprite::RenderFrame(Renderer& renderer, int frameIndex, int frameWidth, int frameHeight,
                          int x, int y, float scale, int columns) const {
     if (!isLoaded || !texture || frameWidth <= 0 || frameHeight <= 0) return;
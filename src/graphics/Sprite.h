@@ -17,6 +17,8 @@ public:
     
     // 纹理管理
     bool LoadFromFile(const std::string& filePath, Renderer& renderer);
+    bool CreateFromSurface(SDL_Surface* surface, Renderer& renderer);        // 不接管 surface
+    bool CreateRenderTarget(int targetWidth, int targetHeight, Renderer& renderer);  // 可作为渲染目标的空白贴图
     void Free();
     
     // 渲染功能
@@ -24,6 +26,8 @@ public:
     void Render(Renderer &renderer, int x, int y, int width = 0, int height = 0, const SDL_FRect *src = nullptr) const;
     // 便捷重载：接受 SDL_Rect，内部转换为 SDL_FRect
     void Render(Renderer &renderer, int x, int y, int width, int height, const SDL_Rect *src) const;
+    // 绕目标矩形中心旋转渲染（角度为度，顺时针）
+    void RenderRotated(Renderer& renderer, const SDL_FRect& dest, const SDL_Rect* src, double angleDeg) const;
     // 按帧索引渲染精灵表（frameWidth/frameHeight 为帧尺寸；columns 为每行帧数，0 表示按纹理宽自动计算）
     void RenderFrame(Renderer& renderer, int frameIndex, int frameWidth, int frameHeight,
                      int x, int y, float scale = 1.0f, int columns = 0) const;
@@ -33,6 +37,7 @@ public:
     bool IsLoaded() const;
     int GetWidth() const;
     int GetHeight() const;
+    SDL_Texture* GetTexture() const { return texture; }
     
 private:
     SDL_Texture* texture;
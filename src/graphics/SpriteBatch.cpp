@@ -0,0 +1,156 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "SpriteBatch.h"
+#include "Sprite.h"
+
+#include <cmath>
+
+SpriteBatch::SpriteBatch()
+    : lastBucket{}, drawCalls(0), textureSwitches(0), blendSwitches(0), quadCount(0),
+      lastTexture(nullptr), lastBlend(-1) {
+}
+
+void SpriteBatch::Begin() {
+    for (auto& list : buckets) {
+        for (Bucket& bucket : list) {
+            bucket.vertices.clear();
+        }
+    }
+    drawCalls = 0;
+    textureSwitches = 0;
+    blendSwitches = 0;
+    quadCount = 0;
+    lastTexture = nullptr;
+    lastBlend = -1;
+}
+
+SpriteBatch::Bucket& SpriteBatch::FindBucket(SDL_Texture* texture, BlendMode blend) {
+    const size_t mode = static_cast<size_t>(blend);
+    std::vector<Bucket>& list = buckets[mode];
+
+    // 连续绘制同一贴图是常态，先查上一次命中的桶
+    if (lastBucket[mode] < list.size() && list[lastBucket[mode]].texture == texture) {
+        return list[lastBucket[mode]];
+    }
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (list[i].texture == texture) {
+            lastBucket[mode] = i;
+            return list[i];
+        }
+    }
+
+    list.push_back(Bucket{texture, {}});
+    lastBucket[mode] = list.size() - 1;
+    return list.back();
+}
+
+void SpriteBatch::Draw(const Sprite* sprite, const SDL_Rect* src, float centerX, float centerY,
+                       float width, float height, double angleDeg, const SDL_FColor& color, BlendMode blend) {
+    if (blend >= BlendMode::COUNT) return;
+
+    SDL_Texture* texture = (sprite && sprite->IsLoaded()) ? sprite->GetTexture() : nullptr;
+    float u0 = 0.0f, u1 = 1.0f, v0 = 0.0f, v1 = 1.0f;
+    if (texture && src && sprite->GetWidth() > 0 && sprite->GetHeight() > 0) {
+        const float invWidth = 1.0f / static_cast<float>(sprite->GetWidth());
+        const float invHeight = 1.0f / static_cast<float>(sprite->GetHeight());
+        u0 = static_cast<float>(src->x) * invWidth;
+        u1 = static_cast<float>(src->x + src->w) * invWidth;
+        v0 = static_cast<float>(src->y) * invHeight;
+        v1 = static_cast<float>(src->y + src->h) * invHeight;
+    }
+
+    // 四个角相对中心的偏移：左上、右上、左下、右下
+    const float hw = width * 0.5f;
+    const float hh = height * 0.5f;
+    float ox[4] = {-hw, hw, -hw, hw};
+    float oy[4] = {-hh, -hh, hh, hh};
+    if (angleDeg != 0.0) {
+        // 屏幕坐标 y 向下，标准旋转矩阵即为顺时针（与 SDL_RenderTextureRotated 一致）
+        const float radians = static_cast<float>(angleDeg) * (3.14159265f / 180.0f);
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+        for (int i = 0; i < 4; ++i) {
+            float rx = ox[i] * c - oy[i] * s;
+            oy[i] = ox[i] * s + oy[i] * c;
+            ox[i] = rx;
+        }
+    }
+
+    std::vector<SDL_Vertex>& vertices = FindBucket(texture, blend).vertices;
+    vertices.push_back(SDL_Vertex{{centerX + ox[0], centerY + oy[0]}, color, {u0, v0}});
+    vertices.push_back(SDL_Vertex{{centerX + ox[1], centerY + oy[1]}, color, {u1, v0}});
+    vertices.push_back(SDL_Vertex{{centerX + ox[2], centerY + oy[2]}, color, {u0, v1}});
+    vertices.push_back(SDL_Vertex{{centerX + ox[3], centerY + oy[3]}, color, {u1, v1}});
+    quadCount++;
+}
+
+int SpriteBatch::Flush(Renderer* renderer) {
+    if (!renderer) return 0;
+    SDL_Renderer* sdlRenderer = renderer->GetRenderer();
+
+    int calls = 0;
+    for (size_t mode = 0; mode < buckets.size(); ++mode) {
+        for (Bucket& bucket : buckets[mode]) {
+            if (bucket.vertices.empty()) continue;
+
+            const size_t quads = bucket.vertices.size() / 4;
+            if (indices.size() < quads * 6) {
+                size_t first = indices.size() / 6;
+                indices.resize(quads * 6);
+                for (size_t q = first; q < quads; ++q) {
+                    const int base = static_cast<int>(q * 4);
+                    int* index = &indices[q * 6];
+                    index[0] = base;
+                    index[1] = base + 1;
+                    index[2] = base + 2;
+                    index[3] = base + 2;
+                    index[4] = base + 1;
+                    index[5] = base + 3;
+                }
+            }
+
+            Submit(sdlRenderer, bucket.texture, static_cast<int>(mode), bucket.vertices.data(),
+                   static_cast<int>(bucket.vertices.size()), indices.data(), static_cast<int>(quads * 6));
+            bucket.vertices.clear();
+            calls++;
+        }
+    }
+
+    return calls;
+}
+
+void SpriteBatch::DrawGeometry(Renderer* renderer, const Sprite* sprite, const SDL_Vertex* vertices, int vertexCount,
+                               const int* indexData, int indexCount, BlendMode blend) {
+    if (!renderer || blend >= BlendMode::COUNT || vertexCount <= 0 || indexCount <= 0) return;
+
+    // 层内顺序：之前累积的四边形先画
+    Flush(renderer);
+    SDL_Texture* texture = (sprite && sprite->IsLoaded()) ? sprite->GetTexture() : nullptr;
+    Submit(renderer->GetRenderer(), texture, static_cast<int>(blend), vertices, vertexCount, indexData, indexCount);
+}
+
+void SpriteBatch::Submit(SDL_Renderer* sdlRenderer, SDL_Texture* texture, int mode,
+                         const SDL_Vertex* vertices, int vertexCount, const int* indexData, int indexCount) {
+    const SDL_BlendMode sdlBlend = mode == static_cast<int>(BlendMode::ADDITIVE) ? SDL_BLENDMODE_ADD
+                                                                                  : SDL_BLENDMODE_BLEND;
+    // 混合模式是贴图状态，每次绘制调用只设置一次
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, sdlBlend);
+    } else {
+        SDL_SetRenderDrawBlendMode(sdlRenderer, sdlBlend);
+    }
+    SDL_RenderGeometry(sdlRenderer, texture, vertices, vertexCount, indexData, indexCount);
+
+    drawCalls++;
+    if (drawCalls > 1 && texture != lastTexture) textureSwitches++;
+    if (lastBlend >= 0 && lastBlend != mode) blendSwitches++;
+    lastTexture = texture;
+    lastBlend = mode;
+
+    // 贴图在其它地方（单独绘制）仍按普通混合使用，叠加绘制完后恢复
+    if (texture && sdlBlend != SDL_BLENDMODE_BLEND) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+}
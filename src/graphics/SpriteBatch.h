@@ -0,0 +1,85 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <SDL3/SDL.h>
+#include "Renderer.h"
+
+class Sprite;
+
+// 混合模式：每种模式单独成桶，同一桶内的所有四边形一次提交
+enum class BlendMode : uint8_t {
+    ALPHA,      // 普通透明混合
+    ADDITIVE,   // 叠加（发光弹、激光、特效）
+    COUNT
+};
+
+/**
+ * 四边形合批渲染器
+ * 顶点自带颜色（SDL_Vertex::color），每个实例的色调和透明度写在顶点里，
+ * 不需要改贴图的 color/alpha mod，因此整屏子弹渐隐也不会打断合批。
+ *
+ * 四边形按（混合模式, 贴图）分桶累积，Flush 时先画所有 ALPHA 桶再画 ADDITIVE 桶，
+ * 每个桶一次 SDL_RenderGeometry。顶点和索引缓冲跨帧复用，稳定后不再分配
+ */
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    // 开始新的一帧：清空所有桶（保留容量）
+    void Begin();
+
+    // 追加一个四边形：中心 (centerX, centerY)，尺寸 width x height，绕中心顺时针旋转 angleDeg 度
+    // src 为贴图中的裁切区域（为空表示整张贴图）；sprite 为空或未加载时画纯色四边形
+    void Draw(const Sprite* sprite, const SDL_Rect* src, float centerX, float centerY,
+              float width, float height, double angleDeg, const SDL_FColor& color, BlendMode blend);
+
+    // 提交所有桶并清空，返回本次的绘制调用数（一帧内可多次 Flush 以保证层间顺序）
+    int Flush(Renderer* renderer);
+
+    // 先提交已累积的桶，再单独画一组三角形（激光三角形带等不是四边形的绘制），计入统计
+    void DrawGeometry(Renderer* renderer, const Sprite* sprite, const SDL_Vertex* vertices, int vertexCount,
+                      const int* indexData, int indexCount, BlendMode blend);
+
+    // 统计（Begin 时清零）：相邻两次绘制调用之间贴图/混合模式发生变化的次数
+    int GetDrawCallCount() const { return drawCalls; }
+    int GetTextureSwitchCount() const { return textureSwitches; }
+    int GetBlendSwitchCount() const { return blendSwitches; }
+    size_t GetQuadCount() const { return quadCount; }
+
+private:
+    struct Bucket {
+        SDL_Texture* texture;
+        std::vector<SDL_Vertex> vertices;
+    };
+
+    Bucket& FindBucket(SDL_Texture* texture, BlendMode blend);
+
+    // 一次绘制调用：设置混合模式、提交、记录切换
+    void Submit(SDL_Renderer* sdlRenderer, SDL_Texture* texture, int mode,
+                const SDL_Vertex* vertices, int vertexCount, const int* indexData, int indexCount);
+
+    // 每种混合模式的桶列表（贴图种类很少，线性查找）
+    std::array<std::vector<Bucket>, static_cast<size_t>(BlendMode::COUNT)> buckets;
+    std::array<size_t, static_cast<size_t>(BlendMode::COUNT)> lastBucket;
+
+    // 所有桶共用的索引模式 (0,1,2, 2,1,3) + 4k，按最大桶大小增长
+    std::vector<int> indices;
+
+    int drawCalls;
+    int textureSwitches;
+    int blendSwitches;
+    size_t quadCount;
+
+    // 本帧上一次绘制调用的状态（跨 Flush 保留，用于统计切换）
+    SDL_Texture* lastTexture;
+    int lastBlend;
+};
+
+#endif //SPRITEBATCH_H
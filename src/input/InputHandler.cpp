@@ -3,35 +3,456 @@
 //
 
 #include "InputHandler.h"
+#include "../gamecore/Logger.h"
+#include "../gamecore/Metrics.h"
+#include "../json.hpp"
 
-InputHandler::InputHandler() {
-    currentKeyStates = nullptr;
-    memset(previousKeyStates, 0, sizeof(previousKeyStates));
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace {
+    constexpr const char* ACTION_NAMES[] = {"LEFT", "RIGHT", "UP", "DOWN", "SHOOT", "BOMB", "FOCUS", "PAUSE"};
+    static_assert(std::size(ACTION_NAMES) == static_cast<size_t>(InputAction::COUNT));
+
+    // 自机动作的位必须与 PlayerInput 一致，SamplePlayerInput 才能直接截取
+    static_assert(ActionBit(InputAction::LEFT) == PlayerInput::LEFT);
+    static_assert(ActionBit(InputAction::RIGHT) == PlayerInput::RIGHT);
+    static_assert(ActionBit(InputAction::UP) == PlayerInput::UP);
+    static_assert(ActionBit(InputAction::DOWN) == PlayerInput::DOWN);
+    static_assert(ActionBit(InputAction::SHOOT) == PlayerInput::SHOOT);
+    static_assert(ActionBit(InputAction::BOMB) == PlayerInput::BOMB);
+    static_assert(ActionBit(InputAction::FOCUS) == PlayerInput::FOCUS);
+    static_assert(static_cast<int>(InputAction::COUNT) <= 16, "InputActionBits is 16 bits");
+    static_assert((InputHandler::EVENT_CAPACITY & (InputHandler::EVENT_CAPACITY - 1)) == 0);
+    static_assert(SDL_GAMEPAD_BUTTON_COUNT <= 32, "PadState::buttons is 32 bits");
+
+    // 8 方向：分量超过摇杆偏移量的 sin(22.5°) 倍时该方向成立，每个方向正好占 45°
+    constexpr float EIGHT_WAY_THRESHOLD = 0.38268343f;
+    constexpr float AXIS_MAX = 32767.0f;
+
+    uint32_t ButtonBit(int button) {
+        return 1u << static_cast<unsigned>(button);
+    }
+}
+
+InputHandler::InputHandler()
+    : eventWrite(0),
+      eventRead(0),
+      stickDeadzone(0.3f) {
+    memset(keyStates, 0, sizeof(keyStates));
+    memset(pressedThisTick, 0, sizeof(pressedThisTick));
+    memset(releasedThisTick, 0, sizeof(releasedThisTick));
+    openGamepads.fill(nullptr);
+    actionBits.fill(0);
+    previousActionBits.fill(0);
+    ResetBindings();
+
+    MetricsRegistry& metrics = MetricsRegistry::Instance();
+    latencyMetric = metrics.AddLatencyHistogram("input_latency_ms");
+    droppedEventMetric = metrics.AddCounter("input_events_dropped");
+}
+
+InputHandler::~InputHandler() {
+    // 与打开时一样在主线程（InputHandler 由主线程在 SDL_Quit 之前释放）
+    for (SDL_Gamepad*& gamepad : openGamepads) {
+        if (gamepad) {
+            SDL_CloseGamepad(gamepad);
+            gamepad = nullptr;
+        }
+    }
+}
+
+void InputHandler::ResetBindings() {
+    for (auto& slots : bindings) {
+        slots.fill(SDL_SCANCODE_UNKNOWN);
+    }
+    for (auto& slots : padBindings) {
+        slots.fill(SDL_GAMEPAD_BUTTON_INVALID);
+    }
+
+    // 默认键位（东方：方向键移动，Z 射击，X 炸弹，Shift 低速）
+    bindings[static_cast<int>(InputAction::LEFT)][0] = SDL_SCANCODE_LEFT;
+    bindings[static_cast<int>(InputAction::RIGHT)][0] = SDL_SCANCODE_RIGHT;
+    bindings[static_cast<int>(InputAction::UP)][0] = SDL_SCANCODE_UP;
+    bindings[static_cast<int>(InputAction::DOWN)][0] = SDL_SCANCODE_DOWN;
+    bindings[static_cast<int>(InputAction::SHOOT)][0] = SDL_SCANCODE_Z;
+    bindings[static_cast<int>(InputAction::BOMB)][0] = SDL_SCANCODE_X;
+    bindings[static_cast<int>(InputAction::FOCUS)][0] = SDL_SCANCODE_LSHIFT;
+    bindings[static_cast<int>(InputAction::PAUSE)][0] = SDL_SCANCODE_P;
+
+    // 默认手柄键位：十字键移动（左摇杆另外换算），下键射击，右键炸弹，肩键低速
+    padBindings[static_cast<int>(InputAction::LEFT)][0] = SDL_GAMEPAD_BUTTON_DPAD_LEFT;
+    padBindings[static_cast<int>(InputAction::RIGHT)][0] = SDL_GAMEPAD_BUTTON_DPAD_RIGHT;
+    padBindings[static_cast<int>(InputAction::UP)][0] = SDL_GAMEPAD_BUTTON_DPAD_UP;
+    padBindings[static_cast<int>(InputAction::DOWN)][0] = SDL_GAMEPAD_BUTTON_DPAD_DOWN;
+    padBindings[static_cast<int>(InputAction::SHOOT)][0] = SDL_GAMEPAD_BUTTON_SOUTH;
+    padBindings[static_cast<int>(InputAction::BOMB)][0] = SDL_GAMEPAD_BUTTON_EAST;
+    padBindings[static_cast<int>(InputAction::FOCUS)][0] = SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER;
+    padBindings[static_cast<int>(InputAction::FOCUS)][1] = SDL_GAMEPAD_BUTTON_LEFT_SHOULDER;
+    padBindings[static_cast<int>(InputAction::PAUSE)][0] = SDL_GAMEPAD_BUTTON_START;
+}
+
+bool InputHandler::PushEvent(const InputEvent& event) {
+    const uint32_t write = eventWrite.load(std::memory_order_relaxed);
+    if (write - eventRead.load(std::memory_order_acquire) >= EVENT_CAPACITY) {
+        MetricsRegistry::Instance().Increment(droppedEventMetric);
+        return false;
+    }
+    events[write & (EVENT_CAPACITY - 1)] = event;
+    eventWrite.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputHandler::PushKeyEvent(SDL_Scancode scancode, bool down, Uint64 timestampNS) {
+    if (scancode <= SDL_SCANCODE_UNKNOWN || scancode >= SDL_SCANCODE_COUNT) return false;
+    return PushEvent(InputEvent{timestampNS, 0, EventType::KEY, down, static_cast<uint16_t>(scancode), 0});
+}
+
+bool InputHandler::PushGamepadAdded(SDL_JoystickID device, Uint64 timestampNS) {
+    return PushEvent(InputEvent{timestampNS, device, EventType::PAD_ADDED, false, 0, 0});
+}
+
+bool InputHandler::PushGamepadRemoved(SDL_JoystickID device, Uint64 timestampNS) {
+    return PushEvent(InputEvent{timestampNS, device, EventType::PAD_REMOVED, false, 0, 0});
+}
+
+bool InputHandler::PushGamepadButton(SDL_JoystickID device, SDL_GamepadButton button, bool down, Uint64 timestampNS) {
+    if (button <= SDL_GAMEPAD_BUTTON_INVALID || button >= SDL_GAMEPAD_BUTTON_COUNT) return false;
+    return PushEvent(InputEvent{timestampNS, device, EventType::PAD_BUTTON, down, static_cast<uint16_t>(button), 0});
+}
+
+bool InputHandler::PushGamepadAxis(SDL_JoystickID device, SDL_GamepadAxis axis, Sint16 value, Uint64 timestampNS) {
+    if (axis <= SDL_GAMEPAD_AXIS_INVALID || axis >= SDL_GAMEPAD_AXIS_COUNT) return false;
+    return PushEvent(InputEvent{timestampNS, device, EventType::PAD_AXIS, false, static_cast<uint16_t>(axis), value});
+}
+
+bool InputHandler::HandleGamepadEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_EVENT_GAMEPAD_ADDED: {
+            // 玩家槽位已满时不打开，也不入队（模拟线程按同样的顺序分配槽位）
+            auto slot = std::find(openGamepads.begin(), openGamepads.end(), nullptr);
+            if (slot == openGamepads.end()) {
+                LOG_INFO("InputHandler: ignoring gamepad {}, all {} player slots in use", event.gdevice.which,
+                         MAX_PLAYERS);
+                return true;
+            }
+            SDL_Gamepad* gamepad = SDL_OpenGamepad(event.gdevice.which);
+            if (!gamepad) {
+                LOG_WARN("InputHandler: failed to open gamepad {}: {}", event.gdevice.which, SDL_GetError());
+                return true;
+            }
+            *slot = gamepad;
+            const char* name = SDL_GetGamepadName(gamepad);
+            LOG_INFO("InputHandler: gamepad {} connected ({})", event.gdevice.which, name ? name : "unknown");
+            PushGamepadAdded(event.gdevice.which, event.gdevice.timestamp);
+            return true;
+        }
+        case SDL_EVENT_GAMEPAD_REMOVED:
+            for (SDL_Gamepad*& gamepad : openGamepads) {
+                if (gamepad && SDL_GetGamepadID(gamepad) == event.gdevice.which) {
+                    SDL_CloseGamepad(gamepad);
+                    gamepad = nullptr;
+                    LOG_INFO("InputHandler: gamepad {} disconnected", event.gdevice.which);
+                    PushGamepadRemoved(event.gdevice.which, event.gdevice.timestamp);
+                }
+            }
+            return true;
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+            PushGamepadButton(event.gbutton.which, static_cast<SDL_GamepadButton>(event.gbutton.button),
+                              event.gbutton.down, event.gbutton.timestamp);
+            return true;
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+            PushGamepadAxis(event.gaxis.which, static_cast<SDL_GamepadAxis>(event.gaxis.axis), event.gaxis.value,
+                            event.gaxis.timestamp);
+            return true;
+        default:
+            return false;
+    }
 }
 
 void InputHandler::Update() {
-    // 保存当前状态到历史状态
-    if (currentKeyStates) {
-        memcpy(previousKeyStates, currentKeyStates, sizeof(previousKeyStates));
+    memset(pressedThisTick, 0, sizeof(pressedThisTick));
+    memset(releasedThisTick, 0, sizeof(releasedThisTick));
+    for (PadState& pad : pads) {
+        pad.pressedThisTick = 0;
+    }
+
+    // 按到达顺序取出事件：同一 tick 内按下又松开的键记为按下过（短按不丢）
+    const uint32_t write = eventWrite.load(std::memory_order_acquire);
+    uint32_t read = eventRead.load(std::memory_order_relaxed);
+    if (read != write) {
+        const Uint64 now = SDL_GetTicksNS();
+        for (; read != write; ++read) {
+            ApplyEvent(events[read & (EVENT_CAPACITY - 1)], now);
+        }
+        eventRead.store(read, std::memory_order_release);
+    }
+
+    // 按缓存的绑定解析动作位：键盘和第 1 个手柄合并为 1P
+    previousActionBits = actionBits;
+    for (int player = 0; player < MAX_PLAYERS; ++player) {
+        actionBits[player] = pads[player].connected ? ResolvePad(pads[player]) : 0;
+    }
+    actionBits[0] |= ResolveKeyboard();
+}
+
+void InputHandler::ApplyEvent(const InputEvent& event, Uint64 now) {
+    switch (event.type) {
+        case EventType::KEY:
+            if (event.down) {
+                if (!keyStates[event.code]) {
+                    pressedThisTick[event.code] = 1;
+                    RecordLatency(event.timestamp, now);
+                }
+                keyStates[event.code] = 1;
+            } else {
+                if (keyStates[event.code]) {
+                    releasedThisTick[event.code] = 1;
+                }
+                keyStates[event.code] = 0;
+            }
+            break;
+
+        case EventType::PAD_ADDED: {
+            if (FindPad(event.device) >= 0) break;
+            auto slot = std::find_if(pads.begin(), pads.end(), [](const PadState& pad) { return !pad.connected; });
+            if (slot == pads.end()) break;
+            *slot = PadState{};
+            slot->connected = true;
+            slot->device = event.device;
+            break;
+        }
+
+        case EventType::PAD_REMOVED: {
+            int slot = FindPad(event.device);
+            if (slot >= 0) {
+                pads[slot] = PadState{};
+            }
+            break;
+        }
+
+        case EventType::PAD_BUTTON: {
+            int slot = FindPad(event.device);
+            if (slot < 0) break;
+            PadState& pad = pads[slot];
+            const uint32_t bit = ButtonBit(event.code);
+            if (event.down) {
+                if (!(pad.buttons & bit)) {
+                    pad.pressedThisTick |= bit;
+                    RecordLatency(event.timestamp, now);
+                }
+                pad.buttons |= bit;
+            } else {
+                pad.buttons &= ~bit;
+            }
+            break;
+        }
+
+        case EventType::PAD_AXIS: {
+            // 轴只保留最新值，死区和方向在 tick 末尾统一换算
+            int slot = FindPad(event.device);
+            if (slot >= 0) {
+                pads[slot].axes[event.code] = event.value;
+            }
+            break;
+        }
     }
-    
-    // 获取最新的键盘状态
-    currentKeyStates = SDL_GetKeyboardState(nullptr);
+}
+
+void InputHandler::RecordLatency(Uint64 timestamp, Uint64 now) {
+    MetricsRegistry::Instance().Record(latencyMetric, now > timestamp ?
+                                       static_cast<double>(now - timestamp) / 1000000.0 : 0.0);
+}
+
+int InputHandler::FindPad(SDL_JoystickID device) const {
+    for (int slot = 0; slot < MAX_PLAYERS; ++slot) {
+        if (pads[slot].connected && pads[slot].device == device) return slot;
+    }
+    return -1;
+}
+
+InputActionBits InputHandler::ResolveKeyboard() const {
+    InputActionBits bits = 0;
+    for (int action = 0; action < ACTION_COUNT; ++action) {
+        for (SDL_Scancode scancode : bindings[action]) {
+            if (scancode != SDL_SCANCODE_UNKNOWN && IsKeyPressed(scancode)) {
+                bits |= static_cast<InputActionBits>(1u << action);
+                break;
+            }
+        }
+    }
+    return bits;
+}
+
+InputActionBits InputHandler::ResolvePad(const PadState& pad) const {
+    InputActionBits bits = 0;
+    const uint32_t buttons = pad.buttons | pad.pressedThisTick;
+    for (int action = 0; action < ACTION_COUNT; ++action) {
+        for (SDL_GamepadButton button : padBindings[action]) {
+            if (button != SDL_GAMEPAD_BUTTON_INVALID && (buttons & ButtonBit(button))) {
+                bits |= static_cast<InputActionBits>(1u << action);
+                break;
+            }
+        }
+    }
+
+    // 左摇杆：径向死区内不动，出死区后按角度取 8 方向之一（SDL 的 Y 轴向下为正）
+    const float x = pad.axes[SDL_GAMEPAD_AXIS_LEFTX] / AXIS_MAX;
+    const float y = pad.axes[SDL_GAMEPAD_AXIS_LEFTY] / AXIS_MAX;
+    const float magnitude = std::sqrt(x * x + y * y);
+    if (magnitude > stickDeadzone) {
+        const float threshold = magnitude * EIGHT_WAY_THRESHOLD;
+        if (x < -threshold) bits |= ActionBit(InputAction::LEFT);
+        if (x > threshold) bits |= ActionBit(InputAction::RIGHT);
+        if (y < -threshold) bits |= ActionBit(InputAction::UP);
+        if (y > threshold) bits |= ActionBit(InputAction::DOWN);
+    }
+    return bits;
+}
+
+bool InputHandler::LoadBindings(const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        LOG_INFO("InputHandler: no binding file {}, using default keys", filePath);
+        return false;
+    }
+
+    json j;
+    try {
+        file >> j;
+    } catch (const json::parse_error& e) {
+        LOG_WARN("InputHandler: JSON parse error: {}", e.what());
+        return false;
+    }
+    if (!j.is_object()) {
+        LOG_WARN("InputHandler: binding file must be an object: {}", filePath);
+        return false;
+    }
+
+    // 读取一组绑定：单个名字或名字数组；一个有效名字都没有时保留默认绑定，避免配置写错导致无法操作
+    auto readSlots = [&filePath](const json& section, auto parse, auto invalid, auto& target) {
+        for (auto it = section.begin(); it != section.end(); ++it) {
+            int action = 0;
+            while (action < ACTION_COUNT && it.key() != ACTION_NAMES[action]) {
+                ++action;
+            }
+            if (action == ACTION_COUNT) {
+                LOG_WARN("InputHandler: unknown action '{}' in {}", it.key(), filePath);
+                continue;
+            }
+
+            auto slots = target[action];
+            slots.fill(invalid);
+            json names = it->is_array() ? *it : json::array({*it});
+            int slot = 0;
+            for (const json& nameValue : names) {
+                if (!nameValue.is_string()) continue;
+                const std::string name = nameValue.get<std::string>();
+                auto code = parse(name.c_str());
+                if (code == invalid) {
+                    LOG_WARN("InputHandler: unknown key '{}' for {}", name, ACTION_NAMES[action]);
+                    continue;
+                }
+                if (slot >= MAX_BINDINGS) {
+                    LOG_WARN("InputHandler: {} has more than {} keys, extra ignored", ACTION_NAMES[action],
+                             MAX_BINDINGS);
+                    break;
+                }
+                slots[slot++] = code;
+            }
+            if (slot > 0) {
+                target[action] = slots;
+            }
+        }
+    };
+
+    json keyboard = j;
+    keyboard.erase("GAMEPAD");
+    keyboard.erase("STICK_DEADZONE");
+    readSlots(keyboard, SDL_GetScancodeFromName, SDL_SCANCODE_UNKNOWN, bindings);
+
+    auto gamepad = j.find("GAMEPAD");
+    if (gamepad != j.end() && gamepad->is_object()) {
+        readSlots(*gamepad, SDL_GetGamepadButtonFromString, SDL_GAMEPAD_BUTTON_INVALID, padBindings);
+    }
+
+    auto deadzone = j.find("STICK_DEADZONE");
+    if (deadzone != j.end() && deadzone->is_number()) {
+        SetStickDeadzone(deadzone->get<float>());
+    }
+    return true;
+}
+
+void InputHandler::SetBinding(InputAction action, int slot, SDL_Scancode scancode) {
+    if (action >= InputAction::COUNT || slot < 0 || slot >= MAX_BINDINGS) return;
+    bindings[static_cast<int>(action)][slot] = scancode;
+}
+
+SDL_Scancode InputHandler::GetBinding(InputAction action, int slot) const {
+    if (action >= InputAction::COUNT || slot < 0 || slot >= MAX_BINDINGS) return SDL_SCANCODE_UNKNOWN;
+    return bindings[static_cast<int>(action)][slot];
+}
+
+void InputHandler::SetGamepadBinding(InputAction action, int slot, SDL_GamepadButton button) {
+    if (action >= InputAction::COUNT || slot < 0 || slot >= MAX_BINDINGS) return;
+    padBindings[static_cast<int>(action)][slot] = button;
+}
+
+SDL_GamepadButton InputHandler::GetGamepadBinding(InputAction action, int slot) const {
+    if (action >= InputAction::COUNT || slot < 0 || slot >= MAX_BINDINGS) return SDL_GAMEPAD_BUTTON_INVALID;
+    return padBindings[static_cast<int>(action)][slot];
+}
+
+void InputHandler::SetStickDeadzone(float deadzone) {
+    stickDeadzone = std::clamp(deadzone, 0.0f, 0.95f);
+}
+
+const char* InputHandler::GetActionName(InputAction action) {
+    return action < InputAction::COUNT ? ACTION_NAMES[static_cast<int>(action)] : "UNKNOWN";
+}
+
+InputActionBits InputHandler::GetActionBits(int player) const {
+    return (player >= 0 && player < MAX_PLAYERS) ? actionBits[player] : 0;
+}
+
+bool InputHandler::IsActionJustPressed(InputAction action, int player) const {
+    if (player < 0 || player >= MAX_PLAYERS) return false;
+    return (actionBits[player] & ~previousActionBits[player] & ActionBit(action)) != 0;
+}
+
+bool InputHandler::HasGamepad(int player) const {
+    return player >= 0 && player < MAX_PLAYERS && pads[player].connected;
+}
+
+// 短按（本 tick 内按下又松开）在这一 tick 算按下、刚按下，不算刚释放
+bool InputHandler::IsKeyPressed(SDL_Scancode scancode) const {
+    return keyStates[scancode] || pressedThisTick[scancode];
+}
+
+bool InputHandler::IsKeyJustPressed(SDL_Scancode scancode) const {
+    return pressedThisTick[scancode];
+}
+
+bool InputHandler::IsKeyJustReleased(SDL_Scancode scancode) const {
+    return releasedThisTick[scancode] && !keyStates[scancode] && !pressedThisTick[scancode];
 }
 
 bool InputHandler::IsKeyPressed(SDL_Keycode key) const {
-    SDL_Scancode scancode = SDL_GetScancodeFromKey(key,nullptr);
-    return currentKeyStates[scancode];
+    return IsKeyPressed(SDL_GetScancodeFromKey(key,nullptr));
 }
 
 bool InputHandler::IsKeyJustPressed(SDL_Keycode key) const{
-    SDL_Scancode scancode = SDL_GetScancodeFromKey(key,nullptr);
-    return currentKeyStates[scancode] && !previousKeyStates[scancode];
+    return IsKeyJustPressed(SDL_GetScancodeFromKey(key,nullptr));
 }
 
 bool InputHandler::IsKeyJustReleased(SDL_Keycode key) const{
-    SDL_Scancode scancode = SDL_GetScancodeFromKey(key,nullptr);
-    return !currentKeyStates[scancode] && previousKeyStates[scancode];
+    return IsKeyJustReleased(SDL_GetScancodeFromKey(key,nullptr));
 }
 
-
+PlayerInputBits InputHandler::SamplePlayerInput(int player) const {
+    return GetActionBits(player) & PlayerInput::GAMEPLAY_MASK;
+}
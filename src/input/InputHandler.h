@@ -6,28 +6,176 @@
 #define INPUTHANDLER_H
 
 #include<SDL3/SDL.h>
+#include<array>
+#include<atomic>
 #include<iostream>
 #include<cstring>
+#include<string>
+#include "PlayerInput.h"
 
+// 命名动作；前 7 个的位与 PlayerInput 一致，可以直接作为自机输入
+enum class InputAction : uint8_t {
+    LEFT,
+    RIGHT,
+    UP,
+    DOWN,
+    SHOOT,
+    BOMB,
+    FOCUS,
+    PAUSE,      // 系统动作，不进入模拟输入（不回放、不联机同步）
+    COUNT
+};
+
+// 每 tick 的动作位掩码（第 i 位对应 InputAction i）
+using InputActionBits = uint16_t;
+
+constexpr InputActionBits ActionBit(InputAction action) {
+    return static_cast<InputActionBits>(1u << static_cast<unsigned>(action));
+}
 
+/**
+ * InputHandler - 键盘与手柄输入
+ * 职责：
+ * 1. 主线程的事件泵把按键和手柄事件（带 SDL 时间戳）推入单生产者/单消费者队列，
+ *    模拟线程每 tick 在 Update 中取完，维护按键/手柄状态，提供按下/刚按下/刚释放查询
+ * 2. 两个 tick 之间按下又松开的键（短按）在这一 tick 仍算按下，不会丢失
+ * 3. 动作映射：每个动作绑定最多 MAX_BINDINGS 个扫描码和手柄按键（启动时从配置文件读取，可重绑），
+ *    Update 时一次性解析成每个玩家的动作位掩码，游戏逻辑只读位
+ * 4. 手柄热插拔：按接入顺序占用玩家槽位（第 1 个手柄与键盘一起控制 1P，第 2 个控制 2P）；
+ *    左摇杆每 tick 按死区换算成 8 方向，与十字键合并
+ * 5. 输入延迟：每个按下事件从事件时间戳到消费它的 tick 的时间记入指标 input_latency_ms
+ *
+ * 手柄事件与键盘走同一条队列，不额外轮询，延迟与键盘相同。
+ * Push* 接口不依赖 SDL 设备，测试可以直接注入合成的手柄（任取一个设备编号）代替真实硬件。
+ * 调试热键用扫描码查询；键码版本每次查询都要换算扫描码，只为兼容保留
+ */
 class InputHandler {
 
 public:
     InputHandler();
+    ~InputHandler();
+
+    InputHandler(const InputHandler&) = delete;
+    InputHandler& operator=(const InputHandler&) = delete;
+
+    // 主线程：事件泵收到按键事件时调用（忽略按住重复）；队列满时丢弃并返回 false
+    bool PushKeyEvent(SDL_Scancode scancode, bool down, Uint64 timestampNS);
+
+    // 主线程：处理手柄事件（接入时打开设备、拔出时关闭），返回是否为手柄事件
+    bool HandleGamepadEvent(const SDL_Event& event);
+
+    // 手柄事件入队（HandleGamepadEvent 调用；合成设备直接调用）
+    bool PushGamepadAdded(SDL_JoystickID device, Uint64 timestampNS);
+    bool PushGamepadRemoved(SDL_JoystickID device, Uint64 timestampNS);
+    bool PushGamepadButton(SDL_JoystickID device, SDL_GamepadButton button, bool down, Uint64 timestampNS);
+    bool PushGamepadAxis(SDL_JoystickID device, SDL_GamepadAxis axis, Sint16 value, Uint64 timestampNS);
+
+    void Update();  // 模拟线程：取出本 tick 之前的全部输入事件，更新状态并解析动作位
+
+    // 从 JSON 读取绑定：{"SHOOT": ["Z"], "BOMB": ["X", "Space"], ...}，键名为 SDL 扫描码名称；
+    // 可选 "GAMEPAD": {"SHOOT": ["a"], ...}（SDL 手柄按键名）和 "STICK_DEADZONE": 0.3。
+    // 未出现的动作保留默认绑定。文件不存在时返回 false，默认绑定不变
+    bool LoadBindings(const std::string& filePath);
+
+    // 重绑：slot 为绑定槽位（0 ~ MAX_BINDINGS-1），SDL_SCANCODE_UNKNOWN / SDL_GAMEPAD_BUTTON_INVALID 表示清空
+    void SetBinding(InputAction action, int slot, SDL_Scancode scancode);
+    SDL_Scancode GetBinding(InputAction action, int slot) const;
+    void SetGamepadBinding(InputAction action, int slot, SDL_GamepadButton button);
+    SDL_GamepadButton GetGamepadBinding(InputAction action, int slot) const;
+    void ResetBindings();
+
+    // 摇杆死区（0 ~ 1，相对满偏）
+    void SetStickDeadzone(float deadzone);
+    float GetStickDeadzone() const { return stickDeadzone; }
+
+    // 动作查询；player 为玩家槽位（0 = 键盘 + 第 1 个手柄，1 = 第 2 个手柄）
+    InputActionBits GetActionBits(int player = 0) const;
+    bool IsActionPressed(InputAction action, int player = 0) const {
+        return (GetActionBits(player) & ActionBit(action)) != 0;
+    }
+    bool IsActionJustPressed(InputAction action, int player = 0) const;
 
-    void Update();  // 更新输入状态
+    // 该玩家槽位是否接有手柄
+    bool HasGamepad(int player) const;
+
+    bool IsKeyPressed(SDL_Scancode scancode) const;
+    bool IsKeyJustPressed(SDL_Scancode scancode) const;
+    bool IsKeyJustReleased(SDL_Scancode scancode) const;
 
     bool IsKeyPressed(SDL_Keycode key) const;  // 检查按键状态
 
     bool IsKeyJustPressed(SDL_Keycode key) const;  // 检查刚按下
 
     bool IsKeyJustReleased(SDL_Keycode key) const;  // 检查刚释放
+
+    PlayerInputBits SamplePlayerInput(int player = 0) const;  // 本 tick 动作位中的自机输入部分
+
+    static const char* GetActionName(InputAction action);
+
+    int GetLatencyMetric() const { return latencyMetric; }
+
+    static constexpr int MAX_BINDINGS = 2;
+    static constexpr int ACTION_COUNT = static_cast<int>(InputAction::COUNT);
+    static constexpr int MAX_PLAYERS = 2;
+    static constexpr uint32_t EVENT_CAPACITY = 1024;   // 2 的幂（摇杆移动时事件较密）
     
 private:
+    enum class EventType : uint8_t {
+        KEY,
+        PAD_ADDED,
+        PAD_REMOVED,
+        PAD_BUTTON,
+        PAD_AXIS
+    };
+
+    struct InputEvent {
+        Uint64 timestamp;       // SDL_GetTicksNS 时基
+        SDL_JoystickID device;  // 手柄事件的设备编号
+        EventType type;
+        bool down;
+        uint16_t code;          // 扫描码 / 手柄按键 / 手柄轴
+        Sint16 value;           // 轴的值
+    };
+
+    // 模拟线程维护的手柄状态（按玩家槽位）
+    struct PadState {
+        bool connected = false;
+        SDL_JoystickID device = 0;
+        uint32_t buttons = 0;               // 本 tick 结束时按住的按键（第 i 位对应 SDL_GamepadButton i）
+        uint32_t pressedThisTick = 0;       // 本 tick 内按下过的按键
+        std::array<Sint16, SDL_GAMEPAD_AXIS_COUNT> axes{};
+    };
+
+    bool PushEvent(const InputEvent& event);
+    void ApplyEvent(const InputEvent& event, Uint64 now);
+    void RecordLatency(Uint64 timestamp, Uint64 now);
+    int FindPad(SDL_JoystickID device) const;
+    InputActionBits ResolveKeyboard() const;
+    InputActionBits ResolvePad(const PadState& pad) const;
+
+    // 模拟线程维护的按键状态：本 tick 结束时是否按住，本 tick 内是否有按下/松开
+    Uint8 keyStates[SDL_SCANCODE_COUNT];
+    Uint8 pressedThisTick[SDL_SCANCODE_COUNT];
+    Uint8 releasedThisTick[SDL_SCANCODE_COUNT];
+    std::array<PadState, MAX_PLAYERS> pads;
+
+    // 主线程写、模拟线程读的事件队列
+    std::array<InputEvent, EVENT_CAPACITY> events;
+    alignas(64) std::atomic<uint32_t> eventWrite;
+    alignas(64) std::atomic<uint32_t> eventRead;
+
+    // 主线程打开的手柄设备
+    std::array<SDL_Gamepad*, MAX_PLAYERS> openGamepads;
+
+    std::array<std::array<SDL_Scancode, MAX_BINDINGS>, ACTION_COUNT> bindings;
+    std::array<std::array<SDL_GamepadButton, MAX_BINDINGS>, ACTION_COUNT> padBindings;
+    float stickDeadzone;
 
-    const bool* currentKeyStates;
+    std::array<InputActionBits, MAX_PLAYERS> actionBits;
+    std::array<InputActionBits, MAX_PLAYERS> previousActionBits;
 
-    Uint8 previousKeyStates[SDL_SCANCODE_COUNT];
+    int latencyMetric;
+    int droppedEventMetric;
 };
 
 #endif //INPUTHANDLER_H
@@ -0,0 +1,27 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef PLAYERINPUT_H
+#define PLAYERINPUT_H
+
+#include <cstdint>
+
+// 自机每 tick 的输入（位掩码）
+// 模拟只读取这个值，不直接读键盘：回放、联机回滚都只需要保存/传输每 tick 的 16 位输入
+using PlayerInputBits = uint16_t;
+
+namespace PlayerInput {
+    constexpr PlayerInputBits LEFT  = 1u << 0;
+    constexpr PlayerInputBits RIGHT = 1u << 1;
+    constexpr PlayerInputBits UP    = 1u << 2;
+    constexpr PlayerInputBits DOWN  = 1u << 3;
+    constexpr PlayerInputBits SHOOT = 1u << 4;
+    constexpr PlayerInputBits BOMB  = 1u << 5;
+    constexpr PlayerInputBits FOCUS = 1u << 6;
+
+    // 进入模拟的全部位（其余动作位只在本机使用）
+    constexpr PlayerInputBits GAMEPLAY_MASK = LEFT | RIGHT | UP | DOWN | SHOOT | BOMB | FOCUS;
+}
+
+#endif //PLAYERINPUT_H
@@ -3,25 +3,66 @@
 //
 
 #include "BulletManager.h"
+#include "../entity/SelfMachinesBase.h"
+#include "../snapshot/StateBuffer.h"
+#include "../gamecore/FrameProfiler.h"
+#include "../gamecore/Logger.h"
+#include "../gamecore/Metrics.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 
+namespace {
+    // 快照中每颗活跃子弹的记录
+    struct BulletRecord {
+        uint32_t poolIndex;
+        BulletBase::State state;
+    };
+
+    // 激光、obb 与实体的判定把实体看作圆：圆形碰撞体取本身，矩形取外框中心和长边的一半
+    void GetEntityCollisionCircle(const EntityBase* entity, float& centerX, float& centerY, float& radius) {
+        SDL_FRect bounds = entity->GetColliderBounds();
+        centerX = bounds.x + bounds.w * 0.5f;
+        centerY = bounds.y + bounds.h * 0.5f;
+        radius = entity->IsCircleCollider() ? entity->GetColliderRadius() : std::max(bounds.w, bounds.h) * 0.5f;
+    }
+}
+
 BulletManager::BulletManager(size_t initialSize, float factor)
-    : initialPoolSize(initialSize),
+    : behaviorsDirty(false),
+      initialPoolSize(initialSize),
       expandFactor(factor),
       maxPoolSize(10000),  // 设置最大池大小限制
       initialized(false),
       peakActiveCount(0),
-      totalCreatedCount(0) {
+      totalCreatedCount(0),
+      spawnMetric(-1),
+      poolGrowthMetric(-1) {
     bulletFactory = std::make_unique<BulletFactory>();
+    availableIndices.reserve(maxPoolSize);
+
+    // 逆序入栈，保证小槽位先被取出
+    laserTrails.resize(MAX_LASER_TRAILS);
+    freeLaserSlots.reserve(MAX_LASER_TRAILS);
+    for (size_t i = MAX_LASER_TRAILS; i > 0; --i) {
+        freeLaserSlots.push_back(static_cast<uint16_t>(i - 1));
+    }
 }
 
+BulletManager::~BulletManager() = default;
+
 bool BulletManager::Initialize(const std::string& configDir, Renderer& renderer) {
     if (initialized) {
         std::cerr << "BulletManager already initialized" << std::endl;
         return false;
     }
     
+    spawnMetric = MetricsRegistry::Instance().AddCounter("bullet_spawns");
+    poolGrowthMetric = MetricsRegistry::Instance().AddCounter("bullet_pool_growths");
+
     // 初始化子弹工厂
     if (!bulletFactory->Initialize(configDir, renderer)) {
         std::cerr << "Failed to initialize BulletFactory" << std::endl;
@@ -33,6 +74,37 @@ bool BulletManager::Initialize(const std::string& configDir, Renderer& renderer)
         std::cerr << "Failed to initialize bullet object pool" << std::endl;
         return false;
     }
+
+    // 活跃列表按最大池大小预留，扩池时也不会重新分配
+    activeBullets.reserve(maxPoolSize);
+    activePoolIndices.reserve(maxPoolSize);
+    playerCache.centerX.reserve(maxPoolSize);
+    playerCache.centerY.reserve(maxPoolSize);
+    playerCache.radius.reserve(maxPoolSize);
+    playerCache.grazed.reserve(maxPoolSize);
+    playerCache.result.reserve(maxPoolSize);
+    playerCache.bullets.reserve(maxPoolSize);
+    playerCache.lasers.reserve(maxPoolSize);
+    playerCache.boxCenterX.reserve(maxPoolSize);
+    playerCache.boxCenterY.reserve(maxPoolSize);
+    playerCache.boxCos.reserve(maxPoolSize);
+    playerCache.boxSin.reserve(maxPoolSize);
+    playerCache.boxHalfWidth.reserve(maxPoolSize);
+    playerCache.boxHalfHeight.reserve(maxPoolSize);
+    playerCache.boxGrazed.reserve(maxPoolSize);
+    playerCache.boxResult.reserve(maxPoolSize);
+    playerCache.boxBullets.reserve(maxPoolSize);
+    snapshotTypeRemap.reserve(bulletFactory->GetBulletTypeCount());
+    enemyCache.centerX.reserve(maxPoolSize);
+    enemyCache.centerY.reserve(maxPoolSize);
+    enemyCache.radius.reserve(maxPoolSize);
+    enemyCache.bullets.reserve(maxPoolSize);
+    enemyCache.others.reserve(maxPoolSize);
+    // 回调表预留到最大池大小（每颗子弹最多一条），执行回调期间追加条目也不会搬移正在调用的函数对象
+    for (auto& entries : behaviors) {
+        entries.reserve(maxPoolSize);
+    }
+    customUpdates.reserve(maxPoolSize);
     
     initialized = true;
     std::cout << "BulletManager initialized with pool size: " << bulletPool.size() << std::endl;
@@ -46,8 +118,11 @@ bool BulletManager::InitializeObjectPool(size_t size) {
         for (size_t i = 0; i < size; ++i) {
             // 创建子弹对象（使用默认构造函数）
             auto bullet = std::make_unique<BulletBase>(BulletOwner::PLAYER, 0, 0);
+            bullet->SetActive(false);
+            bullet->SetPoolIndex(static_cast<uint32_t>(i));
+            bulletPool.push_back(std::move(bullet));
             // 将索引入队
-            availableIndices.push(i);
+            availableIndices.push_back(i);
         }
         
         return true;
@@ -61,40 +136,67 @@ BulletBase* BulletManager::CreateBullet(const std::string& bulletType,
                                          BulletOwner owner,
                                          float x, float y) {
     if (!initialized) {
-        std::cerr << "BulletManager not initialized" << std::endl;
+        LOG_WARN("BulletManager not initialized");
+        return nullptr;
+    }
+
+    int typeIndex = bulletFactory->FindBulletTypeIndex(bulletType);
+    if (typeIndex < 0) {
+        LOG_WARN("Bullet type not found: {}", bulletType);
+        return nullptr;
+    }
+    return CreateBullet(static_cast<uint16_t>(typeIndex), owner, x, y);
+}
+
+BulletBase* BulletManager::CreateBullet(uint16_t typeIndex, BulletOwner owner, float x, float y) {
+    if (!initialized) {
+        LOG_WARN("BulletManager not initialized");
         return nullptr;
     }
     
     // 从对象池获取子弹
-    BulletBase* bullet = GetBulletFromPool();
-    if (!bullet) {
-        // 尝试扩展池并再次获取
-        if (ExpandObjectPool(static_cast<size_t>(bulletPool.size() * 0.2f))) {
-            bullet = GetBulletFromPool();
-        }
-        
-        if (!bullet) {
-            std::cerr << "Bullet pool exhausted" << std::endl;
+    size_t index = 0;
+    if (!AcquirePoolIndex(index)) {
+        // 尝试扩展池并再次获取（接近上限时只扩到上限）
+        size_t growth = std::min(static_cast<size_t>(bulletPool.size() * 0.2f) + 1, maxPoolSize - bulletPool.size());
+        if (growth == 0 || !ExpandObjectPool(growth) || !AcquirePoolIndex(index)) {
+            LOG_WARN("Bullet pool exhausted");
             return nullptr;
         }
     }
+    BulletBase* bullet = bulletPool[index].get();
     
     // 重置子弹状态
     ResetBulletState(bullet, owner, x, y);
     
-    // 使用BulletFactory初始化子弹（需要添加InitializeExistingBullet方法）
-    if (!bulletFactory->InitializeExistingBullet(bullet, bulletType)) {
-        std::cerr << "Failed to initialize bullet from config: " << bulletType << std::endl;
-        RecycleBullet(bullet);
+    // 使用BulletFactory初始化子弹
+    if (!bulletFactory->InitializeExistingBullet(bullet, typeIndex)) {
+        LOG_WARN("Failed to initialize bullet from config: {}", bulletFactory->GetBulletTypeName(typeIndex));
+        bullet->SetActive(false);
+        availableIndices.push_back(index);
+        return nullptr;
+    }
+
+    if (bullet->GetKind() == BulletKind::CURVY_LASER && !AttachLaserTrail(bullet)) {
+        LOG_WARN("Laser trail pool exhausted");
+        bullet->SetActive(false);
+        availableIndices.push_back(index);
         return nullptr;
     }
     
-    // 添加到活跃子弹集合
-    activeBullets.insert(bullet);
+    // 添加到活跃子弹列表
+    activeBullets.push_back(bullet);
+    activePoolIndices.push_back(index);
     bullet->SetActive(true);
+    bullet->BeginSpawnPhase();
+
+    for (const BulletBehavior& behavior : bullet->GetConfig()->behaviors) {
+        AddBehavior(bullet, behavior);
+    }
     
     // 更新统计
     totalCreatedCount++;
+    MetricsRegistry::Instance().Increment(spawnMetric);
     if (activeBullets.size() > peakActiveCount) {
         peakActiveCount = activeBullets.size();
     }
@@ -106,55 +208,272 @@ BulletBase* BulletManager::CreateBullet(const std::string& bulletType,
 void BulletManager::RecycleBullet(BulletBase* bullet) {
     if (!bullet || !initialized) return;
     
-    // 从活跃子弹集合中移除
-    activeBullets.erase(bullet);
-    
-    // 重置子弹状态
+    // 只标记失效，Update 压缩活跃列表时按池索引归还，避免在池中查找
     bullet->SetActive(false);
     bullet->SetVelocity(0, 0);
     bullet->SetLifeTime(0);
-    
-    // 查找子弹在池中的位置
-    for (size_t i = 0; i < bulletPool.size(); ++i) {
-        if (bulletPool[i].get() == bullet) {
-            availableIndices.push(i);
+}
+
+
+void BulletManager::ClearActiveBullets() {
+    if (!initialized) return;
+
+    for (size_t i = 0; i < activeBullets.size(); ++i) {
+        BulletBase* bullet = activeBullets[i];
+        bullet->SetActive(false);
+        bullet->SetVelocity(0, 0);
+        bullet->SetLifeTime(0);
+        ReturnToPool(bullet, activePoolIndices[i]);
+    }
+    activeBullets.clear();
+    activePoolIndices.clear();
+    PurgeBehaviors();
+}
+
+void BulletManager::AddBehavior(BulletBase* bullet, const BulletBehavior& behavior) {
+    if (!bullet || behavior.kind >= BehaviorKind::COUNT) return;
+
+    behaviors[static_cast<size_t>(behavior.kind)].push_back(BehaviorEntry{bullet->GetPoolIndex(), behavior});
+    bullet->SetFlag(BulletFlag::HAS_BEHAVIOR);
+}
+
+void BulletManager::SetCustomUpdate(BulletBase* bullet, std::function<void(BulletBase*, float)> update) {
+    if (!bullet) return;
+
+    // 慢路径，线性查找即可；移除只清空函数，条目由 PurgeBehaviors 删除
+    for (CustomUpdateEntry& entry : customUpdates) {
+        if (entry.poolIndex == bullet->GetPoolIndex()) {
+            entry.update = std::move(update);
+            behaviorsDirty = behaviorsDirty || !entry.update;
             return;
         }
     }
-    
-    std::cerr << "Bullet not found in pool during recycling" << std::endl;
+    if (update) {
+        customUpdates.push_back(CustomUpdateEntry{bullet->GetPoolIndex(), std::move(update)});
+        bullet->SetFlag(BulletFlag::HAS_BEHAVIOR);
+    }
 }
 
 
 void BulletManager::Update(float deltaTime) {
     if (!initialized) return;
     
-    // 使用迭代器安全遍历（允许在遍历过程中移除元素）
-    for (auto it = activeBullets.begin(); it != activeBullets.end(); ) {
-        BulletBase* bullet = *it;
-        if (bullet && bullet->IsActive()) {
-            bullet->Update(deltaTime);
-            
-            // 检查子弹是否应该被回收（过期或超出屏幕）
-            if (bullet->IsExpired() || bullet->IsOutOfBounds(800, 600)) {
-                RecycleBullet(bullet);
-                it = activeBullets.erase(it);  // 获取下一个迭代器
-            } else {
-                ++it;  // 移动到下一个
+    // 移动：追踪弹先读同一份目标快照转向
+    for (BulletBase* bullet : activeBullets) {
+        if (!bullet->IsActive()) continue;
+        float targetX, targetY;
+        if (bullet->IsHoming() &&
+            targets.FindTarget(bullet->GetOwner(), bullet->GetX(), bullet->GetY(), targetX, targetY)) {
+            bullet->SteerTowards(targetX, targetY, deltaTime);
+        }
+        bullet->Update(deltaTime);
+    }
+
+    // 行为：每种行为批量执行一遍（分裂生成的子弹追加在活跃列表末尾）
+    RunBehaviors(deltaTime);
+
+    // 原地压缩：存活的子弹前移，失效子弹（过期、出界、命中）的索引归还池中
+    const int fieldWidth = static_cast<int>(FIELD_WIDTH);
+    const int fieldHeight = static_cast<int>(FIELD_HEIGHT);
+    size_t writeIndex = 0;
+    for (size_t readIndex = 0; readIndex < activeBullets.size(); ++readIndex) {
+        BulletBase* bullet = activeBullets[readIndex];
+        if (bullet->IsActive() && (bullet->IsExpired() || bullet->IsOffscreen(fieldWidth, fieldHeight))) {
+            RecycleBullet(bullet);
+        }
+
+        if (!bullet->IsActive()) {
+            ReturnToPool(bullet, activePoolIndices[readIndex]);
+            continue;
+        }
+
+        activeBullets[writeIndex] = bullet;
+        activePoolIndices[writeIndex] = activePoolIndices[readIndex];
+        writeIndex++;
+    }
+
+    activeBullets.resize(writeIndex);
+    activePoolIndices.resize(writeIndex);
+
+    if (behaviorsDirty) {
+        PurgeBehaviors();
+    }
+}
+
+void BulletManager::RunBehaviors(float deltaTime) {
+    // 每张表原地压缩：返回 false 的条目（行为完成或子弹已失效）被移除
+    // 循环每次重新读取表长，分裂生成的子弹若挂同种行为，本 tick 也会被处理
+    auto run = [this](BehaviorKind kind, auto kernel) {
+        std::vector<BehaviorEntry>& entries = behaviors[static_cast<size_t>(kind)];
+        size_t writeIndex = 0;
+        for (size_t readIndex = 0; readIndex < entries.size(); ++readIndex) {
+            // 先拷出条目：内核可能生成子弹并向同一张表追加
+            BehaviorEntry entry = entries[readIndex];
+            BulletBase* bullet = bulletPool[entry.poolIndex].get();
+            if (!bullet->IsActive() || !kernel(bullet, entry.behavior)) {
+                continue;
             }
-        } else {
-            it = activeBullets.erase(it);  // 移除无效子弹
+            entries[writeIndex++] = entry;
+        }
+        entries.resize(writeIndex);
+    };
+
+    run(BehaviorKind::DELAY_ACCELERATE, [&](BulletBase* bullet, BulletBehavior& behavior) {
+        return RunDelayAccelerate(bullet, behavior, deltaTime);
+    });
+    run(BehaviorKind::BOUNCE, [&](BulletBase* bullet, BulletBehavior& behavior) {
+        return RunBounce(bullet, behavior);
+    });
+    run(BehaviorKind::WRAP, [&](BulletBase* bullet, BulletBehavior& behavior) {
+        return RunWrap(bullet, behavior);
+    });
+    run(BehaviorKind::CHANGE_SPRITE, [&](BulletBase* bullet, BulletBehavior& behavior) {
+        return RunChangeSprite(bullet, behavior);
+    });
+    run(BehaviorKind::SPLIT, [&](BulletBase* bullet, BulletBehavior& behavior) {
+        return RunSplit(bullet, behavior);
+    });
+
+    // 慢路径：自定义回调（回调内不要替换自身的回调）
+    for (size_t i = 0; i < customUpdates.size(); ++i) {
+        BulletBase* bullet = bulletPool[customUpdates[i].poolIndex].get();
+        if (customUpdates[i].update && bullet->IsActive()) {
+            customUpdates[i].update(bullet, deltaTime);
         }
     }
 }
 
-void BulletManager::Render(Renderer* renderer) {
-    if (!initialized || !renderer) return;
+bool BulletManager::RunDelayAccelerate(BulletBase* bullet, BulletBehavior& behavior, float deltaTime) {
+    if (bullet->GetLivedMs() < behavior.triggerMs) return true;
+
+    // 速度由积分接管；静止的子弹沿朝向加速
+    bullet->ClearMotion();
+    float vx = bullet->GetVelocityX();
+    float vy = bullet->GetVelocityY();
+    float speed = std::sqrt(vx * vx + vy * vy);
+    float dirX, dirY;
+    if (speed > 0.0f) {
+        dirX = vx / speed;
+        dirY = vy / speed;
+    } else {
+        bullet->GetFacing(dirX, dirY);
+    }
+
+    float newSpeed = speed + behavior.accel * deltaTime;
+    bool reached = behavior.accel >= 0.0f ? newSpeed >= behavior.speed : newSpeed <= behavior.speed;
+    if (reached) {
+        newSpeed = behavior.speed;
+    }
+    bullet->SetVelocity(dirX * newSpeed, dirY * newSpeed);
+    return !reached;
+}
+
+bool BulletManager::RunSplit(BulletBase* bullet, BulletBehavior& behavior) {
+    if (bullet->GetLivedMs() < behavior.triggerMs) return true;
+
+    constexpr float TWO_PI = 6.28318531f;
+    float vx = bullet->GetVelocityX();
+    float vy = bullet->GetVelocityY();
+    float baseAngle;
+    if (vx != 0.0f || vy != 0.0f) {
+        baseAngle = std::atan2(vy, vx);
+    } else {
+        float facingCos, facingSin;
+        bullet->GetFacing(facingCos, facingSin);
+        baseAngle = std::atan2(facingSin, facingCos);
+    }
+
+    // 张角 >= 2π 时均匀分布一周，否则以当前方向为中心展开扇形
+    const int count = behavior.count;
+    float startAngle = baseAngle;
+    float step = 0.0f;
+    if (behavior.spreadRad >= TWO_PI - 0.001f) {
+        step = count > 0 ? TWO_PI / count : 0.0f;
+    } else if (count > 1) {
+        startAngle = baseAngle - behavior.spreadRad * 0.5f;
+        step = behavior.spreadRad / (count - 1);
+    }
+
+    const BulletOwner owner = bullet->GetOwner();
+    const float x = bullet->GetX();
+    const float y = bullet->GetY();
+    RecycleBullet(bullet);
+    for (int i = 0; i < count; ++i) {
+        BulletBase* child = CreateBullet(behavior.typeIndex, owner, x, y);
+        if (!child) break;
+        child->SetSpeedAngle(behavior.speed, startAngle + step * i);
+    }
+    return false;
+}
+
+bool BulletManager::RunBounce(BulletBase* bullet, BulletBehavior& behavior) {
+    // 左/右/上边界反弹（下边界出界即回收）；闭式运动在反弹时转为积分
+    float x = bullet->GetX();
+    float y = bullet->GetY();
+    float vx = bullet->GetVelocityX();
+    float vy = bullet->GetVelocityY();
+    bool bounced = false;
+    if ((x < 0.0f && vx < 0.0f) || (x > FIELD_WIDTH && vx > 0.0f)) {
+        vx = -vx;
+        x = x < 0.0f ? -x : 2.0f * FIELD_WIDTH - x;
+        bounced = true;
+    }
+    if (y < 0.0f && vy < 0.0f) {
+        vy = -vy;
+        y = -y;
+        bounced = true;
+    }
+    if (!bounced) return true;
+
+    bullet->ClearMotion();
+    bullet->SetPosition(x, y);
+    bullet->SetVelocity(vx, vy);
+    if (behavior.count == 0) return false;
+    return --behavior.count > 0;
+}
+
+bool BulletManager::RunWrap(BulletBase* bullet, BulletBehavior& behavior) {
+    float dx = 0.0f;
+    float dy = 0.0f;
+    if (bullet->GetX() < 0.0f) dx = FIELD_WIDTH;
+    else if (bullet->GetX() > FIELD_WIDTH) dx = -FIELD_WIDTH;
+    if (bullet->GetY() < 0.0f) dy = FIELD_HEIGHT;
+    else if (bullet->GetY() > FIELD_HEIGHT) dy = -FIELD_HEIGHT;
+    if (dx == 0.0f && dy == 0.0f) return true;
+
+    bullet->Translate(dx, dy);
+    if (behavior.count == 0) return false;
+    return --behavior.count > 0;
+}
+
+bool BulletManager::RunChangeSprite(BulletBase* bullet, BulletBehavior& behavior) {
+    if (bullet->GetLivedMs() < behavior.triggerMs) return true;
+
+    // 只换外观和碰撞体，位置、速度与存活时间保持不变
+    if (!bulletFactory->InitializeExistingBullet(bullet, behavior.typeIndex)) {
+        LOG_WARN("BulletManager: change_sprite to invalid bullet type {}", behavior.typeIndex);
+    }
+    return false;
+}
+
+void BulletManager::PurgeBehaviors() {
+    for (auto& entries : behaviors) {
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [this](const BehaviorEntry& entry) {
+            return !bulletPool[entry.poolIndex]->IsActive();
+        }), entries.end());
+    }
+    customUpdates.erase(std::remove_if(customUpdates.begin(), customUpdates.end(), [this](const CustomUpdateEntry& entry) {
+        return !entry.update || !bulletPool[entry.poolIndex]->IsActive();
+    }), customUpdates.end());
+    behaviorsDirty = false;
+}
+
+void BulletManager::Submit(RenderQueue& queue) const {
+    if (!initialized) return;
     
-    // 渲染所有活跃子弹
     for (BulletBase* bullet : activeBullets) {
         if (bullet && bullet->IsActive()) {
-            bullet->Render(renderer);
+            bullet->Submit(queue);
         }
     }
 }
@@ -168,32 +487,60 @@ void BulletManager::ResetBulletState(BulletBase* bullet, BulletOwner owner, floa
     // 重置运动状态
     bullet->SetVelocity(0, 0);
     bullet->SetAcceleration(0, 0);
+    bullet->ClearMotion();
     
     // 重置生命周期
     bullet->SetLifeTime(0);
     
-    // 重置动画状态
-    // 注意：BulletBase 类中没有直接设置动画帧的方法，需要添加或通过其他方式重置
+    // 重置动画状态（由 InitializeFromConfig 归零）
     
     // 重置其他状态
     bullet->SetOwner(owner);
     bullet->SetDamage(1.0f); // 默认伤害值
     bullet->SetActive(true);
+
+    // 上一次使用者的行为条目已在归还池索引后由 PurgeBehaviors 移除
+    bullet->ClearFlags();
     
     // 重置碰撞体（使用默认碰撞体）
     // 注意：具体的碰撞体设置会在InitializeExistingBullet中重新配置
 }
 
 
-BulletBase* BulletManager::GetBulletFromPool() {
+bool BulletManager::AcquirePoolIndex(size_t& index) {
     if (availableIndices.empty()) {
-        return nullptr;
+        return false;
     }
     
-    size_t index = availableIndices.front();
-    availableIndices.pop();
-    
-    return bulletPool[index].get();
+    index = availableIndices.front();
+    availableIndices.pop_front();
+    return true;
+}
+
+void BulletManager::ReturnToPool(BulletBase* bullet, size_t poolIndex) {
+    if (bullet->HasFlag(BulletFlag::HAS_BEHAVIOR)) {
+        behaviorsDirty = true;
+    }
+    if (bullet->GetLaserSlot() != BulletBase::NO_LASER_SLOT) {
+        freeLaserSlots.push_back(bullet->GetLaserSlot());
+        bullet->AttachLaserTrail(nullptr, BulletBase::NO_LASER_SLOT);
+    }
+    availableIndices.push_back(poolIndex);
+}
+
+bool BulletManager::AttachLaserTrail(BulletBase* bullet) {
+    if (freeLaserSlots.empty()) {
+        return false;
+    }
+
+    uint16_t slot = freeLaserSlots.back();
+    freeLaserSlots.pop_back();
+
+    LaserTrail& trail = laserTrails[slot];
+    trail.Reset(bullet->GetConfig()->laser.trailPoints);
+    trail.Push(bullet->GetX(), bullet->GetY());
+    bullet->AttachLaserTrail(&trail, slot);
+    return true;
 }
 
 bool BulletManager::ExpandObjectPool(size_t additionalSize) {
@@ -201,27 +548,109 @@ bool BulletManager::ExpandObjectPool(size_t additionalSize) {
     size_t newSize = oldSize + additionalSize;
     
     if (newSize > maxPoolSize) {
-        std::cerr << "Cannot expand pool beyond max size: " << maxPoolSize << std::endl;
+        LOG_WARN("Cannot expand pool beyond max size: {}", maxPoolSize);
         return false;
     }
     
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    double expandBegin = profiler.Now();
     try {
         bulletPool.reserve(newSize);
         
         for (size_t i = oldSize; i < newSize; ++i) {
             // 创建新的子弹对象
             auto bullet = std::make_unique<BulletBase>(BulletOwner::PLAYER, 0, 0);
-            availableIndices.push(i);
+            bullet->SetActive(false);
+            bullet->SetPoolIndex(static_cast<uint32_t>(i));
+            bulletPool.push_back(std::move(bullet));
+            availableIndices.push_back(i);
         }
         
-        std::cout << "Expanded bullet pool from " << oldSize << " to " << newSize << std::endl;
+        char label[32];
+        std::snprintf(label, sizeof(label), "bullets %zu->%zu", oldSize, newSize);
+        profiler.Mark(FrameMarker::POOL_EXPANSION, profiler.Now() - expandBegin, label);
+
+        MetricsRegistry::Instance().Increment(poolGrowthMetric);
+        LOG_INFO("Expanded bullet pool from {} to {}", oldSize, newSize);
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Exception during pool expansion: " << e.what() << std::endl;
+        LOG_ERROR("Exception during pool expansion: {}", e.what());
         return false;
     }
 }
 
+size_t BulletManager::ClearBullets(const BulletClearRegion& region, uint8_t ownerMask,
+                                   std::vector<SDL_FPoint>* clearedPositions) {
+    if (!initialized) return 0;
+
+    const float radiusSq = region.radius * region.radius;
+    const float right = region.x + region.width;
+    const float bottom = region.y + region.height;
+
+    // 与 Update 相同的原地压缩；调用方预留了位置缓冲区时整个过程不分配
+    size_t writeIndex = 0;
+    size_t clearedCount = 0;
+    for (size_t readIndex = 0; readIndex < activeBullets.size(); ++readIndex) {
+        BulletBase* bullet = activeBullets[readIndex];
+        bool matched = false;
+
+        if (bullet->IsActive()) {
+            uint8_t ownerBit = bullet->GetOwner() == BulletOwner::PLAYER ? BulletClearOwner::PLAYER
+                                                                         : BulletClearOwner::ENEMY;
+            // 激光以头部（直线激光为发射点）作为转换道具的位置
+            SDL_FRect bounds = bullet->GetColliderBounds();
+            float centerX = bullet->IsLaser() ? bullet->GetX() : bounds.x + bounds.w * 0.5f;
+            float centerY = bullet->IsLaser() ? bullet->GetY() : bounds.y + bounds.h * 0.5f;
+
+            switch (region.shape) {
+                case BulletClearRegion::Shape::SCREEN:
+                    matched = true;
+                    break;
+                case BulletClearRegion::Shape::CIRCLE: {
+                    // 激光只要中心线有一部分进入圆内就清除
+                    float dx = centerX - region.x;
+                    float dy = centerY - region.y;
+                    float distanceSq = bullet->IsLaser() ? bullet->GetLaserDistanceSq(region.x, region.y)
+                                                         : dx * dx + dy * dy;
+                    matched = distanceSq <= radiusSq;
+                    break;
+                }
+                case BulletClearRegion::Shape::RECT:
+                    matched = centerX >= region.x && centerX <= right &&
+                              centerY >= region.y && centerY <= bottom;
+                    break;
+            }
+            matched = matched && (ownerMask & ownerBit);
+
+            if (matched) {
+                // 出现阶段被清除的子弹直接消失，不转换成道具
+                if (clearedPositions && bullet->IsCollidable()) {
+                    clearedPositions->push_back(SDL_FPoint{centerX, centerY});
+                }
+                RecycleBullet(bullet);
+                clearedCount++;
+            }
+        }
+
+        if (!bullet->IsActive()) {
+            ReturnToPool(bullet, activePoolIndices[readIndex]);
+            continue;
+        }
+
+        activeBullets[writeIndex] = bullet;
+        activePoolIndices[writeIndex] = activePoolIndices[readIndex];
+        writeIndex++;
+    }
+
+    activeBullets.resize(writeIndex);
+    activePoolIndices.resize(writeIndex);
+
+    if (behaviorsDirty) {
+        PurgeBehaviors();
+    }
+    return clearedCount;
+}
+
 void BulletManager::CheckCollisions(std::vector<std::shared_ptr<EntityBase>>& entities) {
     if (!initialized) return;
     
@@ -241,23 +670,333 @@ void BulletManager::CheckBulletEntityCollisions(BulletBase* bullet,
     if (!bullet || !bullet->IsActive()) return;
     
     for (auto& entity : entities) {
-        if (!entity || !entity->IsActive()) continue;
-        
-        // 跳过自身
-        if (bullet == entity.get()) continue;
-        
-        // 检查碰撞
-        if (bullet->IsCollidingWith(*entity)) {
-            // 调用双方的碰撞处理函数
-            bullet->OnCollision(entity.get());
-            entity->OnCollision(bullet);
-            
-            // 如果子弹因碰撞而失效，提前退出
-            if (!bullet->IsActive()) break;
+        CheckBulletEntityCollision(bullet, entity.get());
+
+        // 如果子弹因碰撞而失效，提前退出
+        if (!bullet->IsActive()) break;
+    }
+}
+
+void BulletManager::BuildEnemyCollisionCache() {
+    EnemyCollisionCache& cache = enemyCache;
+    cache.centerX.clear();
+    cache.centerY.clear();
+    cache.radius.clear();
+    cache.bullets.clear();
+    cache.others.clear();
+    if (!initialized) return;
+
+    for (BulletBase* bullet : activeBullets) {
+        if (!bullet->IsActive() || bullet->GetOwner() != BulletOwner::PLAYER || !bullet->IsCollidable()) continue;
+        if (bullet->IsCircleCollider() && !bullet->IsLaser() && !bullet->IsOrientedBoxCollider()) {
+            float radius = bullet->GetColliderRadius();
+            cache.centerX.push_back(bullet->GetX() + bullet->GetColliderX() + radius);
+            cache.centerY.push_back(bullet->GetY() + bullet->GetColliderY() + radius);
+            cache.radius.push_back(radius);
+            cache.bullets.push_back(bullet);
+        } else {
+            cache.others.push_back(bullet);
+        }
+    }
+}
+
+void BulletManager::CheckEnemyCollisions(EntityBase* enemy) {
+    if (!initialized || !enemy || !enemy->IsActive()) return;
+
+    EnemyCollisionCache& cache = enemyCache;
+    const size_t circleCount = cache.centerX.size();
+
+    if (enemy->IsCircleCollider()) {
+        const float enemyRadius = enemy->GetColliderRadius();
+        const float enemyX = enemy->GetX() + enemy->GetColliderX() + enemyRadius;
+        const float enemyY = enemy->GetY() + enemy->GetColliderY() + enemyRadius;
+        const float* centerX = cache.centerX.data();
+        const float* centerY = cache.centerY.data();
+        const float* radius = cache.radius.data();
+        for (size_t i = 0; i < circleCount; ++i) {
+            float dx = centerX[i] - enemyX;
+            float dy = centerY[i] - enemyY;
+            float reach = enemyRadius + radius[i];
+            if (dx * dx + dy * dy >= reach * reach) continue;
+
+            // 前面的敌机已经用掉的子弹不再命中
+            BulletBase* bullet = cache.bullets[i];
+            if (!bullet->IsActive()) continue;
+            bullet->OnCollision(enemy);
+            enemy->OnCollision(bullet);
+            if (!enemy->IsActive()) return;
+        }
+    } else {
+        for (size_t i = 0; i < circleCount; ++i) {
+            if (cache.bullets[i]->IsActive()) {
+                CheckBulletEntityCollision(cache.bullets[i], enemy);
+                if (!enemy->IsActive()) return;
+            }
+        }
+    }
+
+    for (BulletBase* bullet : cache.others) {
+        if (bullet->IsActive()) {
+            CheckBulletEntityCollision(bullet, enemy);
+            if (!enemy->IsActive()) return;
+        }
+    }
+}
+
+bool BulletManager::CheckBulletEntityCollision(BulletBase* bullet, EntityBase* entity) {
+    if (!entity || !entity->IsActive() || !bullet->IsCollidable()) return false;
+
+    // 跳过自身
+    if (bullet == entity) return false;
+
+    // 检查碰撞（激光按中心线、obb 按旋转矩形到实体碰撞圆的距离判定）
+    if (bullet->IsLaser()) {
+        if (!bullet->IsLaserHarmful()) return false;
+        float centerX, centerY, radius;
+        GetEntityCollisionCircle(entity, centerX, centerY, radius);
+        float reach = bullet->GetLaserWidth() * bullet->GetConfig()->laser.hitboxScale * 0.5f + radius;
+        if (bullet->GetLaserDistanceSq(centerX, centerY) >= reach * reach) {
+            return false;
+        }
+    } else if (bullet->IsOrientedBoxCollider()) {
+        // 外接正方形先粗筛
+        if (!bullet->IsCollidingWith(*entity)) return false;
+        float centerX, centerY, radius;
+        GetEntityCollisionCircle(entity, centerX, centerY, radius);
+        if (bullet->GetBoxDistanceSq(centerX, centerY) >= radius * radius) {
+            return false;
+        }
+    } else if (!bullet->IsCollidingWith(*entity)) {
+        return false;
+    }
+
+    // 调用双方的碰撞处理函数
+    bullet->OnCollision(entity);
+    entity->OnCollision(bullet);
+    return true;
+}
+
+void BulletManager::BuildPlayerCollisionCache() {
+    PlayerCollisionCache& cache = playerCache;
+    cache.centerX.clear();
+    cache.centerY.clear();
+    cache.radius.clear();
+    cache.grazed.clear();
+    cache.bullets.clear();
+    cache.lasers.clear();
+    cache.boxCenterX.clear();
+    cache.boxCenterY.clear();
+    cache.boxCos.clear();
+    cache.boxSin.clear();
+    cache.boxHalfWidth.clear();
+    cache.boxHalfHeight.clear();
+    cache.boxGrazed.clear();
+    cache.boxBullets.clear();
+    if (!initialized) return;
+
+    // 圆形敌弹在前（融合循环处理），其余碰撞体的敌弹追加在 bullets 尾部走通用检测
+    for (BulletBase* bullet : activeBullets) {
+        if (!bullet->IsActive() || bullet->GetOwner() != BulletOwner::ENEMY || !bullet->IsCircleCollider() ||
+            bullet->IsLaser() || !bullet->IsCollidable()) {
+            continue;
+        }
+        float radius = bullet->GetColliderRadius();
+        cache.centerX.push_back(bullet->GetX() + bullet->GetColliderX() + radius);
+        cache.centerY.push_back(bullet->GetY() + bullet->GetColliderY() + radius);
+        cache.radius.push_back(radius);
+        cache.grazed.push_back(bullet->HasFlag(BulletFlag::GRAZED) ? 1 : 0);
+        cache.bullets.push_back(bullet);
+    }
+
+    for (BulletBase* bullet : activeBullets) {
+        if (!bullet->IsActive() || bullet->GetOwner() != BulletOwner::ENEMY || !bullet->IsCollidable()) continue;
+        if (bullet->IsLaser()) {
+            // 预警线阶段不判定也不计擦弹
+            if (bullet->IsLaserHarmful()) {
+                cache.lasers.push_back(bullet);
+            }
+        } else if (bullet->IsOrientedBoxCollider()) {
+            // 朝向只在这里按需计算（速度不变时直接取缓存）
+            float c, s;
+            bullet->GetFacing(c, s);
+            cache.boxCenterX.push_back(bullet->GetX());
+            cache.boxCenterY.push_back(bullet->GetY());
+            cache.boxCos.push_back(c);
+            cache.boxSin.push_back(s);
+            cache.boxHalfWidth.push_back(bullet->GetBoxHalfWidth());
+            cache.boxHalfHeight.push_back(bullet->GetBoxHalfHeight());
+            cache.boxGrazed.push_back(bullet->HasFlag(BulletFlag::GRAZED) ? 1 : 0);
+            cache.boxBullets.push_back(bullet);
+        } else if (!bullet->IsCircleCollider()) {
+            cache.bullets.push_back(bullet);
+        }
+    }
+
+    cache.result.resize(cache.centerX.size());
+    cache.boxResult.resize(cache.boxCenterX.size());
+}
+
+void BulletManager::CheckPlayerCollisions(SelfMachineBase* player) {
+    // 死亡的自机既不被命中也不擦弹（DEAD 不算无敌，放行会继续扣残机）
+    if (!initialized || !player || !player->IsAlive()) return;
+
+    PlayerCollisionCache& cache = playerCache;
+    const size_t circleCount = cache.centerX.size();
+    const size_t boxCount = cache.boxCenterX.size();
+    const bool canGraze = player->CanGraze();
+
+    if (player->IsCircleCollider()) {
+        const float hitRadius = player->GetColliderRadius();
+        const float grazeRadius = canGraze ? player->GetGrazeRadius() : 0.0f;
+        const float playerX = player->GetX() + player->GetColliderX() + hitRadius;
+        const float playerY = player->GetY() + player->GetColliderY() + hitRadius;
+
+        // 判定与擦弹共用一次距离计算；循环体无分支、只读连续数组，编译器可直接向量化
+        // 结果位：bit0 命中，bit1 新的擦弹
+        const float* centerX = cache.centerX.data();
+        const float* centerY = cache.centerY.data();
+        const float* radius = cache.radius.data();
+        const uint8_t* grazed = cache.grazed.data();
+        uint8_t* result = cache.result.data();
+        uint8_t anyResult = 0;
+        for (size_t i = 0; i < circleCount; ++i) {
+            float dx = centerX[i] - playerX;
+            float dy = centerY[i] - playerY;
+            float distanceSq = dx * dx + dy * dy;
+            float hitReach = hitRadius + radius[i];
+            float grazeReach = grazeRadius + radius[i];
+            uint8_t hit = distanceSq < hitReach * hitReach;
+            uint8_t graze = (distanceSq < grazeReach * grazeReach) & (grazed[i] ^ 1);
+            result[i] = static_cast<uint8_t>(hit | (graze << 1));
+            anyResult |= result[i];
+        }
+
+        // 命中和擦弹都很稀疏，没有结果时整段跳过
+        if (anyResult) {
+            for (size_t i = 0; i < circleCount; ++i) {
+                if (result[i]) {
+                    ResolvePlayerContact(player, cache.bullets[i], result[i] & 1, cache.grazed.data() + i);
+                }
+            }
+        }
+
+        // obb 敌弹：自机圆心转到盒子局部坐标，按轴对齐盒求距离，同样无分支
+        const float hitRadiusSq = hitRadius * hitRadius;
+        const float grazeRadiusSq = grazeRadius * grazeRadius;
+        const float* boxX = cache.boxCenterX.data();
+        const float* boxY = cache.boxCenterY.data();
+        const float* boxCos = cache.boxCos.data();
+        const float* boxSin = cache.boxSin.data();
+        const float* halfWidth = cache.boxHalfWidth.data();
+        const float* halfHeight = cache.boxHalfHeight.data();
+        const uint8_t* boxGrazed = cache.boxGrazed.data();
+        uint8_t* boxResult = cache.boxResult.data();
+        uint8_t anyBoxResult = 0;
+        for (size_t i = 0; i < boxCount; ++i) {
+            float dx = playerX - boxX[i];
+            float dy = playerY - boxY[i];
+            float localX = std::fabs(dx * boxCos[i] + dy * boxSin[i]) - halfWidth[i];
+            float localY = std::fabs(dy * boxCos[i] - dx * boxSin[i]) - halfHeight[i];
+            // max(v, 0) 写成 (v + |v|) / 2，结果精确且不产生分支，循环才能向量化
+            localX = (localX + std::fabs(localX)) * 0.5f;
+            localY = (localY + std::fabs(localY)) * 0.5f;
+            float distanceSq = localX * localX + localY * localY;
+            uint8_t hit = distanceSq < hitRadiusSq;
+            uint8_t graze = (distanceSq < grazeRadiusSq) & (boxGrazed[i] ^ 1);
+            boxResult[i] = static_cast<uint8_t>(hit | (graze << 1));
+            anyBoxResult |= boxResult[i];
+        }
+
+        if (anyBoxResult) {
+            for (size_t i = 0; i < boxCount; ++i) {
+                if (boxResult[i]) {
+                    ResolvePlayerContact(player, cache.boxBullets[i], boxResult[i] & 1, cache.boxGrazed.data() + i);
+                }
+            }
+        }
+    } else {
+        // 非圆形判定的自机：逐颗通用检测，不计擦弹
+        for (size_t i = 0; i < circleCount; ++i) {
+            if (cache.bullets[i]->IsActive() && player->IsActive()) {
+                CheckBulletEntityCollision(cache.bullets[i], player);
+            }
+        }
+        for (BulletBase* bullet : cache.boxBullets) {
+            if (bullet->IsActive() && player->IsActive()) {
+                CheckBulletEntityCollision(bullet, player);
+            }
+        }
+    }
+
+    // 矩形等其它碰撞体的敌弹数量很少，走通用检测；擦弹按外圈与碰撞框的最近点计算
+    const float grazeRadius = player->GetGrazeRadius();
+    const float playerX = player->GetCenterX();
+    const float playerY = player->GetCenterY();
+    for (size_t i = circleCount; i < cache.bullets.size(); ++i) {
+        BulletBase* bullet = cache.bullets[i];
+        if (!bullet->IsActive() || !player->IsActive()) continue;
+
+        bool hit = bullet->IsCollidingWith(*player);
+        bool graze = false;
+        if (!hit && canGraze && !bullet->HasFlag(BulletFlag::GRAZED)) {
+            SDL_FRect bounds = bullet->GetColliderBounds();
+            float dx = playerX - std::clamp(playerX, bounds.x, bounds.x + bounds.w);
+            float dy = playerY - std::clamp(playerY, bounds.y, bounds.y + bounds.h);
+            graze = dx * dx + dy * dy < grazeRadius * grazeRadius;
+        }
+        if (hit || graze) {
+            ResolvePlayerContact(player, bullet, hit, nullptr);
+        }
+    }
+
+    // 激光：包围盒扩展擦弹半径粗筛，再算到中心线的距离；判定比显示窄（hitboxScale）
+    const float playerRadius = player->IsCircleCollider() ? player->GetColliderRadius() : 0.0f;
+    const float laserTargetX = player->IsCircleCollider() ? player->GetX() + player->GetColliderX() + playerRadius : playerX;
+    const float laserTargetY = player->IsCircleCollider() ? player->GetY() + player->GetColliderY() + playerRadius : playerY;
+    for (BulletBase* laser : cache.lasers) {
+        if (!laser->IsActive() || !player->IsActive()) continue;
+
+        SDL_FRect bounds;
+        if (!laser->GetLaserBounds(bounds)) continue;
+        const float halfWidth = laser->GetLaserWidth() * 0.5f;
+        const float reach = halfWidth + grazeRadius + playerRadius;
+        if (laserTargetX < bounds.x - reach || laserTargetX > bounds.x + bounds.w + reach ||
+            laserTargetY < bounds.y - reach || laserTargetY > bounds.y + bounds.h + reach) {
+            continue;
+        }
+
+        float distanceSq = laser->GetLaserDistanceSq(laserTargetX, laserTargetY);
+        float hitReach = halfWidth * laser->GetConfig()->laser.hitboxScale + playerRadius;
+        float grazeReach = halfWidth + grazeRadius;
+        bool hit = distanceSq < hitReach * hitReach;
+        bool graze = !hit && canGraze && !laser->HasFlag(BulletFlag::GRAZED) && distanceSq < grazeReach * grazeReach;
+        if (hit || graze) {
+            ResolvePlayerContact(player, laser, hit, nullptr);
         }
     }
 }
 
+void BulletManager::ResolvePlayerContact(SelfMachineBase* player, BulletBase* bullet, bool hit, uint8_t* cachedGrazed) {
+    // 同一 tick 内可能已被另一个自机命中；自机可能在本 tick 的上一次命中中死亡
+    if (!bullet->IsActive() || !player->IsAlive()) return;
+
+    if (hit) {
+        bullet->OnCollision(player);
+        player->OnCollision(bullet);
+        return;
+    }
+
+    bullet->SetFlag(BulletFlag::GRAZED);
+    if (cachedGrazed) {
+        *cachedGrazed = 1;
+    }
+    player->AddGraze();
+}
+
+void BulletManager::CheckBulletBulletCollisions() {
+    // 子弹之间不碰撞，保留为扩展点
+}
+
 std::vector<BulletBase*> BulletManager::GetActiveBulletsByOwner(BulletOwner owner) {
     std::vector<BulletBase*> result;
     
@@ -281,3 +1020,216 @@ size_t BulletManager::GetPoolSize() const {
 size_t BulletManager::GetAvailableBulletCount() const {
     return availableIndices.size();
 }
+
+void BulletManager::SaveState(StateWriter& writer) const {
+    writer.Write(static_cast<uint32_t>(bulletPool.size()));
+
+    // 类型表：恢复时按名称重新映射编号，配置文件增删后旧快照仍可加载
+    uint32_t typeCount = static_cast<uint32_t>(bulletFactory->GetBulletTypeCount());
+    writer.Write(typeCount);
+    for (uint32_t i = 0; i < typeCount; ++i) {
+        writer.WriteString(bulletFactory->GetBulletTypeName(static_cast<uint16_t>(i)));
+    }
+
+    // 活跃子弹整块写入：一次扩容，逐颗 memcpy 定长记录
+    uint32_t activeCount = static_cast<uint32_t>(activeBullets.size());
+    writer.Write(activeCount);
+    writer.Write(static_cast<uint32_t>(sizeof(BulletRecord)));
+    uint8_t* records = writer.Append(activeCount * sizeof(BulletRecord));
+    for (uint32_t i = 0; i < activeCount; ++i) {
+        BulletRecord record{};
+        record.poolIndex = static_cast<uint32_t>(activePoolIndices[i]);
+        activeBullets[i]->CaptureState(record.state);
+        std::memcpy(records + i * sizeof(BulletRecord), &record, sizeof(BulletRecord));
+    }
+
+    // 空闲队列顺序决定之后生成时取到哪个池槽位，必须原样保存
+    uint32_t availableCount = static_cast<uint32_t>(availableIndices.size());
+    writer.Write(availableCount);
+    uint8_t* indices = writer.Append(availableCount * sizeof(uint32_t));
+    for (uint32_t i = 0; i < availableCount; ++i) {
+        uint32_t index = static_cast<uint32_t>(availableIndices[i]);
+        std::memcpy(indices + i * sizeof(uint32_t), &index, sizeof(uint32_t));
+    }
+
+    // 曲线激光轨迹：按活跃顺序写出有效点（从头到尾），以及空闲槽位栈
+    for (const BulletBase* bullet : activeBullets) {
+        const LaserTrail* trail = bullet->GetLaserTrail();
+        if (!trail) continue;
+        writer.Write(trail->capacity);
+        writer.Write(trail->count);
+        for (int i = 0; i < trail->count; ++i) {
+            writer.Write(trail->Get(i).x);
+            writer.Write(trail->Get(i).y);
+        }
+    }
+    writer.Write(static_cast<uint32_t>(freeLaserSlots.size()));
+    for (uint16_t slot : freeLaserSlots) {
+        writer.Write(slot);
+    }
+
+    // 行为表按种类整块写入（条目平凡可复制）；自定义回调无法序列化，不保存
+    writer.Write(static_cast<uint32_t>(sizeof(BehaviorEntry)));
+    for (const auto& entries : behaviors) {
+        writer.Write(static_cast<uint32_t>(entries.size()));
+        uint8_t* data = writer.Append(entries.size() * sizeof(BehaviorEntry));
+        if (!entries.empty()) {
+            std::memcpy(data, entries.data(), entries.size() * sizeof(BehaviorEntry));
+        }
+    }
+
+    writer.Write(static_cast<uint64_t>(peakActiveCount));
+    writer.Write(static_cast<uint64_t>(totalCreatedCount));
+}
+
+bool BulletManager::LoadState(StateReader& reader) {
+    if (!initialized) return false;
+
+    ClearActiveBullets();
+
+    uint32_t poolSize = 0;
+    reader.Read(poolSize);
+    if (reader.HasFailed() || poolSize > maxPoolSize) return false;
+    if (poolSize > bulletPool.size() && !ExpandObjectPool(poolSize - bulletPool.size())) {
+        return false;
+    }
+
+    // 快照类型编号 -> 当前类型编号
+    // 映射表与类型名缓冲是复用的成员，回滚和跳转时恢复不产生分配
+    uint32_t typeCount = 0;
+    reader.Read(typeCount);
+    snapshotTypeRemap.clear();
+    for (uint32_t i = 0; i < typeCount && !reader.HasFailed(); ++i) {
+        reader.ReadString(snapshotTypeName);
+        snapshotTypeRemap.push_back(bulletFactory->FindBulletTypeIndex(snapshotTypeName));
+    }
+
+    uint32_t activeCount = 0;
+    uint32_t recordSize = 0;
+    reader.Read(activeCount);
+    reader.Read(recordSize);
+    if (reader.HasFailed() || recordSize != sizeof(BulletRecord)) {
+        LOG_ERROR("BulletManager: incompatible bullet snapshot");
+        return false;
+    }
+
+    const uint8_t* records = reader.Consume(static_cast<size_t>(activeCount) * sizeof(BulletRecord));
+    if (!records) return false;
+
+    for (uint32_t i = 0; i < activeCount; ++i) {
+        BulletRecord record;
+        std::memcpy(&record, records + i * sizeof(BulletRecord), sizeof(BulletRecord));
+
+        int typeIndex = record.state.typeIndex < snapshotTypeRemap.size() ? snapshotTypeRemap[record.state.typeIndex]
+                                                                          : -1;
+        if (record.poolIndex >= bulletPool.size() || typeIndex < 0) {
+            LOG_ERROR("BulletManager: invalid bullet in snapshot");
+            return false;
+        }
+
+        BulletBase* bullet = bulletPool[record.poolIndex].get();
+        if (!bulletFactory->InitializeExistingBullet(bullet, static_cast<uint16_t>(typeIndex))) {
+            return false;
+        }
+        bullet->ApplyState(record.state);
+        if (record.state.laserSlot != BulletBase::NO_LASER_SLOT) {
+            if (record.state.laserSlot >= laserTrails.size() || bullet->GetKind() != BulletKind::CURVY_LASER) {
+                LOG_ERROR("BulletManager: invalid laser slot in snapshot");
+                return false;
+            }
+            bullet->AttachLaserTrail(&laserTrails[record.state.laserSlot], record.state.laserSlot);
+        }
+
+        activeBullets.push_back(bullet);
+        activePoolIndices.push_back(record.poolIndex);
+    }
+
+    uint32_t availableCount = 0;
+    reader.Read(availableCount);
+    const uint8_t* indices = reader.Consume(static_cast<size_t>(availableCount) * sizeof(uint32_t));
+    if (!indices) return false;
+
+    availableIndices.clear();
+    for (uint32_t i = 0; i < availableCount; ++i) {
+        uint32_t index = 0;
+        std::memcpy(&index, indices + i * sizeof(uint32_t), sizeof(uint32_t));
+        availableIndices.push_back(index);
+    }
+
+    // 轨迹按从尾到头重新压入，Get(i) 的顺序与保存时一致
+    for (BulletBase* bullet : activeBullets) {
+        if (bullet->GetLaserSlot() == BulletBase::NO_LASER_SLOT) continue;
+        uint16_t capacity = 0;
+        uint16_t count = 0;
+        reader.Read(capacity);
+        reader.Read(count);
+        if (reader.HasFailed() || capacity < 2 || capacity > MAX_LASER_TRAIL_POINTS || count > capacity) {
+            LOG_ERROR("BulletManager: invalid laser trail in snapshot");
+            return false;
+        }
+
+        SDL_FPoint points[MAX_LASER_TRAIL_POINTS];
+        for (uint16_t i = 0; i < count; ++i) {
+            reader.Read(points[i].x);
+            reader.Read(points[i].y);
+        }
+        LaserTrail& trail = laserTrails[bullet->GetLaserSlot()];
+        trail.Reset(capacity);
+        for (int i = count - 1; i >= 0; --i) {
+            trail.Push(points[i].x, points[i].y);
+        }
+    }
+
+    uint32_t freeSlotCount = 0;
+    reader.Read(freeSlotCount);
+    if (reader.HasFailed() || freeSlotCount > laserTrails.size()) return false;
+    freeLaserSlots.clear();
+    for (uint32_t i = 0; i < freeSlotCount && !reader.HasFailed(); ++i) {
+        uint16_t slot = 0;
+        reader.Read(slot);
+        freeLaserSlots.push_back(slot);
+    }
+
+    uint32_t entrySize = 0;
+    reader.Read(entrySize);
+    if (reader.HasFailed() || entrySize != sizeof(BehaviorEntry)) {
+        LOG_ERROR("BulletManager: incompatible behavior snapshot");
+        return false;
+    }
+    for (auto& entries : behaviors) {
+        uint32_t entryCount = 0;
+        reader.Read(entryCount);
+        const uint8_t* data = reader.Consume(static_cast<size_t>(entryCount) * sizeof(BehaviorEntry));
+        if (!data) return false;
+
+        entries.clear();
+        for (uint32_t i = 0; i < entryCount; ++i) {
+            BehaviorEntry entry;
+            std::memcpy(&entry, data + i * sizeof(BehaviorEntry), sizeof(BehaviorEntry));
+            if (entry.poolIndex >= bulletPool.size() || entry.behavior.kind >= BehaviorKind::COUNT) {
+                LOG_ERROR("BulletManager: invalid behavior in snapshot");
+                return false;
+            }
+            // 分裂/换外观引用的类型编号同样按名称重新映射
+            if (entry.behavior.kind == BehaviorKind::SPLIT || entry.behavior.kind == BehaviorKind::CHANGE_SPRITE) {
+                int typeIndex = entry.behavior.typeIndex < snapshotTypeRemap.size()
+                                    ? snapshotTypeRemap[entry.behavior.typeIndex] : -1;
+                if (typeIndex < 0) {
+                    LOG_ERROR("BulletManager: behavior references unknown bullet type");
+                    return false;
+                }
+                entry.behavior.typeIndex = static_cast<uint16_t>(typeIndex);
+            }
+            entries.push_back(entry);
+        }
+    }
+
+    uint64_t peak = 0;
+    uint64_t total = 0;
+    reader.Read(peak);
+    reader.Read(total);
+    peakActiveCount = static_cast<size_t>(peak);
+    totalCreatedCount = static_cast<size_t>(total);
+
+    return !reader.HasFailed();
+}
@@ -9,18 +9,65 @@
 #ifndef BULLETMANAGER_H
 #define BULLETMANAGER_H
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <vector>
 #include <memory>
-#include <queue>
-#include <unordered_set>
+#include "../bullet/BulletBehavior.h"
 #include "../bullet/BulletFactory.h"
+#include "../bullet/BulletTargets.h"
+#include "../bullet/Laser.h"
 #include "../entity/BulletBase.h"
 #include "../entity/EntityBase.h"
 #include "../graphics/Renderer.h"
+#include "../graphics/RenderQueue.h"
+
+class SelfMachineBase;
+class StateWriter;
+class StateReader;
+
+/**
+ * 批量清弹区域（炸弹、Boss 转阶段等），按子弹碰撞体圆心判断是否在区域内
+ */
+struct BulletClearRegion {
+    enum class Shape : uint8_t {
+        SCREEN,     // 整屏：所有活跃子弹
+        CIRCLE,     // 圆形：圆心 (x, y)，半径 radius
+        RECT        // 矩形：左上角 (x, y)，尺寸 width x height
+    };
+
+    Shape shape = Shape::SCREEN;
+    float x = 0.0f, y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+    float radius = 0.0f;
+
+    static BulletClearRegion Screen() { return {}; }
+    static BulletClearRegion Circle(float centerX, float centerY, float radius) {
+        return {Shape::CIRCLE, centerX, centerY, 0.0f, 0.0f, radius};
+    }
+    static BulletClearRegion Rect(float left, float top, float width, float height) {
+        return {Shape::RECT, left, top, width, height, 0.0f};
+    }
+};
+
+// 清弹的归属过滤（位掩码）
+namespace BulletClearOwner {
+    constexpr uint8_t PLAYER = 1 << 0;
+    constexpr uint8_t ENEMY  = 1 << 1;
+    constexpr uint8_t ALL    = PLAYER | ENEMY;
+}
 
 /**
  * 基于对象池的子弹管理器
  * 负责高效创建、更新、渲染和销毁所有子弹，以及处理碰撞检测
+ *
+ * 活跃子弹按生成顺序保存在连续数组中（附带池索引），更新、碰撞、渲染的遍历顺序
+ * 与内存地址无关，保证同样的输入得到同样的结果，快照恢复后也能逐位一致
+ *
+ * 子弹行为（延迟加速、分裂、反弹、环绕、换外观）不挂在子弹对象上，而是按种类分表保存
+ * （池索引 + 参数）：每种行为一个批处理循环，只遍历使用它的子弹，普通子弹不付出任何开销。
+ * 内置行为无法表达的逻辑仍可用 SetCustomUpdate 挂回调，作为显式的慢路径
  */
 class BulletManager {
 public:
@@ -30,68 +77,235 @@ public:
     // 初始化管理器
     bool Initialize(const std::string& configDir, Renderer& renderer);
 
-    // 更新所有子弹
+    // 更新所有子弹（追踪弹先按目标快照转向）
     void Update(float deltaTime);
 
-    // 渲染所有子弹
-    void Render(Renderer* renderer);
+    // 瞄准目标快照：每 tick 在发射和移动之前由游戏逻辑重建一次
+    BulletTargets& GetTargets() { return targets; }
+    const BulletTargets& GetTargets() const { return targets; }
+
+    // 提交所有子弹到渲染队列（普通子弹按层/混合模式/贴图合批，激光在激光层单独绘制）
+    void Submit(RenderQueue& queue) const;
 
     // 重置子弹状态以便重用
     void ResetBulletState(BulletBase* bullet, BulletOwner owner, float x, float y);
 
 
-    // 从对象池获取并创建子弹
+    // 从对象池获取并创建子弹（配置中的行为随之挂上）
     BulletBase* CreateBullet(const std::string& bulletType,
                             BulletOwner owner,
                             float x, float y);
 
-    // 回收子弹到对象池
+    // 按类型编号创建（分裂等运行时生成的路径，不查找字符串）
+    BulletBase* CreateBullet(uint16_t typeIndex, BulletOwner owner, float x, float y);
+
+    // 给活跃子弹追加一个内置行为（同一子弹可挂多个）
+    void AddBehavior(BulletBase* bullet, const BulletBehavior& behavior);
+
+    // 慢路径：每 tick 在内置行为之后调用一次的自定义回调（传 nullptr 移除）
+    // 回调无法写入快照，LoadState 后会被清空
+    void SetCustomUpdate(BulletBase* bullet, std::function<void(BulletBase*, float)> update);
+
+    // 回收子弹到对象池（立即失效，池索引在下一次 Update 压缩活跃列表时归还）
     void RecycleBullet(BulletBase* bullet);
 
     // 清除所有活跃子弹（保留在池中）
     void ClearActiveBullets();
 
+    // 区域清弹：一次遍历回收区域内、归属匹配的子弹并立即归还池索引，返回清除数量
+    // clearedPositions 非空时追加被清除子弹的圆心（调用方复用缓冲区，用于转换成道具）
+    size_t ClearBullets(const BulletClearRegion& region, uint8_t ownerMask,
+                        std::vector<SDL_FPoint>* clearedPositions = nullptr);
+
     // 碰撞检测 - 检测子弹与实体的碰撞
     void CheckCollisions(std::vector<std::shared_ptr<EntityBase>>& entities);
 
+    // 敌机碰撞：每 tick 先收集一次自机弹缓存，再对每个敌机调用 CheckEnemyCollisions
+    // 敌弹对敌机没有效果，不进入缓存；圆形自机弹对圆形敌机走 SoA 距离循环，其余碰撞体走通用检测
+    void BuildEnemyCollisionCache();
+    void CheckEnemyCollisions(EntityBase* enemy);
+
+    // 自机碰撞 + 擦弹：每 tick 先收集一次敌弹缓存，再对每个自机调用 CheckPlayerCollisions
+    // 判定与擦弹在同一遍历中完成，擦过的子弹置 BulletFlag::GRAZED，只计一次
+    // 激光单独成表：包围盒粗筛后按中心线距离判定，判定宽度为 width * hitboxScale
+    // obb 敌弹也单独成表，与圆弹一样走无分支的融合循环
+    // 出现阶段等带 BulletFlag::NO_COLLISION 位的子弹在收集缓存时整体跳过，融合循环里没有额外判断
+    void BuildPlayerCollisionCache();
+    void CheckPlayerCollisions(SelfMachineBase* player);
+
     // 获取指定归属的所有子弹
     std::vector<BulletBase*> GetActiveBulletsByOwner(BulletOwner owner);
 
     // 获取当前活动子弹数量
     size_t GetActiveBulletCount() const;
 
+    // 状态快照：池大小、类型表、活跃子弹（池索引 + 运行状态）与空闲队列顺序
+    void SaveState(StateWriter& writer) const;
+    bool LoadState(StateReader& reader);
+
     // 获取子弹工厂（用于查询子弹类型等）
     const BulletFactory* GetBulletFactory() const;
 
     // 性能统计
     size_t GetPoolSize() const;
     size_t GetAvailableBulletCount() const;
+    size_t GetPeakActiveCount() const { return peakActiveCount; }
+    size_t GetTotalCreatedCount() const { return totalCreatedCount; }
+    int GetSpawnMetric() const { return spawnMetric; }
+    int GetPoolGrowthMetric() const { return poolGrowthMetric; }
+    size_t GetActiveLaserTrailCount() const { return laserTrails.size() - freeLaserSlots.size(); }
+    size_t GetBehaviorCount(BehaviorKind kind) const { return behaviors[static_cast<size_t>(kind)].size(); }
+    size_t GetCustomUpdateCount() const { return customUpdates.size(); }
+
+    // 同时存在的曲线激光上限（轨迹缓冲在初始化时一次性分配）
+    static constexpr size_t MAX_LASER_TRAILS = 256;
+
+    // 游戏区域尺寸（出界回收、反弹、环绕的边界）
+    static constexpr float FIELD_WIDTH = 800.0f;
+    static constexpr float FIELD_HEIGHT = 600.0f;
 
 private:
+    // 行为表条目：子弹用池索引引用，条目本身平凡可复制，快照整块写入
+    struct BehaviorEntry {
+        uint32_t poolIndex;
+        BulletBehavior behavior;
+    };
+
+    struct CustomUpdateEntry {
+        uint32_t poolIndex;
+        std::function<void(BulletBase*, float)> update;
+    };
+
+    // 按种类执行行为表，完成的条目原地移除
+    void RunBehaviors(float deltaTime);
+    bool RunDelayAccelerate(BulletBase* bullet, BulletBehavior& behavior, float deltaTime);
+    bool RunSplit(BulletBase* bullet, BulletBehavior& behavior);
+    bool RunBounce(BulletBase* bullet, BulletBehavior& behavior);
+    bool RunWrap(BulletBase* bullet, BulletBehavior& behavior);
+    bool RunChangeSprite(BulletBase* bullet, BulletBehavior& behavior);
+
+    // 移除已归还池中的子弹的行为条目（池索引被复用之前必须执行）
+    void PurgeBehaviors();
+
     // 初始化对象池
     bool InitializeObjectPool(size_t size);
 
     // 扩展对象池
     bool ExpandObjectPool(size_t additionalSize);
 
-    // 从池中获取可用子弹
-    BulletBase* GetBulletFromPool();
+    // 从池中获取可用子弹的索引，池空返回 false
+    bool AcquirePoolIndex(size_t& index);
+
+    // 离开活跃列表的子弹归还池索引，曲线激光同时归还轨迹槽位
+    void ReturnToPool(BulletBase* bullet, size_t poolIndex);
+
+    // 为曲线激光分配轨迹槽位，槽位用完返回 false
+    bool AttachLaserTrail(BulletBase* bullet);
 
     // 碰撞检测辅助函数
     void CheckBulletEntityCollisions(BulletBase* bullet,
                                      std::vector<std::shared_ptr<EntityBase>>& entities);
+
+    // 单个子弹与单个实体的碰撞，命中时调用双方回调，返回是否命中
+    bool CheckBulletEntityCollision(BulletBase* bullet, EntityBase* entity);
+    
+    // 处理自机与子弹的一次接触：命中调用双方回调，否则记为擦弹
+    // cachedGrazed 非空时同步写回缓存中的擦弹标记，后续自机的遍历不再重复计数
+    void ResolvePlayerContact(SelfMachineBase* player, BulletBase* bullet, bool hit, uint8_t* cachedGrazed);
     
     // 子弹碰撞检测（可选，通常子弹之间不碰撞）
     void CheckBulletBulletCollisions();
 
+    /**
+     * 空闲索引的环形队列（先进先出）
+     * 容量按最大池大小一次分配，整屏清弹时大量归还索引也不会分配内存
+     */
+    class IndexQueue {
+    public:
+        void reserve(size_t capacity) { if (capacity > ring.size()) Grow(capacity); }
+        bool empty() const { return count == 0; }
+        size_t size() const { return count; }
+        size_t front() const { return ring[head]; }
+        size_t operator[](size_t i) const { return ring[(head + i) % ring.size()]; }
+        void clear() { head = 0; count = 0; }
+        void pop_front() { head = (head + 1) % ring.size(); count--; }
+        void push_back(size_t index) {
+            if (count == ring.size()) Grow(std::max<size_t>(16, ring.size() * 2));
+            ring[(head + count) % ring.size()] = index;
+            count++;
+        }
+
+    private:
+        void Grow(size_t capacity) {
+            std::vector<size_t> grown(capacity);
+            for (size_t i = 0; i < count; ++i) grown[i] = (*this)[i];
+            ring.swap(grown);
+            head = 0;
+        }
+
+        std::vector<size_t> ring;
+        size_t head = 0;
+        size_t count = 0;
+    };
+
     // 对象池管理
     std::vector<std::unique_ptr<BulletBase>> bulletPool;  // 对象池
-    std::queue<size_t> availableIndices;                  // 可用对象索引队列
-    std::unordered_set<BulletBase*> activeBullets;       // 活跃子弹集合
+    IndexQueue availableIndices;                          // 可用对象索引队列（先进先出，顺序写入快照）
+    std::vector<BulletBase*> activeBullets;               // 活跃子弹（保持生成顺序）
+    std::vector<size_t> activePoolIndices;                // 与 activeBullets 对应的池索引
+
+    // 自机碰撞缓存（SoA）：圆形敌弹的圆心、半径、擦弹标记，按最大池大小预留
+    struct PlayerCollisionCache {
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> radius;
+        std::vector<uint8_t> grazed;
+        std::vector<uint8_t> result;         // 融合循环的输出位
+        std::vector<BulletBase*> bullets;    // 前 centerX.size() 个与上面对应，其后为其它碰撞体的敌弹
+        std::vector<BulletBase*> lasers;     // 有判定的敌方激光
+
+        // obb 敌弹：中心、朝向单位向量、半宽高
+        std::vector<float> boxCenterX;
+        std::vector<float> boxCenterY;
+        std::vector<float> boxCos;
+        std::vector<float> boxSin;
+        std::vector<float> boxHalfWidth;
+        std::vector<float> boxHalfHeight;
+        std::vector<uint8_t> boxGrazed;
+        std::vector<uint8_t> boxResult;
+        std::vector<BulletBase*> boxBullets;
+    };
+    PlayerCollisionCache playerCache;
+
+    // 敌机碰撞缓存（SoA）：有判定的圆形自机弹，其余碰撞体（激光、obb、矩形）的自机弹单独成表
+    struct EnemyCollisionCache {
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> radius;
+        std::vector<BulletBase*> bullets;
+        std::vector<BulletBase*> others;
+    };
+    EnemyCollisionCache enemyCache;
+
+    // 曲线激光轨迹缓冲池与空闲槽位栈
+    std::vector<LaserTrail> laserTrails;
+    std::vector<uint16_t> freeLaserSlots;
+
+    // 行为表（每种行为一张，按最大池大小预留）与自定义回调表
+    std::array<std::vector<BehaviorEntry>, static_cast<size_t>(BehaviorKind::COUNT)> behaviors;
+    std::vector<CustomUpdateEntry> customUpdates;
+    bool behaviorsDirty;    // 有挂行为的子弹归还了池索引，等待 PurgeBehaviors
+
+    // 本 tick 的瞄准目标
+    BulletTargets targets;
 
     // 子弹工厂
     std::unique_ptr<BulletFactory> bulletFactory;
 
+    // 恢复快照时复用的缓冲：快照类型编号 -> 当前类型编号，以及读取类型名的字符串
+    std::vector<int> snapshotTypeRemap;
+    std::string snapshotTypeName;
+
     // 对象池配置
     size_t initialPoolSize;
     float expandFactor;
@@ -100,9 +314,11 @@ private:
     // 初始化状态
     bool initialized;
     
-    // 性能统计
+    // 性能统计（快照保存）与运行期指标编号（MetricsRegistry，-1 表示未注册）
     size_t peakActiveCount;
     size_t totalCreatedCount;
+    int spawnMetric;
+    int poolGrowthMetric;
 };
 
 #endif // BULLETMANAGER_H
@@ -0,0 +1,385 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "EnemyManager.h"
+#include "BulletManager.h"
+#include "../bullet/BulletTargets.h"
+#include "ItemManager.h"
+#include "../enemy/EnemyConfigParser.h"
+#include "../snapshot/StateBuffer.h"
+#include "../gamecore/FrameProfiler.h"
+#include "../gamecore/Logger.h"
+#include "../gamecore/Metrics.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+EnemyManager::EnemyManager(size_t initialSize)
+    : bulletManager(nullptr),
+      itemManager(nullptr),
+      random(nullptr),
+      targetX(0.0f),
+      targetY(0.0f),
+      initialPoolSize(initialSize),
+      maxPoolSize(2048),
+      initialized(false),
+      peakActiveCount(0),
+      totalSpawnedCount(0),
+      poolGrowthMetric(-1) {
+}
+
+EnemyManager::~EnemyManager() = default;
+
+bool EnemyManager::Initialize(const std::string& configDir, Renderer& renderer, BulletManager* bullets) {
+    if (initialized) {
+        std::cerr << "EnemyManager already initialized" << std::endl;
+        return false;
+    }
+
+    poolGrowthMetric = MetricsRegistry::Instance().AddCounter("enemy_pool_growths");
+
+    if (!LoadConfigs(configDir, renderer)) {
+        std::cerr << "Failed to load enemy configs from: " << configDir << std::endl;
+        return false;
+    }
+
+    bulletManager = bullets;
+
+    // 按id顺序分配类型编号（map 已排序）
+    resourcesByIndex.clear();
+    for (auto& pair : enemyResources) {
+        pair.second.config->typeIndex = static_cast<uint16_t>(resourcesByIndex.size());
+        resourcesByIndex.push_back(&pair.second);
+    }
+    snapshotTypeRemap.reserve(resourcesByIndex.size());
+
+    // 活跃列表按最大池大小预留，扩池时也不会重新分配
+    activeEnemies.reserve(maxPoolSize);
+    activePoolIndices.reserve(maxPoolSize);
+    availableIndices.reserve(maxPoolSize);
+
+    if (!ExpandObjectPool(initialPoolSize)) {
+        std::cerr << "Failed to initialize enemy object pool" << std::endl;
+        return false;
+    }
+
+    initialized = true;
+    std::cout << "EnemyManager initialized with pool size: " << enemyPool.size() << std::endl;
+    return true;
+}
+
+bool EnemyManager::LoadConfigs(const std::string& configDir, Renderer& renderer) {
+    if (!std::filesystem::exists(configDir)) {
+        std::cerr << "Config directory does not exist: " << configDir << std::endl;
+        return false;
+    }
+
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    for (const auto& file : std::filesystem::directory_iterator(configDir)) {
+        if (file.path().extension() == ".json") {
+            double loadBegin = profiler.Now();
+            bool loadedFile = LoadConfigFile(file.path().string(), renderer);
+            profiler.Mark(FrameMarker::CONFIG_LOAD, profiler.Now() - loadBegin, file.path().filename().string().c_str());
+            if (!loadedFile) {
+                std::cerr << "Failed to load config file: " << file.path() << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return !enemyResources.empty();
+}
+
+bool EnemyManager::LoadConfigFile(const std::string& filePath, Renderer& renderer) {
+    EnemyConfig config;
+    if (!EnemyConfigParser::LoadFromFile(filePath, config)) {
+        return false;
+    }
+
+    if (config.id.empty()) {
+        return false;
+    }
+
+    EnemyResources resources;
+    resources.config = std::make_shared<EnemyConfig>(std::move(config));
+
+    // 贴图缺失时仍可用占位方块运行
+    if (!resources.config->texture.empty()) {
+        resources.sprite = LoadAndCacheTexture(resources.config->texture, renderer);
+    }
+
+    enemyResources[resources.config->id] = resources;
+    return true;
+}
+
+std::shared_ptr<Sprite> EnemyManager::LoadAndCacheTexture(const std::string& texturePath, Renderer& renderer) {
+    auto it = textureCache.find(texturePath);
+    if (it != textureCache.end()) {
+        return it->second;
+    }
+
+    auto sprite = std::make_shared<Sprite>();
+    if (!sprite->LoadFromFile(texturePath, renderer)) {
+        std::cerr << "Failed to load texture from: " << texturePath << std::endl;
+        return nullptr;
+    }
+
+    textureCache[texturePath] = sprite;
+    return sprite;
+}
+
+bool EnemyManager::ExpandObjectPool(size_t additionalSize) {
+    size_t oldSize = enemyPool.size();
+    size_t newSize = oldSize + additionalSize;
+
+    if (additionalSize == 0 || newSize > maxPoolSize) {
+        LOG_WARN("Cannot expand enemy pool beyond max size: {}", maxPoolSize);
+        return false;
+    }
+
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    double expandBegin = profiler.Now();
+    enemyPool.reserve(newSize);
+    for (size_t i = oldSize; i < newSize; ++i) {
+        enemyPool.push_back(std::make_unique<EnemyBase>());
+    }
+
+    // 逆序入栈，保证小索引先被取出
+    for (size_t i = newSize; i > oldSize; --i) {
+        availableIndices.push_back(i - 1);
+    }
+
+    char label[32];
+    std::snprintf(label, sizeof(label), "enemies %zu->%zu", oldSize, newSize);
+    profiler.Mark(FrameMarker::POOL_EXPANSION, profiler.Now() - expandBegin, label);
+
+    if (oldSize > 0) {
+        MetricsRegistry::Instance().Increment(poolGrowthMetric);
+        LOG_INFO("Expanded enemy pool from {} to {}", oldSize, newSize);
+    }
+    return true;
+}
+
+EnemyBase* EnemyManager::SpawnEnemy(const std::string& enemyType, float x, float y) {
+    if (!initialized) {
+        LOG_WARN("EnemyManager not initialized");
+        return nullptr;
+    }
+
+    auto it = enemyResources.find(enemyType);
+    if (it == enemyResources.end()) {
+        LOG_WARN("Enemy type not found: {}", enemyType);
+        return nullptr;
+    }
+
+    if (availableIndices.empty()) {
+        if (!ExpandObjectPool(enemyPool.size() / 2) || availableIndices.empty()) {
+            LOG_WARN("Enemy pool exhausted");
+            return nullptr;
+        }
+    }
+
+    size_t index = availableIndices.back();
+    availableIndices.pop_back();
+
+    EnemyBase* enemy = enemyPool[index].get();
+    enemy->InitializeFromConfig(it->second.config.get(), it->second.sprite);
+    enemy->Spawn(x, y);
+
+    activeEnemies.push_back(enemy);
+    activePoolIndices.push_back(index);
+
+    totalSpawnedCount++;
+    if (activeEnemies.size() > peakActiveCount) {
+        peakActiveCount = activeEnemies.size();
+    }
+
+    return enemy;
+}
+
+void EnemyManager::Update(float deltaTime) {
+    if (!initialized) return;
+
+    // 原地压缩：存活的敌人前移，死亡/走完路径的敌人索引归还池中
+    size_t writeIndex = 0;
+    for (size_t readIndex = 0; readIndex < activeEnemies.size(); ++readIndex) {
+        EnemyBase* enemy = activeEnemies[readIndex];
+
+        if (enemy->IsActive()) {
+            enemy->Update(deltaTime);
+            enemy->UpdatePatterns(bulletManager, targetX, targetY, random);
+        }
+
+        if (!enemy->IsActive() || enemy->ShouldDespawn()) {
+            if (enemy->IsKilled()) {
+                SpawnDrops(enemy);
+            }
+            enemy->SetActive(false);
+            availableIndices.push_back(activePoolIndices[readIndex]);
+            continue;
+        }
+
+        activeEnemies[writeIndex] = enemy;
+        activePoolIndices[writeIndex] = activePoolIndices[readIndex];
+        writeIndex++;
+    }
+
+    activeEnemies.resize(writeIndex);
+    activePoolIndices.resize(writeIndex);
+}
+
+void EnemyManager::SpawnDrops(const EnemyBase* enemy) {
+    const EnemyConfig* config = enemy->GetConfig();
+    if (!itemManager || !config) return;
+
+    const float x = enemy->GetCenterX();
+    const float y = enemy->GetCenterY();
+    itemManager->SpawnItemBurst(ItemType::POWER, x, y, static_cast<size_t>(config->drops.power));
+    itemManager->SpawnItemBurst(ItemType::POINT, x, y, static_cast<size_t>(config->drops.point));
+    itemManager->SpawnItemBurst(ItemType::BOMB, x, y, static_cast<size_t>(config->drops.bomb));
+    itemManager->SpawnItemBurst(ItemType::LIFE, x, y, static_cast<size_t>(config->drops.life));
+}
+
+void EnemyManager::Submit(RenderQueue& queue) const {
+    if (!initialized) return;
+
+    for (const EnemyBase* enemy : activeEnemies) {
+        enemy->Submit(queue);
+    }
+}
+
+void EnemyManager::CheckCollisions(BulletManager* bullets) {
+    if (!initialized || !bullets) return;
+
+    // 自机弹每 tick 只收集一次，每个敌机只与自机弹检测
+    bullets->BuildEnemyCollisionCache();
+    for (EnemyBase* enemy : activeEnemies) {
+        if (enemy->IsActive()) {
+            bullets->CheckEnemyCollisions(enemy);
+        }
+    }
+}
+
+void EnemyManager::CollectTargets(BulletTargets& targets) const {
+    for (const EnemyBase* enemy : activeEnemies) {
+        if (enemy->IsActive() && !enemy->IsKilled()) {
+            targets.AddEnemy(enemy->GetCenterX(), enemy->GetCenterY());
+        }
+    }
+}
+
+void EnemyManager::ClearActiveEnemies() {
+    for (size_t i = 0; i < activeEnemies.size(); ++i) {
+        activeEnemies[i]->SetActive(false);
+        availableIndices.push_back(activePoolIndices[i]);
+    }
+    activeEnemies.clear();
+    activePoolIndices.clear();
+}
+
+void EnemyManager::SaveState(StateWriter& writer) const {
+    writer.Write(static_cast<uint32_t>(enemyPool.size()));
+
+    // 类型表只写一次，恢复时按名称重新映射编号；每个敌人只写编号
+    writer.Write(static_cast<uint32_t>(resourcesByIndex.size()));
+    for (const EnemyResources* resources : resourcesByIndex) {
+        writer.WriteString(resources->config->id);
+    }
+
+    writer.Write(static_cast<uint32_t>(activeEnemies.size()));
+    for (size_t i = 0; i < activeEnemies.size(); ++i) {
+        const EnemyBase* enemy = activeEnemies[i];
+        writer.Write(static_cast<uint32_t>(activePoolIndices[i]));
+        writer.Write(enemy->GetConfig() ? enemy->GetConfig()->typeIndex : static_cast<uint16_t>(0));
+        enemy->SaveState(writer);
+    }
+
+    // 空闲栈顺序决定之后生成时取到哪个池槽位，必须原样保存
+    writer.Write(static_cast<uint32_t>(availableIndices.size()));
+    for (size_t index : availableIndices) {
+        writer.Write(static_cast<uint32_t>(index));
+    }
+
+    writer.Write(static_cast<uint64_t>(peakActiveCount));
+    writer.Write(static_cast<uint64_t>(totalSpawnedCount));
+}
+
+bool EnemyManager::LoadState(StateReader& reader) {
+    if (!initialized) return false;
+
+    ClearActiveEnemies();
+
+    uint32_t poolSize = 0;
+    reader.Read(poolSize);
+    if (reader.HasFailed() || poolSize > maxPoolSize) return false;
+    if (poolSize > enemyPool.size() && !ExpandObjectPool(poolSize - enemyPool.size())) {
+        return false;
+    }
+
+    // 快照类型编号 -> 当前类型编号（每个类型查一次表，缓冲复用，不产生分配）
+    uint32_t typeCount = 0;
+    reader.Read(typeCount);
+    snapshotTypeRemap.clear();
+    for (uint32_t i = 0; i < typeCount && !reader.HasFailed(); ++i) {
+        reader.ReadString(snapshotTypeName);
+        auto it = enemyResources.find(snapshotTypeName);
+        snapshotTypeRemap.push_back(it != enemyResources.end() ? it->second.config->typeIndex : -1);
+    }
+
+    uint32_t activeCount = 0;
+    reader.Read(activeCount);
+    for (uint32_t i = 0; i < activeCount && !reader.HasFailed(); ++i) {
+        uint32_t poolIndex = 0;
+        uint16_t snapshotType = 0;
+        reader.Read(poolIndex);
+        reader.Read(snapshotType);
+
+        int typeIndex = snapshotType < snapshotTypeRemap.size() ? snapshotTypeRemap[snapshotType] : -1;
+        if (reader.HasFailed() || poolIndex >= enemyPool.size() || typeIndex < 0) {
+            LOG_ERROR("EnemyManager: invalid enemy in snapshot (type {})", snapshotType);
+            return false;
+        }
+
+        const EnemyResources* resources = resourcesByIndex[typeIndex];
+        EnemyBase* enemy = enemyPool[poolIndex].get();
+        enemy->InitializeFromConfig(resources->config.get(), resources->sprite);
+        enemy->LoadState(reader);
+
+        activeEnemies.push_back(enemy);
+        activePoolIndices.push_back(poolIndex);
+    }
+
+    uint32_t availableCount = 0;
+    reader.Read(availableCount);
+    availableIndices.clear();
+    for (uint32_t i = 0; i < availableCount && !reader.HasFailed(); ++i) {
+        uint32_t index = 0;
+        reader.Read(index);
+        availableIndices.push_back(index);
+    }
+
+    uint64_t peak = 0;
+    uint64_t total = 0;
+    reader.Read(peak);
+    reader.Read(total);
+    peakActiveCount = static_cast<size_t>(peak);
+    totalSpawnedCount = static_cast<size_t>(total);
+
+    return !reader.HasFailed();
+}
+
+void EnemyManager::SetTargetPosition(float x, float y) {
+    targetX = x;
+    targetY = y;
+}
+
+bool EnemyManager::HasEnemyType(const std::string& enemyType) const {
+    return enemyResources.find(enemyType) != enemyResources.end();
+}
+
+const EnemyConfig* EnemyManager::GetEnemyConfig(const std::string& enemyType) const {
+    auto it = enemyResources.find(enemyType);
+    return (it != enemyResources.end()) ? it->second.config.get() : nullptr;
+}
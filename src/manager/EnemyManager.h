@@ -0,0 +1,126 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef ENEMYMANAGER_H
+#define ENEMYMANAGER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../enemy/EnemyConfig.h"
+#include "../entity/EnemyBase.h"
+#include "../graphics/Renderer.h"
+#include "../graphics/RenderQueue.h"
+#include "../graphics/Sprite.h"
+
+class BulletManager;
+class BulletTargets;
+class ItemManager;
+class Random;
+class StateWriter;
+class StateReader;
+
+/**
+ * 基于对象池的敌人管理器（与 BulletManager 对应）
+ * 负责加载敌人配置、按需生成、批量更新/渲染以及与自机子弹的碰撞
+ *
+ * 池和活跃列表在初始化时一次性预留，波次中生成/回收敌人不产生动态分配
+ */
+class EnemyManager {
+public:
+    EnemyManager(size_t initialPoolSize = 256);
+    ~EnemyManager();
+
+    // 初始化：加载 configDir 下所有敌人配置，bulletManager 用于发射弹幕
+    bool Initialize(const std::string& configDir, Renderer& renderer, BulletManager* bulletManager);
+
+    // 以中心点生成敌人，失败返回nullptr
+    EnemyBase* SpawnEnemy(const std::string& enemyType, float x, float y);
+
+    // 批量更新：路径、弹幕脚本、回收
+    void Update(float deltaTime);
+
+    // 提交所有敌人到渲染队列（敌人层）
+    void Submit(RenderQueue& queue) const;
+
+    // 自机子弹与敌人的碰撞
+    void CheckCollisions(BulletManager* bulletManager);
+
+    // 把存活敌人的中心写入瞄准目标快照（自机追踪弹使用）
+    void CollectTargets(BulletTargets& targets) const;
+
+    // 回收所有活跃敌人
+    void ClearActiveEnemies();
+
+    // 状态快照：类型表、活跃敌人（池索引 + 类型编号 + 运行状态）与空闲栈顺序
+    void SaveState(StateWriter& writer) const;
+    bool LoadState(StateReader& reader);
+
+    // 设置自机狙的目标（自机中心）
+    void SetTargetPosition(float x, float y);
+
+    // 弹幕方向抖动使用的模拟随机数（由 Game 持有，随快照保存）
+    void SetRandom(Random* simulationRandom) { random = simulationRandom; }
+
+    // 击破掉落使用的道具池（可为空）
+    void SetItemManager(ItemManager* items) { itemManager = items; }
+
+    // 查询
+    bool HasEnemyType(const std::string& enemyType) const;
+    const EnemyConfig* GetEnemyConfig(const std::string& enemyType) const;
+    const std::vector<EnemyBase*>& GetActiveEnemies() const { return activeEnemies; }
+    size_t GetActiveEnemyCount() const { return activeEnemies.size(); }
+
+    // 性能统计
+    size_t GetPoolSize() const { return enemyPool.size(); }
+    size_t GetAvailableEnemyCount() const { return availableIndices.size(); }
+    size_t GetPeakActiveCount() const { return peakActiveCount; }
+
+private:
+    struct EnemyResources {
+        std::shared_ptr<EnemyConfig> config;
+        std::shared_ptr<Sprite> sprite;
+    };
+
+    bool LoadConfigs(const std::string& configDir, Renderer& renderer);
+    bool LoadConfigFile(const std::string& filePath, Renderer& renderer);
+    std::shared_ptr<Sprite> LoadAndCacheTexture(const std::string& texturePath, Renderer& renderer);
+
+    bool ExpandObjectPool(size_t additionalSize);
+
+    // 被击破的敌人在中心点散开掉落道具
+    void SpawnDrops(const EnemyBase* enemy);
+
+    // 对象池管理
+    std::vector<std::unique_ptr<EnemyBase>> enemyPool;
+    std::vector<size_t> availableIndices;    // 空闲索引（栈）
+    std::vector<EnemyBase*> activeEnemies;   // 活跃敌人（保持生成顺序）
+    std::vector<size_t> activePoolIndices;   // 与 activeEnemies 对应的池索引
+
+    // 配置与资源
+    std::map<std::string, EnemyResources> enemyResources;
+    std::map<std::string, std::shared_ptr<Sprite>> textureCache;
+    std::vector<const EnemyResources*> resourcesByIndex;    // 按类型编号索引
+
+    // 恢复快照时复用的缓冲：快照类型编号 -> 当前类型编号，以及读取类型名的字符串
+    std::vector<int> snapshotTypeRemap;
+    std::string snapshotTypeName;
+
+    BulletManager* bulletManager;
+    ItemManager* itemManager;
+    Random* random;
+    float targetX, targetY;
+
+    size_t initialPoolSize;
+    size_t maxPoolSize;
+    bool initialized;
+
+    // 性能统计
+    size_t peakActiveCount;
+    size_t totalSpawnedCount;
+    int poolGrowthMetric;     // MetricsRegistry 计数器编号
+};
+
+#endif //ENEMYMANAGER_H
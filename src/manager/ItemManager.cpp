@@ -0,0 +1,288 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "ItemManager.h"
+#include "../entity/SelfMachinesBase.h"
+#include "../snapshot/StateBuffer.h"
+#include "../gamecore/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 运动参数（像素/毫秒）：生成时先向上弹起，再加速下落到最大速度
+    constexpr float ITEM_SPAWN_VELOCITY = -0.12f;
+    constexpr float ITEM_GRAVITY = 0.0004f;
+    constexpr float ITEM_MAX_FALL_SPEED = 0.12f;
+    constexpr float ITEM_HORIZONTAL_DRAG = 0.004f;   // 水平速度每毫秒衰减比例
+    constexpr float ITEM_BURST_SPEED = 0.12f;        // 散开掉落的最大初速度
+    constexpr float ITEM_SIZE = 8.0f;
+
+    // 吸附与拾取
+    constexpr float ITEM_MAGNET_SPEED = 0.6f;
+    constexpr float ITEM_MAGNET_RADIUS = 32.0f;
+    constexpr float ITEM_MAGNET_RADIUS_FOCUS = 64.0f;
+    constexpr float ITEM_COLLECT_RADIUS = 16.0f;
+
+    // 结算
+    constexpr float ITEM_POWER_AMOUNT = 0.05f;
+    constexpr int64_t ITEM_POINT_MAX_VALUE = 10000;
+    constexpr int64_t ITEM_POINT_MIN_VALUE = 1000;
+
+    constexpr float GOLDEN_ANGLE = 2.39996323f;
+
+    // 占位颜色（按 ItemType 顺序）
+    constexpr SDL_Color ITEM_COLORS[] = {
+        {230, 60, 60, 255},     // POWER
+        {70, 110, 240, 255},    // POINT
+        {80, 210, 90, 255},     // BOMB
+        {230, 90, 220, 255},    // LIFE
+    };
+}
+
+ItemManager::ItemManager(size_t capacity)
+    : positionX(capacity),
+      positionY(capacity),
+      velocityX(capacity),
+      velocityY(capacity),
+      types(capacity),
+      targets(capacity),
+      capacity(capacity),
+      activeCount(0),
+      peakActiveCount(0),
+      totalCollectedCount(0),
+      bottomBound(600.0f),
+      collectLineY(150.0f) {
+}
+
+size_t ItemManager::SpawnAt(ItemType type, float x, float y, float vx, float vy) {
+    if (activeCount >= capacity) {
+        return 0;
+    }
+
+    size_t index = activeCount++;
+    positionX[index] = x;
+    positionY[index] = y;
+    velocityX[index] = vx;
+    velocityY[index] = vy;
+    types[index] = type;
+    targets[index] = NO_TARGET;
+    return 1;
+}
+
+bool ItemManager::SpawnItem(ItemType type, float x, float y) {
+    bool spawned = SpawnAt(type, x, y, 0.0f, ITEM_SPAWN_VELOCITY) == 1;
+    peakActiveCount = std::max(peakActiveCount, activeCount);
+    return spawned;
+}
+
+size_t ItemManager::SpawnItems(ItemType type, const SDL_FPoint* positions, size_t count) {
+    size_t spawnCount = std::min(count, capacity - activeCount);
+    for (size_t i = 0; i < spawnCount; ++i) {
+        SpawnAt(type, positions[i].x, positions[i].y, 0.0f, ITEM_SPAWN_VELOCITY);
+    }
+
+    peakActiveCount = std::max(peakActiveCount, activeCount);
+    return spawnCount;
+}
+
+size_t ItemManager::SpawnItemBurst(ItemType type, float x, float y, size_t count) {
+    size_t spawnCount = std::min(count, capacity - activeCount);
+
+    // 黄金角螺旋分布初速度：均匀散开且不消耗模拟随机数
+    for (size_t i = 0; i < spawnCount; ++i) {
+        float angle = GOLDEN_ANGLE * static_cast<float>(i);
+        float speed = ITEM_BURST_SPEED * std::sqrt((static_cast<float>(i) + 0.5f) / static_cast<float>(spawnCount));
+        SpawnAt(type, x, y, std::cos(angle) * speed, ITEM_SPAWN_VELOCITY + std::sin(angle) * speed);
+    }
+
+    peakActiveCount = std::max(peakActiveCount, activeCount);
+    return spawnCount;
+}
+
+void ItemManager::Update(float deltaTime, std::span<SelfMachineBase* const> players) {
+    // 取自机参数；不存在或已死亡的自机不参与拾取
+    const size_t collectorCount = std::min(players.size(), MAX_COLLECTORS);
+    for (size_t slot = 0; slot < MAX_COLLECTORS; ++slot) {
+        Collector& collector = collectors[slot];
+        collector = Collector{};
+        SelfMachineBase* player = slot < collectorCount ? players[slot] : nullptr;
+        if (!player || !player->IsAlive()) continue;
+
+        collector.player = player;
+        collector.x = player->GetCenterX();
+        collector.y = player->GetCenterY();
+        float magnetRadius = player->GetState() == PlayerState::FOCUS ? ITEM_MAGNET_RADIUS_FOCUS : ITEM_MAGNET_RADIUS;
+        collector.magnetRadiusSq = magnetRadius * magnetRadius;
+        collector.autoCollect = player->IsInBombMode() || collector.y < collectLineY;
+
+        // 回收线以上拿满点数，以下按高度线性递减
+        float below = std::clamp((collector.y - collectLineY) / std::max(1.0f, bottomBound - collectLineY), 0.0f, 1.0f);
+        collector.pointValue = ITEM_POINT_MAX_VALUE -
+            static_cast<int64_t>(static_cast<float>(ITEM_POINT_MAX_VALUE - ITEM_POINT_MIN_VALUE) * below);
+    }
+
+    // 自动回收：所有自由下落的道具吸附到该自机（先到的槽位优先）
+    for (size_t slot = 0; slot < MAX_COLLECTORS; ++slot) {
+        if (!collectors[slot].autoCollect) continue;
+        const uint8_t target = static_cast<uint8_t>(slot);
+        for (size_t i = 0; i < activeCount; ++i) {
+            targets[i] = targets[i] == NO_TARGET ? target : targets[i];
+        }
+    }
+
+    const float collectRadiusSq = ITEM_COLLECT_RADIUS * ITEM_COLLECT_RADIUS;
+    const float drag = std::min(1.0f, ITEM_HORIZONTAL_DRAG * deltaTime);
+    const float magnetStep = ITEM_MAGNET_SPEED * deltaTime;
+
+    // 移动、吸附、拾取与出界回收合为一次遍历，存活的道具原地前移
+    size_t writeIndex = 0;
+    for (size_t i = 0; i < activeCount; ++i) {
+        float x = positionX[i];
+        float y = positionY[i];
+        float vx = velocityX[i];
+        float vy = velocityY[i];
+        uint8_t target = targets[i];
+
+        // 吸附目标已不存在（死亡/离开）时恢复下落
+        if (target != NO_TARGET && !collectors[target].player) {
+            target = NO_TARGET;
+            vx = 0.0f;
+            vy = 0.0f;
+        }
+
+        if (target == NO_TARGET) {
+            vx -= vx * drag;
+            vy = std::min(vy + ITEM_GRAVITY * deltaTime, ITEM_MAX_FALL_SPEED);
+            x += vx * deltaTime;
+            y += vy * deltaTime;
+
+            for (size_t slot = 0; slot < MAX_COLLECTORS; ++slot) {
+                const Collector& collector = collectors[slot];
+                float dx = collector.x - x;
+                float dy = collector.y - y;
+                if (collector.player && dx * dx + dy * dy < collector.magnetRadiusSq) {
+                    target = static_cast<uint8_t>(slot);
+                    break;
+                }
+            }
+        }
+
+        if (target != NO_TARGET) {
+            // 匀速飞向自机，不超过目标点
+            Collector& collector = collectors[target];
+            float dx = collector.x - x;
+            float dy = collector.y - y;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            if (distance <= magnetStep) {
+                x = collector.x;
+                y = collector.y;
+            } else {
+                x += dx / distance * magnetStep;
+                y += dy / distance * magnetStep;
+            }
+
+            dx = collector.x - x;
+            dy = collector.y - y;
+            if (dx * dx + dy * dy < collectRadiusSq) {
+                collector.collected[static_cast<size_t>(types[i])]++;
+                continue;
+            }
+        }
+
+        if (y - ITEM_SIZE > bottomBound) {
+            continue;
+        }
+
+        positionX[writeIndex] = x;
+        positionY[writeIndex] = y;
+        velocityX[writeIndex] = vx;
+        velocityY[writeIndex] = vy;
+        types[writeIndex] = types[i];
+        targets[writeIndex] = target;
+        writeIndex++;
+    }
+    activeCount = writeIndex;
+
+    for (const Collector& collector : collectors) {
+        if (collector.player) {
+            ApplyCollected(collector);
+        }
+    }
+}
+
+void ItemManager::ApplyCollected(const Collector& collector) {
+    SelfMachineBase* player = collector.player;
+    uint32_t power = collector.collected[static_cast<size_t>(ItemType::POWER)];
+    uint32_t point = collector.collected[static_cast<size_t>(ItemType::POINT)];
+    uint32_t bomb = collector.collected[static_cast<size_t>(ItemType::BOMB)];
+    uint32_t life = collector.collected[static_cast<size_t>(ItemType::LIFE)];
+
+    // 同种道具合并结算，几千个点数道具也只调用一次
+    if (power > 0) {
+        player->AddPower(ITEM_POWER_AMOUNT * static_cast<float>(power));
+    }
+    if (point > 0) {
+        player->AddScore(collector.pointValue * point);
+    }
+    for (uint32_t i = 0; i < bomb; ++i) {
+        player->AddBomb();
+    }
+    for (uint32_t i = 0; i < life; ++i) {
+        player->AddLife();
+    }
+
+    totalCollectedCount += power + point + bomb + life;
+}
+
+void ItemManager::Submit(RenderQueue& queue) const {
+    // 占位方块没有贴图，颜色写在顶点里，所有种类合成一次绘制调用
+    for (size_t i = 0; i < activeCount; ++i) {
+        queue.SubmitQuad(RenderLayer::ITEMS, 0, nullptr, nullptr, positionX[i], positionY[i], ITEM_SIZE, ITEM_SIZE,
+                         0.0f, ITEM_COLORS[static_cast<size_t>(types[i])], BlendMode::ALPHA);
+    }
+}
+
+void ItemManager::SaveState(StateWriter& writer) const {
+    writer.Write(static_cast<uint32_t>(activeCount));
+    writer.WriteBytes(positionX.data(), activeCount * sizeof(float));
+    writer.WriteBytes(positionY.data(), activeCount * sizeof(float));
+    writer.WriteBytes(velocityX.data(), activeCount * sizeof(float));
+    writer.WriteBytes(velocityY.data(), activeCount * sizeof(float));
+    writer.WriteBytes(types.data(), activeCount * sizeof(ItemType));
+    writer.WriteBytes(targets.data(), activeCount * sizeof(uint8_t));
+    writer.Write(static_cast<uint64_t>(peakActiveCount));
+    writer.Write(totalCollectedCount);
+}
+
+bool ItemManager::LoadState(StateReader& reader) {
+    uint32_t count = 0;
+    reader.Read(count);
+    if (reader.HasFailed() || count > capacity) {
+        LOG_ERROR("ItemManager: incompatible item snapshot");
+        return false;
+    }
+
+    reader.ReadBytes(positionX.data(), count * sizeof(float));
+    reader.ReadBytes(positionY.data(), count * sizeof(float));
+    reader.ReadBytes(velocityX.data(), count * sizeof(float));
+    reader.ReadBytes(velocityY.data(), count * sizeof(float));
+    reader.ReadBytes(types.data(), count * sizeof(ItemType));
+    reader.ReadBytes(targets.data(), count * sizeof(uint8_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        if (targets[i] >= MAX_COLLECTORS) targets[i] = NO_TARGET;
+    }
+
+    uint64_t peak = 0;
+    reader.Read(peak);
+    reader.Read(totalCollectedCount);
+    if (reader.HasFailed()) {
+        activeCount = 0;
+        return false;
+    }
+
+    activeCount = count;
+    peakActiveCount = static_cast<size_t>(peak);
+    return true;
+}
@@ -0,0 +1,112 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef ITEMMANAGER_H
+#define ITEMMANAGER_H
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <SDL3/SDL.h>
+#include "../graphics/RenderQueue.h"
+
+class SelfMachineBase;
+class StateWriter;
+class StateReader;
+
+// 道具种类（与 EntityType::ITEM_* 对应）
+enum class ItemType : uint8_t {
+    POWER,
+    POINT,
+    BOMB,
+    LIFE,
+    COUNT
+};
+
+/**
+ * 基于固定容量 SoA 池的道具管理器
+ * 道具只有位置、速度、种类和吸附目标，不建实体对象：活跃道具紧密排列在 [0, activeCount)，
+ * 容量在构造时一次性分配，批量生成/拾取不产生动态分配，池满时多出的道具直接丢弃
+ *
+ * 每 tick 一次遍历完成：下落、吸附（靠近自机 / 自机在回收线以上 / 放炸弹时全屏吸附）、
+ * 拾取判定与原地压缩；拾取结果按自机和种类累计，遍历结束后一次性结算到自机
+ */
+class ItemManager {
+public:
+    // 参与拾取的自机槽位数（双人合作）
+    static constexpr size_t MAX_COLLECTORS = 2;
+
+    explicit ItemManager(size_t capacity = 10000);
+
+    // 生成单个道具（中心点），池满返回 false
+    bool SpawnItem(ItemType type, float x, float y);
+
+    // 批量生成（如清弹转换），返回实际生成的数量
+    size_t SpawnItems(ItemType type, const SDL_FPoint* positions, size_t count);
+
+    // 从一点向四周散开生成 count 个道具（敌人/Boss 掉落），返回实际生成的数量
+    size_t SpawnItemBurst(ItemType type, float x, float y, size_t count);
+
+    // 下落、吸附、拾取与出界回收；players 按槽位排列，可含 nullptr
+    void Update(float deltaTime, std::span<SelfMachineBase* const> players);
+
+    // 提交到渲染队列（道具层）
+    void Submit(RenderQueue& queue) const;
+
+    // 回收所有道具
+    void Clear() { activeCount = 0; }
+
+    // 状态快照：活跃道具按顺序整块写入
+    void SaveState(StateWriter& writer) const;
+    bool LoadState(StateReader& reader);
+
+    // 统计
+    size_t GetActiveCount() const { return activeCount; }
+    size_t GetCapacity() const { return capacity; }
+    size_t GetPeakActiveCount() const { return peakActiveCount; }
+    uint64_t GetTotalCollectedCount() const { return totalCollectedCount; }
+
+    // 出界回收的下边界
+    void SetBottomBound(float bottom) { bottomBound = bottom; }
+
+    // 自动回收线：自机中心高于此线时吸附全部道具，点数道具按最大得点计算
+    void SetCollectLine(float y) { collectLineY = y; }
+    float GetCollectLine() const { return collectLineY; }
+
+private:
+    static constexpr uint8_t NO_TARGET = 0xFF;
+
+    // 每 tick 从自机取一次的拾取参数
+    struct Collector {
+        SelfMachineBase* player;
+        float x, y;
+        float magnetRadiusSq;
+        bool autoCollect;
+        int64_t pointValue;
+        std::array<uint32_t, static_cast<size_t>(ItemType::COUNT)> collected;
+    };
+
+    size_t SpawnAt(ItemType type, float x, float y, float vx, float vy);
+    void ApplyCollected(const Collector& collector);
+
+    // SoA 数据
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<ItemType> types;
+    std::vector<uint8_t> targets;      // 吸附目标槽位，NO_TARGET 表示自由下落
+
+    size_t capacity;
+    size_t activeCount;
+    size_t peakActiveCount;
+    uint64_t totalCollectedCount;
+    float bottomBound;
+    float collectLineY;
+
+    std::array<Collector, MAX_COLLECTORS> collectors{};
+};
+
+#endif //ITEMMANAGER_H
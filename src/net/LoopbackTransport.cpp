@@ -0,0 +1,34 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "LoopbackTransport.h"
+
+LoopbackTransport::LoopbackTransport(std::shared_ptr<Channel> sharedChannel, int endpointSide)
+    : channel(std::move(sharedChannel)),
+      side(endpointSide) {
+}
+
+std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> LoopbackTransport::CreatePair() {
+    auto channel = std::make_shared<Channel>();
+    std::unique_ptr<LoopbackTransport> first(new LoopbackTransport(channel, 0));
+    std::unique_ptr<LoopbackTransport> second(new LoopbackTransport(channel, 1));
+    return {std::move(first), std::move(second)};
+}
+
+bool LoopbackTransport::SendNow(const uint8_t* data, size_t size) {
+    std::lock_guard<std::mutex> lock(channel->mutex);
+    channel->queues[1 - side].emplace_back(data, data + size);
+    return true;
+}
+
+bool LoopbackTransport::Receive(std::vector<uint8_t>& packet) {
+    std::lock_guard<std::mutex> lock(channel->mutex);
+    auto& queue = channel->queues[side];
+    if (queue.empty()) {
+        return false;
+    }
+    packet.swap(queue.front());
+    queue.pop_front();
+    return true;
+}
@@ -0,0 +1,42 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef LOOPBACKTRANSPORT_H
+#define LOOPBACKTRANSPORT_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "NetTransport.h"
+
+/**
+ * LoopbackTransport - 进程内回环传输
+ * CreatePair 创建互相连接的两端，一端发出的包进入另一端的接收队列。
+ * 配合 NetConditions 可以在单机上测试延迟、抖动和丢包
+ */
+class LoopbackTransport : public NetTransport {
+public:
+    static std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> CreatePair();
+
+    bool Receive(std::vector<uint8_t>& packet) override;
+
+protected:
+    bool SendNow(const uint8_t* data, size_t size) override;
+
+private:
+    // 两端共享的通道，queues[i] 为第 i 端的接收队列
+    struct Channel {
+        std::mutex mutex;
+        std::deque<std::vector<uint8_t>> queues[2];
+    };
+
+    LoopbackTransport(std::shared_ptr<Channel> channel, int side);
+
+    std::shared_ptr<Channel> channel;
+    int side;
+};
+
+#endif //LOOPBACKTRANSPORT_H
@@ -0,0 +1,75 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "NetTransport.h"
+
+#include <SDL3/SDL.h>
+
+NetTransport::NetTransport()
+    : random(0x6e6574u),
+      packetsSent(0),
+      packetsDropped(0),
+      bytesSent(0) {
+}
+
+double NetTransport::NowMs() {
+    return static_cast<double>(SDL_GetPerformanceCounter()) * 1000.0 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+void NetTransport::Send(const uint8_t* data, size_t size) {
+    if (!data || size == 0) return;
+
+    if (conditions.lossRate > 0.0f && random.NextFloat() < conditions.lossRate) {
+        packetsDropped++;
+        return;
+    }
+
+    // 没有人为延迟时直接发送
+    if (conditions.latencyMs <= 0.0f && conditions.jitterMs <= 0.0f) {
+        if (SendNow(data, size)) {
+            packetsSent++;
+            bytesSent += size;
+        }
+        return;
+    }
+
+    PendingPacket packet;
+    if (!freeBuffers.empty()) {
+        packet.data = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+    }
+    packet.data.assign(data, data + size);
+
+    float delay = conditions.latencyMs;
+    if (conditions.jitterMs > 0.0f) {
+        delay += random.Range(-conditions.jitterMs, conditions.jitterMs);
+    }
+    packet.deliverAtMs = NowMs() + (delay > 0.0f ? delay : 0.0f);
+    pending.push_back(std::move(packet));
+}
+
+void NetTransport::Update() {
+    if (pending.empty()) return;
+
+    double now = NowMs();
+
+    // 抖动会让到期顺序与加入顺序不同，逐个检查并保留未到期的包
+    size_t remaining = pending.size();
+    for (size_t i = 0; i < remaining; ++i) {
+        PendingPacket packet = std::move(pending.front());
+        pending.pop_front();
+
+        if (packet.deliverAtMs > now) {
+            pending.push_back(std::move(packet));
+            continue;
+        }
+
+        if (SendNow(packet.data.data(), packet.data.size())) {
+            packetsSent++;
+            bytesSent += packet.data.size();
+        }
+        freeBuffers.push_back(std::move(packet.data));
+    }
+}
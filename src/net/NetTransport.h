@@ -0,0 +1,76 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef NETTRANSPORT_H
+#define NETTRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "../gamecore/Random.h"
+
+/**
+ * 人为网络条件（测试用）
+ * 每个包独立抽样：延迟 = latencyMs ± jitterMs，按 lossRate 概率丢弃
+ */
+struct NetConditions {
+    float latencyMs = 0.0f;   // 单向延迟
+    float jitterMs = 0.0f;    // 延迟抖动（抖动可能导致乱序）
+    float lossRate = 0.0f;    // 丢包率 0-1
+};
+
+/**
+ * NetTransport - 不可靠数据报传输的抽象
+ * 语义与 UDP 相同：包可能丢失、乱序，但不会被拆分或合并。
+ * 发出的包先进入本地延迟队列，Update 时把到期的包交给具体实现真正发送，
+ * 因此所有实现都可以用同一套人为延迟/丢包配置测试
+ */
+class NetTransport {
+public:
+    NetTransport();
+    virtual ~NetTransport() = default;
+
+    // 发送一个包（经过人为网络条件后才真正发出）
+    void Send(const uint8_t* data, size_t size);
+
+    // 非阻塞接收一个包，没有可读的包返回 false
+    virtual bool Receive(std::vector<uint8_t>& packet) = 0;
+
+    // 发出到期的包，每帧调用
+    void Update();
+
+    // 人为网络条件
+    void SetConditions(const NetConditions& newConditions) { conditions = newConditions; }
+    const NetConditions& GetConditions() const { return conditions; }
+
+    // 统计
+    uint64_t GetPacketsSent() const { return packetsSent; }
+    uint64_t GetPacketsDropped() const { return packetsDropped; }
+    uint64_t GetBytesSent() const { return bytesSent; }
+
+protected:
+    // 立即发送（由具体传输实现）
+    virtual bool SendNow(const uint8_t* data, size_t size) = 0;
+
+    // 当前时间（毫秒）
+    static double NowMs();
+
+private:
+    struct PendingPacket {
+        double deliverAtMs;
+        std::vector<uint8_t> data;
+    };
+
+    NetConditions conditions;
+    Random random;                               // 只用于网络条件抽样，与模拟随机数无关
+    std::deque<PendingPacket> pending;           // 等待发出的包（按加入顺序）
+    std::vector<std::vector<uint8_t>> freeBuffers;   // 复用的包缓冲区
+
+    uint64_t packetsSent;
+    uint64_t packetsDropped;
+    uint64_t bytesSent;
+};
+
+#endif //NETTRANSPORT_H
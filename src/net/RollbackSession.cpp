@@ -0,0 +1,229 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "RollbackSession.h"
+#include "../snapshot/StateBuffer.h"
+#include "../gamecore/FrameProfiler.h"
+#include "../gamecore/Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <SDL3/SDL.h>
+
+namespace {
+    constexpr uint16_t PACKET_MAGIC = 0x5242;   // "RB"
+
+    double ElapsedMs(Uint64 begin) {
+        return static_cast<double>(SDL_GetPerformanceCounter() - begin) * 1000.0 /
+               static_cast<double>(SDL_GetPerformanceFrequency());
+    }
+}
+
+RollbackSession::RollbackSession(NetTransport* netTransport, const RollbackConfig& sessionConfig)
+    : transport(netTransport),
+      config(sessionConfig),
+      currentTick(0),
+      firstMismatchTick(-1) {
+    config.localPlayer = std::clamp(config.localPlayer, 0, NET_PLAYER_COUNT - 1);
+    config.inputDelay = std::clamp(config.inputDelay, 0, INPUT_RING_SIZE / 4);
+    config.maxRollback = std::clamp(config.maxRollback, 1, INPUT_RING_SIZE / 4);
+    remotePlayer = 1 - config.localPlayer;
+
+    // 前 inputDelay 个 tick 双方都没有输入，视为已确认的空输入
+    lastLocalTick = config.inputDelay - 1;
+    lastRemoteTick = config.inputDelay - 1;
+    remoteAckTick = config.inputDelay - 1;
+
+    localInputs.assign(INPUT_RING_SIZE, 0);
+    remoteInputs.assign(INPUT_RING_SIZE, 0);
+    predictedInputs.assign(INPUT_RING_SIZE, 0);
+    snapshots.resize(config.maxRollback + 2);
+}
+
+void RollbackSession::SetCallbacks(SaveFunction save, LoadFunction load, AdvanceFunction advance) {
+    saveState = std::move(save);
+    loadState = std::move(load);
+    advanceState = std::move(advance);
+}
+
+bool RollbackSession::AdvanceFrame(PlayerInputBits localInput) {
+    if (transport) {
+        transport->Update();
+    }
+
+    ReceivePackets();
+    if (firstMismatchTick >= 0) {
+        Rollback();
+    }
+
+    // 预测窗口已满：不推进，只重发输入（对端可能也在等我们）
+    if (currentTick - lastRemoteTick > config.maxRollback) {
+        stats.stalledFrames++;
+        SendInputs();
+        return false;
+    }
+
+    // 本地输入延迟 inputDelay 个 tick 生效
+    int64_t inputTick = currentTick + config.inputDelay;
+    if (inputTick > lastLocalTick) {
+        localInputs[RingIndex(inputTick, INPUT_RING_SIZE)] = localInput;
+        lastLocalTick = inputTick;
+    }
+    SendInputs();
+
+    // 对端输入尚未确认的 tick 之后可能需要回滚，模拟前保存快照
+    SimulateTick(currentTick, currentTick > lastRemoteTick);
+    currentTick++;
+    stats.advancedTicks++;
+    return true;
+}
+
+void RollbackSession::ReceivePackets() {
+    if (!transport) return;
+
+    while (transport->Receive(packetBuffer)) {
+        HandlePacket(packetBuffer);
+    }
+}
+
+void RollbackSession::HandlePacket(const std::vector<uint8_t>& packet) {
+    StateReader reader(packet);
+
+    uint16_t magic = 0;
+    int32_t ackTick = 0;
+    int32_t startTick = 0;
+    uint8_t count = 0;
+    reader.Read(magic);
+    reader.Read(ackTick);
+    reader.Read(startTick);
+    reader.Read(count);
+    if (reader.HasFailed() || magic != PACKET_MAGIC) {
+        return;
+    }
+
+    remoteAckTick = std::max<int64_t>(remoteAckTick, ackTick);
+
+    for (int i = 0; i < count; ++i) {
+        PlayerInputBits input = 0;
+        if (!reader.Read(input)) {
+            return;
+        }
+
+        int64_t tick = static_cast<int64_t>(startTick) + i;
+        if (tick <= lastRemoteTick) {
+            continue;   // 冗余重发的旧输入
+        }
+        if (tick != lastRemoteTick + 1) {
+            break;      // 中间有包丢失，等待后续包补齐
+        }
+
+        int index = RingIndex(tick, INPUT_RING_SIZE);
+        remoteInputs[index] = input;
+        lastRemoteTick = tick;
+
+        // 已经用预测值模拟过的 tick，预测错误时需要回滚
+        if (tick < currentTick && predictedInputs[index] != input) {
+            firstMismatchTick = (firstMismatchTick < 0) ? tick : std::min(firstMismatchTick, tick);
+        }
+    }
+}
+
+void RollbackSession::SendInputs() {
+    if (!transport) return;
+
+    // 从对端最后确认的 tick 之后开始，把未确认的本地输入全部带上
+    int64_t startTick = remoteAckTick + 1;
+    int64_t count = std::clamp<int64_t>(lastLocalTick - startTick + 1, 0, MAX_INPUTS_PER_PACKET);
+
+    packetBuffer.clear();
+    StateWriter writer(packetBuffer);
+    writer.Write(PACKET_MAGIC);
+    writer.Write(static_cast<int32_t>(lastRemoteTick));
+    writer.Write(static_cast<int32_t>(startTick));
+    writer.Write(static_cast<uint8_t>(count));
+    for (int64_t i = 0; i < count; ++i) {
+        writer.Write(localInputs[RingIndex(startTick + i, INPUT_RING_SIZE)]);
+    }
+
+    transport->Send(packetBuffer.data(), packetBuffer.size());
+}
+
+void RollbackSession::Rollback() {
+    int64_t targetTick = firstMismatchTick;
+    firstMismatchTick = -1;
+    if (targetTick >= currentTick || !loadState) return;
+
+    Uint64 begin = SDL_GetPerformanceCounter();
+
+    if (!loadState(snapshots[RingIndex(targetTick, static_cast<int>(snapshots.size()))])) {
+        LOG_ERROR("RollbackSession: failed to load snapshot for tick {}", targetTick);
+        return;
+    }
+
+    // 目标 tick 的快照刚刚恢复，不必重新保存
+    for (int64_t tick = targetTick; tick < currentTick; ++tick) {
+        SimulateTick(tick, tick != targetTick && tick > lastRemoteTick);
+    }
+
+    int ticks = static_cast<int>(currentTick - targetTick);
+    double elapsed = ElapsedMs(begin);
+    stats.rollbacks++;
+    stats.resimulatedTicks += ticks;
+    stats.lastRollbackTicks = ticks;
+    stats.lastRollbackMs = elapsed;
+    stats.maxRollbackTicks = std::max(stats.maxRollbackTicks, ticks);
+    stats.maxRollbackMs = std::max(stats.maxRollbackMs, elapsed);
+    stats.totalRollbackMs += elapsed;
+
+    char label[32];
+    std::snprintf(label, sizeof(label), "%d ticks", ticks);
+    FrameProfiler::Instance().Mark(FrameMarker::ROLLBACK, elapsed, label);
+}
+
+void RollbackSession::SimulateTick(int64_t tick, bool saveSnapshot) {
+    if (saveSnapshot && saveState) {
+        Uint64 begin = SDL_GetPerformanceCounter();
+        saveState(snapshots[RingIndex(tick, static_cast<int>(snapshots.size()))]);
+        stats.totalSaveMs += ElapsedMs(begin);
+    }
+
+    Inputs inputs = GetInputsForTick(tick);
+    if (advanceState) {
+        advanceState(inputs);
+    }
+}
+
+RollbackSession::Inputs RollbackSession::GetInputsForTick(int64_t tick) {
+    int index = RingIndex(tick, INPUT_RING_SIZE);
+
+    // 对端输入未到时重复其最后一个已确认输入
+    PlayerInputBits remoteInput = 0;
+    if (tick <= lastRemoteTick) {
+        remoteInput = remoteInputs[index];
+    } else if (lastRemoteTick >= 0) {
+        remoteInput = remoteInputs[RingIndex(lastRemoteTick, INPUT_RING_SIZE)];
+    }
+    predictedInputs[index] = remoteInput;
+
+    Inputs inputs{};
+    inputs[config.localPlayer] = localInputs[index];
+    inputs[remotePlayer] = remoteInput;
+    return inputs;
+}
+
+void RollbackSession::LogStats() const {
+    double averageTicks = stats.rollbacks > 0
+        ? static_cast<double>(stats.resimulatedTicks) / static_cast<double>(stats.rollbacks) : 0.0;
+    double averageMs = stats.rollbacks > 0 ? stats.totalRollbackMs / static_cast<double>(stats.rollbacks) : 0.0;
+    double msPerTick = stats.resimulatedTicks > 0
+        ? stats.totalRollbackMs / static_cast<double>(stats.resimulatedTicks) : 0.0;
+
+    // 单条日志的参数个数有限，分两行
+    LOG_INFO("Rollback: tick {} (confirmed {}) | stalls {} | rollbacks {} avg {} ticks / {} ms | max {} ticks",
+             currentTick, lastRemoteTick, stats.stalledFrames, stats.rollbacks, averageTicks, averageMs,
+             stats.maxRollbackTicks);
+    LOG_INFO("Rollback: max {} ms | resim {} ms/tick | save total {} ms | sent {} dropped {}", stats.maxRollbackMs,
+             msPerTick, stats.totalSaveMs, transport ? transport->GetPacketsSent() : 0,
+             transport ? transport->GetPacketsDropped() : 0);
+}
@@ -0,0 +1,109 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef ROLLBACKSESSION_H
+#define ROLLBACKSESSION_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "NetTransport.h"
+#include "../input/PlayerInput.h"
+
+// 联机人数（双人合作）
+constexpr int NET_PLAYER_COUNT = 2;
+
+struct RollbackConfig {
+    int localPlayer = 0;      // 本机控制的自机编号（0 或 1），两端必须不同
+    int inputDelay = 2;       // 输入延迟（tick），两端必须相同
+    int maxRollback = 8;      // 最多预测/回滚的 tick 数，超出时暂停等待对端
+};
+
+/**
+ * RollbackSession - 回滚联机会话
+ * 职责：
+ * 1. 本地输入延迟 inputDelay 个 tick 生效，并与未确认的历史输入一起冗余发送（抵抗丢包）
+ * 2. 对端输入未到时用其最后一个已确认输入预测，照常推进模拟
+ * 3. 对端输入到达且与预测不同时，恢复到出错 tick 之前的快照并用正确输入重新模拟到当前 tick
+ * 4. 预测超过 maxRollback 个 tick 时暂停推进（等待对端）
+ * 5. 统计回滚次数、重新模拟的 tick 数和耗时（回滚成本 = 子弹更新成本 × 重新模拟的 tick 数）
+ *
+ * 会话不了解模拟内容，通过三个回调保存/恢复/推进模拟；模拟必须是确定性的
+ */
+class RollbackSession {
+public:
+    using Inputs = std::array<PlayerInputBits, NET_PLAYER_COUNT>;
+    using SaveFunction = std::function<void(std::vector<uint8_t>&)>;
+    using LoadFunction = std::function<bool(const std::vector<uint8_t>&)>;
+    using AdvanceFunction = std::function<void(const Inputs&)>;
+
+    struct Stats {
+        uint64_t advancedTicks = 0;       // 正常推进的 tick 数
+        uint64_t stalledFrames = 0;       // 因等待对端而暂停的帧数
+        uint64_t rollbacks = 0;           // 回滚次数
+        uint64_t resimulatedTicks = 0;    // 回滚中重新模拟的 tick 总数
+        int lastRollbackTicks = 0;
+        int maxRollbackTicks = 0;
+        double lastRollbackMs = 0.0;      // 最近一次回滚耗时（恢复 + 重新模拟）
+        double maxRollbackMs = 0.0;
+        double totalRollbackMs = 0.0;
+        double totalSaveMs = 0.0;         // 保存快照的总耗时
+    };
+
+    RollbackSession(NetTransport* transport, const RollbackConfig& config);
+
+    void SetCallbacks(SaveFunction save, LoadFunction load, AdvanceFunction advance);
+
+    // 每帧调用一次：收包、必要时回滚、提交本地输入并推进一个 tick
+    // 返回 false 表示本帧因等待对端而没有推进
+    bool AdvanceFrame(PlayerInputBits localInput);
+
+    // 状态查询
+    int64_t GetCurrentTick() const { return currentTick; }
+    int64_t GetConfirmedTick() const { return lastRemoteTick; }   // 对端输入已确认到的 tick
+    const RollbackConfig& GetConfig() const { return config; }
+    const Stats& GetStats() const { return stats; }
+
+    // 统计摘要写入日志（平均每次回滚/每个重新模拟 tick 的耗时）
+    void LogStats() const;
+
+private:
+    static constexpr int INPUT_RING_SIZE = 256;        // 输入历史环形缓冲区（必须远大于延迟 + 回滚窗口）
+    static constexpr int MAX_INPUTS_PER_PACKET = 64;    // 每个包最多携带的输入数
+
+    void ReceivePackets();
+    void HandlePacket(const std::vector<uint8_t>& packet);
+    void SendInputs();
+    void Rollback();
+    void SimulateTick(int64_t tick, bool saveSnapshot);
+    Inputs GetInputsForTick(int64_t tick);
+
+    static int RingIndex(int64_t tick, int size) { return static_cast<int>(tick % size); }
+
+    NetTransport* transport;
+    RollbackConfig config;
+    int remotePlayer;
+
+    SaveFunction saveState;
+    LoadFunction loadState;
+    AdvanceFunction advanceState;
+
+    int64_t currentTick;          // 下一个要模拟的 tick
+    int64_t lastLocalTick;        // 已有本地输入的最后 tick
+    int64_t lastRemoteTick;       // 已收到对端输入的最后 tick（连续）
+    int64_t remoteAckTick;        // 对端已确认收到的本地输入的最后 tick
+    int64_t firstMismatchTick;    // 需要回滚到的 tick（-1 表示无）
+
+    std::vector<PlayerInputBits> localInputs;       // 本地输入历史
+    std::vector<PlayerInputBits> remoteInputs;      // 对端已确认输入
+    std::vector<PlayerInputBits> predictedInputs;   // 模拟时实际使用的对端输入（预测值或确认值）
+
+    std::vector<std::vector<uint8_t>> snapshots;    // 每个 tick 模拟前的状态（环形）
+    std::vector<uint8_t> packetBuffer;              // 收发复用的缓冲区
+
+    Stats stats;
+};
+
+#endif //ROLLBACKSESSION_H
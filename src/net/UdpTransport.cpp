@@ -0,0 +1,152 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "UdpTransport.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using SocketLength = int;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SocketLength = socklen_t;
+#endif
+
+namespace {
+#ifdef _WIN32
+    const uintptr_t INVALID_HANDLE = static_cast<uintptr_t>(INVALID_SOCKET);
+
+    // WinSock 按引用计数初始化
+    bool AcquireSocketLibrary() {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }
+
+    void ReleaseSocketLibrary() {
+        WSACleanup();
+    }
+
+    void CloseSocket(uintptr_t handle) {
+        closesocket(static_cast<SOCKET>(handle));
+    }
+
+    bool SetNonBlocking(uintptr_t handle) {
+        u_long mode = 1;
+        return ioctlsocket(static_cast<SOCKET>(handle), FIONBIO, &mode) == 0;
+    }
+#else
+    const uintptr_t INVALID_HANDLE = static_cast<uintptr_t>(-1);
+
+    bool AcquireSocketLibrary() { return true; }
+    void ReleaseSocketLibrary() {}
+
+    void CloseSocket(uintptr_t handle) {
+        close(static_cast<int>(handle));
+    }
+
+    bool SetNonBlocking(uintptr_t handle) {
+        int flags = fcntl(static_cast<int>(handle), F_GETFL, 0);
+        return flags >= 0 && fcntl(static_cast<int>(handle), F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+#endif
+}
+
+UdpTransport::UdpTransport()
+    : socketHandle(INVALID_HANDLE),
+      remoteAddress(0),
+      remotePort(0) {
+}
+
+UdpTransport::~UdpTransport() {
+    Close();
+}
+
+bool UdpTransport::Open(uint16_t localPort, const std::string& remoteHost, uint16_t port) {
+    Close();
+
+    in_addr address{};
+    if (inet_pton(AF_INET, remoteHost.c_str(), &address) != 1) {
+        std::cerr << "UdpTransport: invalid remote address: " << remoteHost << std::endl;
+        return false;
+    }
+
+    if (!AcquireSocketLibrary()) {
+        std::cerr << "UdpTransport: failed to initialize socket library" << std::endl;
+        return false;
+    }
+
+    uintptr_t handle = static_cast<uintptr_t>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+    if (handle == INVALID_HANDLE) {
+        std::cerr << "UdpTransport: failed to create socket" << std::endl;
+        ReleaseSocketLibrary();
+        return false;
+    }
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(localPort);
+    if (bind(handle, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0 || !SetNonBlocking(handle)) {
+        std::cerr << "UdpTransport: failed to bind port " << localPort << std::endl;
+        CloseSocket(handle);
+        ReleaseSocketLibrary();
+        return false;
+    }
+
+    socketHandle = handle;
+    remoteAddress = address.s_addr;
+    remotePort = htons(port);
+    return true;
+}
+
+void UdpTransport::Close() {
+    if (socketHandle == INVALID_HANDLE) return;
+
+    CloseSocket(socketHandle);
+    ReleaseSocketLibrary();
+    socketHandle = INVALID_HANDLE;
+}
+
+bool UdpTransport::IsOpen() const {
+    return socketHandle != INVALID_HANDLE;
+}
+
+bool UdpTransport::SendNow(const uint8_t* data, size_t size) {
+    if (!IsOpen() || size > MAX_PACKET_SIZE) return false;
+
+    sockaddr_in remote{};
+    remote.sin_family = AF_INET;
+    remote.sin_addr.s_addr = remoteAddress;
+    remote.sin_port = remotePort;
+
+    auto sent = sendto(socketHandle, reinterpret_cast<const char*>(data), static_cast<int>(size), 0,
+                       reinterpret_cast<const sockaddr*>(&remote), sizeof(remote));
+    return sent == static_cast<decltype(sent)>(size);
+}
+
+bool UdpTransport::Receive(std::vector<uint8_t>& packet) {
+    if (!IsOpen()) return false;
+
+    // 丢弃来自其他地址的包，直到读到对端的包或队列为空
+    while (true) {
+        sockaddr_in from{};
+        SocketLength fromLength = sizeof(from);
+        auto received = recvfrom(socketHandle, reinterpret_cast<char*>(receiveBuffer), sizeof(receiveBuffer), 0,
+                                 reinterpret_cast<sockaddr*>(&from), &fromLength);
+        if (received <= 0) {
+            return false;
+        }
+        if (from.sin_addr.s_addr != remoteAddress || from.sin_port != remotePort) {
+            continue;
+        }
+        packet.assign(receiveBuffer, receiveBuffer + received);
+        return true;
+    }
+}
@@ -0,0 +1,45 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef UDPTRANSPORT_H
+#define UDPTRANSPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "NetTransport.h"
+
+/**
+ * UdpTransport - 非阻塞 UDP 传输（IPv4）
+ * 绑定本地端口并固定发往一个对端地址；只接受来自该对端的包。
+ * 目前用于本机两端口互联测试，人为延迟/丢包同样生效
+ */
+class UdpTransport : public NetTransport {
+public:
+    UdpTransport();
+    ~UdpTransport() override;
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    // 打开套接字：remoteHost 为数字形式的 IPv4 地址（如 "127.0.0.1"）
+    bool Open(uint16_t localPort, const std::string& remoteHost, uint16_t remotePort);
+    void Close();
+    bool IsOpen() const;
+
+    bool Receive(std::vector<uint8_t>& packet) override;
+
+protected:
+    bool SendNow(const uint8_t* data, size_t size) override;
+
+private:
+    static constexpr size_t MAX_PACKET_SIZE = 1500;
+
+    uintptr_t socketHandle;     // 平台套接字句柄
+    uint32_t remoteAddress;     // 网络字节序
+    uint16_t remotePort;        // 网络字节序
+    uint8_t receiveBuffer[MAX_PACKET_SIZE];
+};
+
+#endif //UDPTRANSPORT_H
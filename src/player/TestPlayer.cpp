@@ -3,6 +3,8 @@
 //
 
 #include "TestPlayer.h"
+#include "../snapshot/StateBuffer.h"
+#include "../gamecore/Logger.h"
 #include <iostream>
 
 TestPlayer::TestPlayer(InputHandler* input, int windowW, int windowH)
@@ -14,6 +16,8 @@ TestPlayer::TestPlayer(InputHandler* input, int windowW, int windowH)
       bombDurationMs(2000.0f),
       bombCooldownMs(0.0f),
       bombTimerMs(0.0f),
+      bombClearRadiusMin(48.0f),
+      bombClearRadiusMax(480.0f),
       hitboxRadius(3.0f),
       spriteWidthOverride(0.0f),
       spriteHeightOverride(0.0f),
@@ -67,11 +71,11 @@ void TestPlayer::OnPowerUp() {
 }
 
 void TestPlayer::OnBombCollected() {
-    std::cout << "TestPlayer: bomb collected\n";
+    LOG_DEBUG("TestPlayer: bomb collected");
 }
 
 void TestPlayer::OnDeath() {
-    std::cout << "TestPlayer: dead, remaining lives=" << lives << "\n";
+    LOG_DEBUG("TestPlayer: dead, remaining lives={}", lives);
 }
 
 void TestPlayer::UpdateStateEffects(float deltaTime) {
@@ -118,8 +122,7 @@ void TestPlayer::SetBombDuration(float ms) {
 }
 
 void TestPlayer::FireStraightPattern() {
-    // 目前还没有弹幕系统，先输出日志占位
-    std::cout << "TestPlayer: shoot level " << shotLevel << "\n";
+    // 自机弹幕尚未接入，先留空（不在射击路径上输出日志）
 }
 
 void TestPlayer::UpdateShootTimer(float deltaTime) {
@@ -128,14 +131,46 @@ void TestPlayer::UpdateShootTimer(float deltaTime) {
     }
 }
 
+float TestPlayer::GetBombClearRadius() const {
+    if (!IsInBombMode() || bombDurationMs <= 0.0f) {
+        return 0.0f;
+    }
+    float progress = 1.0f - std::clamp(bombTimerMs / bombDurationMs, 0.0f, 1.0f);
+    return bombClearRadiusMin + (bombClearRadiusMax - bombClearRadiusMin) * progress;
+}
+
 void TestPlayer::StartBomb() {
     bombTimerMs = bombDurationMs;
     SetState(PlayerState::BOMBING);
-    std::cout << "TestPlayer: bomb start\n";
+    LOG_DEBUG("TestPlayer: bomb start");
 }
 
 void TestPlayer::StopBomb() {
     bombTimerMs = 0.0f;
-    SetState(PlayerState::NORMAL);
-    std::cout << "TestPlayer: bomb end\n";
+    // 炸弹期间被击落的自机保持死亡状态
+    if (currentState != PlayerState::DEAD) {
+        SetState(PlayerState::NORMAL);
+    }
+    LOG_DEBUG("TestPlayer: bomb end");
+}
+
+void TestPlayer::SaveState(StateWriter& writer) const {
+    SelfMachineBase::SaveState(writer);
+    writer.Write(shootCooldownMs);
+    writer.Write(shootTimerMs);
+    writer.Write(shotLevel);
+    writer.Write(bombTimerMs);
+    writer.Write(flashTimerMs);
+}
+
+bool TestPlayer::LoadState(StateReader& reader) {
+    if (!SelfMachineBase::LoadState(reader)) {
+        return false;
+    }
+    reader.Read(shootCooldownMs);
+    reader.Read(shootTimerMs);
+    reader.Read(shotLevel);
+    reader.Read(bombTimerMs);
+    reader.Read(flashTimerMs);
+    return !reader.HasFailed();
 }
@@ -16,6 +16,13 @@ public:
     // 生命周期
     void Initialize(Renderer* renderer) override;
 
+    // 状态快照
+    void SaveState(StateWriter& writer) const override;
+    bool LoadState(StateReader& reader) override;
+
+    // 炸弹清弹圈随炸弹时间从判定点向外扩张
+    float GetBombClearRadius() const override;
+
 protected:
     // 覆盖自机逻辑
     void DoShoot() override;
@@ -44,6 +51,8 @@ private:
     float bombDurationMs;
     float bombCooldownMs;
     float bombTimerMs;
+    float bombClearRadiusMin;
+    float bombClearRadiusMax;
 
     // 判定/尺寸
     float hitboxRadius;
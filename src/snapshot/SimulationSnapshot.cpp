@@ -0,0 +1,203 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "SimulationSnapshot.h"
+#include "StateBuffer.h"
+#include "../entity/SelfMachinesBase.h"
+#include "../gamecore/Random.h"
+#include "../manager/BulletManager.h"
+#include "../manager/EnemyManager.h"
+#include "../manager/ItemManager.h"
+#include "../stage/StageTimeline.h"
+#include "../gamecore/Logger.h"
+
+
+namespace {
+    constexpr char SNAPSHOT_MAGIC[4] = {'S', 'N', 'A', 'P'};
+
+    constexpr uint32_t MakeTag(char a, char b, char c, char d) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+    }
+
+    constexpr uint32_t TAG_GAME = MakeTag('G', 'A', 'M', 'E');
+    constexpr uint32_t TAG_RANDOM = MakeTag('R', 'A', 'N', 'D');
+    constexpr uint32_t TAG_PLAYER = MakeTag('P', 'L', 'Y', 'R');
+    constexpr uint32_t TAG_ENEMIES = MakeTag('E', 'N', 'M', 'Y');
+    constexpr uint32_t TAG_BULLETS = MakeTag('B', 'L', 'L', 'T');
+    constexpr uint32_t TAG_ITEMS = MakeTag('I', 'T', 'E', 'M');
+
+    // 分段：先写标签和长度占位，内容写完后回填长度
+    template <typename WriteFunction>
+    void WriteSection(StateWriter& writer, uint32_t tag, WriteFunction&& writeContent) {
+        writer.Write(tag);
+        size_t sizeOffset = writer.GetSize();
+        writer.Write(static_cast<uint32_t>(0));
+        size_t contentStart = writer.GetSize();
+        writeContent(writer);
+        writer.Patch(sizeOffset, static_cast<uint32_t>(writer.GetSize() - contentStart));
+    }
+}
+
+void SimulationSnapshot::Capture(const SimulationState& simulation, std::vector<uint8_t>& buffer) {
+    buffer.clear();
+    StateWriter writer(buffer);
+
+    writer.WriteBytes(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    writer.Write(VERSION);
+    writer.Write(simulation.timeline ? simulation.timeline->GetCurrentTick() : 0u);
+
+    WriteSection(writer, TAG_GAME, [&](StateWriter& w) {
+        w.Write(simulation.backgroundIndex ? *simulation.backgroundIndex : -1);
+        w.Write(simulation.bossPhase ? *simulation.bossPhase : 0);
+    });
+
+    if (simulation.random) {
+        WriteSection(writer, TAG_RANDOM, [&](StateWriter& w) {
+            w.Write(simulation.random->GetState());
+        });
+    }
+
+    WriteSection(writer, TAG_PLAYER, [&](StateWriter& w) {
+        w.Write(static_cast<uint8_t>(SIMULATION_MAX_PLAYERS));
+        for (SelfMachineBase* player : simulation.players) {
+            w.Write(player != nullptr);
+            if (player) {
+                player->SaveState(w);
+            }
+        }
+    });
+
+    if (simulation.enemies) {
+        WriteSection(writer, TAG_ENEMIES, [&](StateWriter& w) {
+            simulation.enemies->SaveState(w);
+        });
+    }
+
+    if (simulation.bullets) {
+        WriteSection(writer, TAG_BULLETS, [&](StateWriter& w) {
+            simulation.bullets->SaveState(w);
+        });
+    }
+
+    if (simulation.items) {
+        WriteSection(writer, TAG_ITEMS, [&](StateWriter& w) {
+            simulation.items->SaveState(w);
+        });
+    }
+}
+
+bool SimulationSnapshot::Restore(const SimulationState& simulation, const std::vector<uint8_t>& buffer,
+                                 std::array<bool, SIMULATION_MAX_PLAYERS>* presentPlayers) {
+    StateReader reader(buffer);
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint32_t tick = 0;
+    reader.ReadBytes(magic, sizeof(magic));
+    reader.Read(version);
+    reader.Read(tick);
+    if (reader.HasFailed() || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 || version != VERSION) {
+        LOG_ERROR("SimulationSnapshot: incompatible snapshot (version {})", version);
+        return false;
+    }
+
+    bool hasBullets = false;
+    bool hasItems = false;
+    std::array<bool, SIMULATION_MAX_PLAYERS> presentSlots{};
+    while (reader.GetRemaining() > 0) {
+        uint32_t tag = 0;
+        uint32_t size = 0;
+        reader.Read(tag);
+        reader.Read(size);
+        const uint8_t* content = reader.Consume(size);
+        if (!content) {
+            LOG_ERROR("SimulationSnapshot: truncated section");
+            return false;
+        }
+
+        // 每个分段用独立的读取器，分段内读多读少都不影响后续分段
+        StateReader section(content, size);
+        bool ok = true;
+
+        if (tag == TAG_GAME) {
+            int32_t background = -1;
+            int phase = 0;
+            section.Read(background);
+            section.Read(phase);
+            if (simulation.backgroundIndex) *simulation.backgroundIndex = background;
+            if (simulation.bossPhase) *simulation.bossPhase = phase;
+            ok = !section.HasFailed();
+        } else if (tag == TAG_RANDOM) {
+            Random::State state{};
+            ok = section.Read(state);
+            if (ok && simulation.random) simulation.random->SetState(state);
+        } else if (tag == TAG_PLAYER) {
+            uint8_t count = 0;
+            section.Read(count);
+            for (int i = 0; i < count && ok && !section.HasFailed(); ++i) {
+                bool present = false;
+                section.Read(present);
+                if (!present) continue;
+                if (i < SIMULATION_MAX_PLAYERS) presentSlots[i] = true;
+
+                // 快照中有而当前不存在的自机无法跳过（长度未知），之后的槽位一并忽略
+                SelfMachineBase* player = (i < SIMULATION_MAX_PLAYERS) ? simulation.players[i] : nullptr;
+                if (!player) break;
+                ok = player->LoadState(section);
+            }
+            ok = ok && !section.HasFailed();
+        } else if (tag == TAG_ENEMIES) {
+            ok = !simulation.enemies || simulation.enemies->LoadState(section);
+        } else if (tag == TAG_BULLETS) {
+            ok = !simulation.bullets || simulation.bullets->LoadState(section);
+            hasBullets = true;
+        } else if (tag == TAG_ITEMS) {
+            ok = !simulation.items || simulation.items->LoadState(section);
+            hasItems = true;
+        }
+
+        if (!ok) {
+            LOG_ERROR("SimulationSnapshot: failed to restore section");
+            return false;
+        }
+    }
+
+    // 快照中没有子弹（保存时子弹系统不可用）则清屏
+    if (!hasBullets && simulation.bullets) {
+        simulation.bullets->ClearActiveBullets();
+    }
+    if (!hasItems && simulation.items) {
+        simulation.items->Clear();
+    }
+
+    if (simulation.timeline) {
+        simulation.timeline->SeekCursor(tick);
+    }
+    if (presentPlayers) {
+        *presentPlayers = presentSlots;
+    }
+    return true;
+}
+
+bool SimulationSnapshot::ReadTick(const std::vector<uint8_t>& buffer, uint32_t& tick) {
+    StateReader reader(buffer);
+    char magic[4] = {};
+    uint32_t version = 0;
+    reader.ReadBytes(magic, sizeof(magic));
+    reader.Read(version);
+    reader.Read(tick);
+    return !reader.HasFailed() && std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0 && version == VERSION;
+}
+
+uint64_t SimulationSnapshot::Hash(const std::vector<uint8_t>& buffer) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint8_t byte : buffer) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,63 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef SIMULATIONSNAPSHOT_H
+#define SIMULATIONSNAPSHOT_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class StageTimeline;
+class SelfMachineBase;
+class EnemyManager;
+class BulletManager;
+class ItemManager;
+class Random;
+
+// 快照中的自机槽位数（双人合作）
+constexpr int SIMULATION_MAX_PLAYERS = 2;
+
+/**
+ * 参与快照的模拟系统（不持有所有权，缺失的系统填 nullptr 即可）
+ */
+struct SimulationState {
+    StageTimeline* timeline = nullptr;
+    std::array<SelfMachineBase*, SIMULATION_MAX_PLAYERS> players{};
+    EnemyManager* enemies = nullptr;
+    BulletManager* bullets = nullptr;
+    ItemManager* items = nullptr;
+    Random* random = nullptr;
+    int32_t* backgroundIndex = nullptr;
+    int* bossPhase = nullptr;
+};
+
+/**
+ * SimulationSnapshot - 整个模拟状态的扁平快照
+ * 格式：头部（魔数 "SNAP"、版本号、tick）+ 若干分段（标签、长度、内容）。
+ * 分段带长度，读取时跳过不认识的分段；版本号不同的快照直接拒绝。
+ *
+ * 快照只包含模拟状态，不含渲染资源；对象之间的引用全部是池索引。
+ * Capture 复用调用者的缓冲区（只清空不释放），稳定运行后不产生分配
+ */
+class SimulationSnapshot {
+public:
+    static constexpr uint32_t VERSION = 10;
+
+    // 写入完整快照（覆盖 buffer 原有内容）
+    static void Capture(const SimulationState& simulation, std::vector<uint8_t>& buffer);
+
+    // 从快照恢复，版本不符或数据损坏时返回 false
+    // presentPlayers 非空时写入快照中各自机槽位是否在场（调用者据此增减合作自机）
+    static bool Restore(const SimulationState& simulation, const std::vector<uint8_t>& buffer,
+                        std::array<bool, SIMULATION_MAX_PLAYERS>* presentPlayers = nullptr);
+
+    // 只读取头部中的 tick
+    static bool ReadTick(const std::vector<uint8_t>& buffer, uint32_t& tick);
+
+    // 内容哈希（FNV-1a），用于快速比较和日志
+    static uint64_t Hash(const std::vector<uint8_t>& buffer);
+};
+
+#endif //SIMULATIONSNAPSHOT_H
@@ -0,0 +1,123 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef STATEBUFFER_H
+#define STATEBUFFER_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * StateWriter / StateReader - 扁平字节缓冲区的顺序读写
+ * 只用于平凡可复制的数据（数值、POD 结构体）和字符串，
+ * 不写入任何指针；对象之间的引用一律用池索引或配置id表示
+ */
+class StateWriter {
+public:
+    explicit StateWriter(std::vector<uint8_t>& target) : buffer(target) {}
+
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "StateWriter only writes trivially copyable types");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size) {
+        size_t offset = buffer.size();
+        buffer.resize(offset + size);
+        if (size > 0) {
+            std::memcpy(buffer.data() + offset, data, size);
+        }
+    }
+
+    void WriteString(const std::string& value) {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    // 在末尾预留 size 字节并返回写入位置，用于大块数据原地填充
+    // 返回的指针在下一次写入前有效
+    uint8_t* Append(size_t size) {
+        size_t offset = buffer.size();
+        buffer.resize(offset + size);
+        return buffer.data() + offset;
+    }
+
+    // 回填之前写入位置的值（用于先占位、后写长度的分段）
+    template <typename T>
+    void Patch(size_t offset, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "StateWriter only writes trivially copyable types");
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    size_t GetSize() const { return buffer.size(); }
+
+private:
+    std::vector<uint8_t>& buffer;
+};
+
+class StateReader {
+public:
+    StateReader(const uint8_t* data, size_t size) : data(data), size(size), offset(0), failed(false) {}
+    explicit StateReader(const std::vector<uint8_t>& source) : StateReader(source.data(), source.size()) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "StateReader only reads trivially copyable types");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    bool ReadBytes(void* out, size_t count) {
+        if (failed || offset + count > size) {
+            failed = true;
+            return false;
+        }
+        if (count > 0) {
+            std::memcpy(out, data + offset, count);
+        }
+        offset += count;
+        return true;
+    }
+
+    // 返回当前位置的只读指针并跳过 count 字节，越界返回 nullptr
+    const uint8_t* Consume(size_t count) {
+        if (failed || offset + count > size) {
+            failed = true;
+            return nullptr;
+        }
+        const uint8_t* position = data + offset;
+        offset += count;
+        return position;
+    }
+
+    // 跳过 count 字节
+    bool Skip(size_t count) { return Consume(count) != nullptr; }
+
+    bool ReadString(std::string& value) {
+        uint32_t length = 0;
+        if (!Read(length) || offset + length > size) {
+            failed = true;
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data + offset), length);
+        offset += length;
+        return true;
+    }
+
+    // 读取过程中是否出现越界
+    bool HasFailed() const { return failed; }
+    size_t GetOffset() const { return offset; }
+    size_t GetRemaining() const { return size - offset; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+    bool failed;
+};
+
+#endif //STATEBUFFER_H
@@ -0,0 +1,266 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "StageCompiler.h"
+#include "../snapshot/StateBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+#include "../json.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+    constexpr char STAGE_MAGIC[4] = {'S', 'T', 'G', 'B'};
+    constexpr uint32_t STAGE_BINARY_VERSION = 1;
+
+    // 字符串表去重
+    class StringTable {
+    public:
+        explicit StringTable(std::vector<std::string>& strings) : strings(strings) {}
+
+        int32_t Intern(const std::string& value) {
+            if (value.empty()) return -1;
+            auto it = lookup.find(value);
+            if (it != lookup.end()) return it->second;
+            int32_t index = static_cast<int32_t>(strings.size());
+            strings.push_back(value);
+            lookup[value] = index;
+            return index;
+        }
+
+    private:
+        std::vector<std::string>& strings;
+        std::unordered_map<std::string, int32_t> lookup;
+    };
+
+    bool ParseEventType(const std::string& name, StageEventType& type) {
+        if (name == "spawn_enemy") { type = StageEventType::SPAWN_ENEMY; return true; }
+        if (name == "pattern") { type = StageEventType::START_PATTERN; return true; }
+        if (name == "aimed_pattern") { type = StageEventType::START_AIMED_PATTERN; return true; }
+        if (name == "background") { type = StageEventType::SET_BACKGROUND; return true; }
+        if (name == "boss_phase") { type = StageEventType::BOSS_PHASE; return true; }
+        if (name == "end") { type = StageEventType::END_STAGE; return true; }
+        return false;
+    }
+
+    // 触发时间：优先 "tick"，否则 "time"（秒）
+    uint32_t ParseEventTick(const json& j) {
+        if (j.contains("tick")) {
+            return static_cast<uint32_t>(std::max(0, j["tick"].get<int>()));
+        }
+        float seconds = j.value("time", 0.0f);
+        return static_cast<uint32_t>(std::max(0.0f, std::round(seconds * STAGE_TICKS_PER_SECOND)));
+    }
+}
+
+// 内部辅助函数：从json对象编译关卡
+static bool CompileJsonToStage(const json& j, StageData& data) {
+    try {
+        data = StageData();
+        data.name = j.value("name", std::string());
+        StringTable table(data.strings);
+
+        if (j.contains("events") && j["events"].is_array()) {
+            for (const auto& item : j["events"]) {
+                StageEventType type;
+                std::string typeName = item.value("type", std::string());
+                if (!ParseEventType(typeName, type)) {
+                    std::cerr << "StageCompiler: unknown event type: " << typeName << std::endl;
+                    return false;
+                }
+
+                StageEvent event{};
+                event.tick = ParseEventTick(item);
+                event.type = type;
+                event.nameIndex = -1;
+                event.x = item.value("x", 0.0f);
+                event.y = item.value("y", 0.0f);
+                event.angle = item.value("angle", 90.0f);
+                event.spread = item.value("spread", 0.0f);
+                event.speed = item.value("speed", 0.2f);
+                event.count = item.value("count", 1);
+
+                switch (type) {
+                    case StageEventType::SPAWN_ENEMY:
+                        event.nameIndex = table.Intern(item.value("enemy", std::string()));
+                        break;
+                    case StageEventType::START_PATTERN:
+                    case StageEventType::START_AIMED_PATTERN:
+                        event.nameIndex = table.Intern(item.value("bullet", std::string()));
+                        break;
+                    case StageEventType::SET_BACKGROUND:
+                        event.nameIndex = table.Intern(item.value("texture", std::string()));
+                        break;
+                    case StageEventType::BOSS_PHASE:
+                        event.nameIndex = table.Intern(item.value("boss", std::string()));
+                        event.count = item.value("phase", 0);
+                        break;
+                    case StageEventType::END_STAGE:
+                        break;
+                }
+
+                // 编译期展开波次：repeat 次，每次间隔 interval tick、偏移 dx/dy
+                int repeat = std::max(1, item.value("repeat", 1));
+                int interval = std::max(0, item.value("interval", 0));
+                float dx = item.value("dx", 0.0f);
+                float dy = item.value("dy", 0.0f);
+                for (int r = 0; r < repeat; ++r) {
+                    StageEvent copy = event;
+                    copy.tick = event.tick + static_cast<uint32_t>(r * interval);
+                    copy.x = event.x + dx * r;
+                    copy.y = event.y + dy * r;
+                    data.events.push_back(copy);
+                }
+            }
+        }
+
+        // 稳定排序：同一 tick 内保持编写顺序
+        std::stable_sort(data.events.begin(), data.events.end(),
+                         [](const StageEvent& a, const StageEvent& b) { return a.tick < b.tick; });
+
+        uint32_t lastTick = data.events.empty() ? 0 : data.events.back().tick;
+        data.lengthTicks = std::max(lastTick, static_cast<uint32_t>(std::max(0, j.value("length_ticks", 0))));
+        return true;
+    } catch (const json::exception& e) {
+        std::cerr << "StageCompiler: Error parsing JSON: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool StageCompiler::CompileFromFile(const std::string& filePath, StageData& data) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        std::cerr << "StageCompiler: Failed to open file: " << filePath << std::endl;
+        return false;
+    }
+
+    json j;
+    try {
+        file >> j;
+    } catch (const json::parse_error& e) {
+        std::cerr << "StageCompiler: JSON parse error: " << e.what() << std::endl;
+        return false;
+    }
+
+    return CompileJsonToStage(j, data);
+}
+
+bool StageCompiler::CompileFromString(const std::string& jsonString, StageData& data) {
+    try {
+        json j = json::parse(jsonString);
+        return CompileJsonToStage(j, data);
+    } catch (const json::parse_error& e) {
+        std::cerr << "StageCompiler: JSON parse error: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool StageCompiler::SaveBinary(const std::string& filePath, const StageData& data) {
+    std::vector<uint8_t> bytes;
+    StateWriter writer(bytes);
+
+    writer.WriteBytes(STAGE_MAGIC, sizeof(STAGE_MAGIC));
+    writer.Write(STAGE_BINARY_VERSION);
+    writer.Write(static_cast<uint32_t>(sizeof(StageEvent)));
+    writer.Write(data.lengthTicks);
+    writer.WriteString(data.name);
+
+    writer.Write(static_cast<uint32_t>(data.strings.size()));
+    for (const auto& value : data.strings) {
+        writer.WriteString(value);
+    }
+
+    writer.Write(static_cast<uint32_t>(data.events.size()));
+    writer.WriteBytes(data.events.data(), data.events.size() * sizeof(StageEvent));
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "StageCompiler: Failed to write file: " << filePath << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+bool StageCompiler::LoadBinary(const std::string& filePath, StageData& data) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "StageCompiler: Failed to open file: " << filePath << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    StateReader reader(bytes);
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint32_t eventSize = 0;
+    reader.ReadBytes(magic, sizeof(magic));
+    reader.Read(version);
+    reader.Read(eventSize);
+    if (reader.HasFailed() || std::memcmp(magic, STAGE_MAGIC, sizeof(magic)) != 0 ||
+        version != STAGE_BINARY_VERSION || eventSize != sizeof(StageEvent)) {
+        std::cerr << "StageCompiler: Incompatible stage binary: " << filePath << std::endl;
+        return false;
+    }
+
+    StageData loaded;
+    reader.Read(loaded.lengthTicks);
+    reader.ReadString(loaded.name);
+
+    uint32_t stringCount = 0;
+    reader.Read(stringCount);
+    for (uint32_t i = 0; i < stringCount && !reader.HasFailed(); ++i) {
+        std::string value;
+        reader.ReadString(value);
+        loaded.strings.push_back(std::move(value));
+    }
+
+    uint32_t eventCount = 0;
+    reader.Read(eventCount);
+    if (!reader.HasFailed() && static_cast<size_t>(eventCount) * sizeof(StageEvent) <= reader.GetRemaining()) {
+        loaded.events.resize(eventCount);
+        reader.ReadBytes(loaded.events.data(), eventCount * sizeof(StageEvent));
+    } else {
+        std::cerr << "StageCompiler: Truncated stage binary: " << filePath << std::endl;
+        return false;
+    }
+
+    if (reader.HasFailed()) {
+        std::cerr << "StageCompiler: Truncated stage binary: " << filePath << std::endl;
+        return false;
+    }
+
+    data = std::move(loaded);
+    return true;
+}
+
+bool StageCompiler::LoadStage(const std::string& jsonPath, const std::string& binaryPath, StageData& data) {
+    std::error_code error;
+    bool hasJson = std::filesystem::exists(jsonPath, error);
+    bool hasBinary = std::filesystem::exists(binaryPath, error);
+
+    // 烘焙文件不旧于源文件时直接使用
+    if (hasBinary && (!hasJson ||
+        std::filesystem::last_write_time(binaryPath, error) >= std::filesystem::last_write_time(jsonPath, error))) {
+        if (LoadBinary(binaryPath, data)) {
+            return true;
+        }
+    }
+
+    if (!hasJson || !CompileFromFile(jsonPath, data)) {
+        return false;
+    }
+
+    if (!SaveBinary(binaryPath, data)) {
+        std::cerr << "StageCompiler: Failed to bake stage: " << binaryPath << std::endl;
+    }
+    return true;
+}
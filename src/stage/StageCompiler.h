@@ -0,0 +1,45 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef STAGECOMPILER_H
+#define STAGECOMPILER_H
+
+#include <string>
+#include "StageEvent.h"
+
+/**
+ * 关卡编译器
+ * 负责把 JSON 编写的关卡脚本编译成按 tick 排序的事件数组，
+ * 以及二进制烘焙文件的读写
+ */
+class StageCompiler {
+public:
+    /**
+     * 从JSON文件编译关卡
+     * @param filePath JSON文件路径
+     * @param data 输出的关卡数据
+     * @return 成功返回true，失败返回false
+     */
+    static bool CompileFromFile(const std::string& filePath, StageData& data);
+
+    /**
+     * 从JSON字符串编译关卡
+     */
+    static bool CompileFromString(const std::string& jsonString, StageData& data);
+
+    /**
+     * 二进制烘焙文件读写
+     */
+    static bool SaveBinary(const std::string& filePath, const StageData& data);
+    static bool LoadBinary(const std::string& filePath, StageData& data);
+
+    /**
+     * 加载关卡：烘焙文件存在且不旧于JSON时直接读取，否则重新编译并烘焙
+     * @param jsonPath JSON源文件路径
+     * @param binaryPath 烘焙文件路径
+     */
+    static bool LoadStage(const std::string& jsonPath, const std::string& binaryPath, StageData& data);
+};
+
+#endif //STAGECOMPILER_H
@@ -0,0 +1,56 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef STAGEEVENT_H
+#define STAGEEVENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 关卡固定以 60 tick/秒 推进
+constexpr int STAGE_TICKS_PER_SECOND = 60;
+
+// 关卡事件类型
+enum class StageEventType : uint8_t {
+    SPAWN_ENEMY,      // 生成敌人：name=敌人类型，x/y=出生点
+    START_PATTERN,    // 独立弹幕：name=子弹类型，x/y=发射点，angle/spread/speed/count
+    SET_BACKGROUND,   // 切换背景：name=贴图路径
+    BOSS_PHASE,       // Boss 阶段：name=Boss 敌人类型（可空），count=阶段编号
+    END_STAGE,        // 关卡结束
+    START_AIMED_PATTERN   // 自机狙弹幕：同 START_PATTERN，中心方向对准最近的自机，angle 为无自机时的方向
+};
+
+/**
+ * 预编译后的关卡事件（定长 POD，可直接写入二进制文件）
+ * 字符串参数通过 nameIndex 引用 StageData::strings
+ */
+struct StageEvent {
+    uint32_t tick;          // 触发 tick
+    StageEventType type;
+    uint8_t reserved[3];
+    int32_t nameIndex;      // 字符串表索引，-1 表示无
+    float x, y;
+    float angle;            // 角度（度）
+    float spread;           // 总张角（度）
+    float speed;            // 速度（像素/毫秒）
+    int32_t count;          // 数量 / 阶段编号
+};
+
+/**
+ * 编译后的关卡：按 tick 升序排列的事件数组 + 字符串表
+ */
+struct StageData {
+    std::string name;
+    std::vector<std::string> strings;
+    std::vector<StageEvent> events;
+    uint32_t lengthTicks = 0;   // 关卡总长度（最后一个事件的 tick 或显式指定）
+
+    const std::string& GetString(int32_t index) const {
+        static const std::string emptyString;
+        return (index >= 0 && index < static_cast<int32_t>(strings.size())) ? strings[index] : emptyString;
+    }
+};
+
+#endif //STAGEEVENT_H
@@ -0,0 +1,99 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#include "StageTimeline.h"
+#include "StageCompiler.h"
+#include "../gamecore/FrameProfiler.h"
+
+#include <algorithm>
+#include <iostream>
+
+StageTimeline::StageTimeline()
+    : cursor(0),
+      currentTick(0),
+      loaded(false),
+      finished(false),
+      checkpointInterval(STAGE_TICKS_PER_SECOND * 5) {
+}
+
+bool StageTimeline::Load(const std::string& jsonPath, const std::string& binaryPath) {
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    double loadBegin = profiler.Now();
+    bool compiled = StageCompiler::LoadStage(jsonPath, binaryPath, stageData);
+    profiler.Mark(FrameMarker::CONFIG_LOAD, profiler.Now() - loadBegin, jsonPath.c_str());
+    if (!compiled) {
+        std::cerr << "StageTimeline: failed to load stage: " << jsonPath << std::endl;
+        loaded = false;
+        return false;
+    }
+
+    loaded = true;
+    Start();
+    std::cout << "StageTimeline: loaded '" << stageData.name << "' with "
+              << stageData.events.size() << " events" << std::endl;
+    return true;
+}
+
+void StageTimeline::Start() {
+    cursor = 0;
+    currentTick = 0;
+    finished = false;
+    checkpoints.clear();
+}
+
+void StageTimeline::Tick() {
+    if (!loaded || finished) return;
+
+    const auto& events = stageData.events;
+    while (cursor < events.size() && events[cursor].tick <= currentTick) {
+        const StageEvent& event = events[cursor];
+        cursor++;
+
+        if (event.type == StageEventType::END_STAGE) {
+            finished = true;
+        }
+        if (eventHandler) {
+            eventHandler(event, stageData);
+        }
+    }
+
+    currentTick++;
+}
+
+void StageTimeline::SeekCursor(uint32_t tick) {
+    const auto& events = stageData.events;
+    auto it = std::lower_bound(events.begin(), events.end(), tick,
+                               [](const StageEvent& event, uint32_t value) { return event.tick < value; });
+    cursor = static_cast<size_t>(std::distance(events.begin(), it));
+    currentTick = tick;
+
+    // 结束事件已经派发过则保持结束状态
+    finished = std::any_of(events.begin(), it,
+                           [](const StageEvent& event) { return event.type == StageEventType::END_STAGE; });
+}
+
+bool StageTimeline::IsCheckpointDue() const {
+    if (!loaded || checkpointInterval == 0 || currentTick % checkpointInterval != 0) {
+        return false;
+    }
+    // 跳转后重新经过的 tick 也需要保存（旧的后续检查点会在 StoreCheckpoint 中丢弃）
+    return checkpoints.empty() || checkpoints.back().tick != currentTick;
+}
+
+void StageTimeline::StoreCheckpoint(std::vector<uint8_t> state) {
+    // 跳回过去后继续游玩，之后的检查点已经失效
+    while (!checkpoints.empty() && checkpoints.back().tick >= currentTick) {
+        checkpoints.pop_back();
+    }
+    checkpoints.push_back({currentTick, std::move(state)});
+}
+
+const StageTimeline::Checkpoint* StageTimeline::FindCheckpoint(uint32_t tick) const {
+    auto it = std::upper_bound(checkpoints.begin(), checkpoints.end(), tick,
+                               [](uint32_t value, const Checkpoint& checkpoint) { return value < checkpoint.tick; });
+    if (it == checkpoints.begin()) {
+        return nullptr;
+    }
+    return &*(it - 1);
+}
@@ -0,0 +1,76 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+#ifndef STAGETIMELINE_H
+#define STAGETIMELINE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "StageEvent.h"
+
+/**
+ * StageTimeline - 关卡时间轴
+ * 职责：
+ * 1. 持有编译好的事件数组，用游标按 tick 顺序派发事件（每 tick 均摊 O(1)）
+ * 2. 按固定间隔保存检查点（外部提供的模拟状态快照）
+ * 3. 跳转时定位不晚于目标 tick 的最近检查点，游标用二分查找重新定位
+ *
+ * 时间轴不关心模拟状态的内容，检查点只是不透明的字节块
+ */
+class StageTimeline {
+public:
+    using EventHandler = std::function<void(const StageEvent&, const StageData&)>;
+
+    struct Checkpoint {
+        uint32_t tick;
+        std::vector<uint8_t> state;
+    };
+
+    StageTimeline();
+
+    // 加载关卡（见 StageCompiler::LoadStage）
+    bool Load(const std::string& jsonPath, const std::string& binaryPath);
+
+    void SetEventHandler(EventHandler handler) { eventHandler = std::move(handler); }
+
+    // 从头开始
+    void Start();
+
+    // 推进一个 tick：派发本 tick 的事件
+    void Tick();
+
+    // 把游标重新定位到 tick（之后的 Tick 从该 tick 的事件开始派发）
+    void SeekCursor(uint32_t tick);
+
+    // 状态查询
+    uint32_t GetCurrentTick() const { return currentTick; }
+    bool IsLoaded() const { return loaded; }
+    bool IsFinished() const { return finished; }
+    const StageData& GetStageData() const { return stageData; }
+    size_t GetCursor() const { return cursor; }
+
+    // 检查点
+    void SetCheckpointInterval(uint32_t ticks) { checkpointInterval = ticks; }
+    bool IsCheckpointDue() const;
+    void StoreCheckpoint(std::vector<uint8_t> state);
+    const Checkpoint* FindCheckpoint(uint32_t tick) const;   // 不晚于 tick 的最近检查点
+    void ClearCheckpoints() { checkpoints.clear(); }
+    size_t GetCheckpointCount() const { return checkpoints.size(); }
+
+private:
+    StageData stageData;
+    EventHandler eventHandler;
+
+    size_t cursor;           // 下一个待派发事件的下标
+    uint32_t currentTick;    // 已推进的 tick 数
+    bool loaded;
+    bool finished;
+
+    uint32_t checkpointInterval;
+    std::vector<Checkpoint> checkpoints;   // 按 tick 升序
+};
+
+#endif //STAGETIMELINE_H
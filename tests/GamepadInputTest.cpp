@@ -0,0 +1,241 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+// 手柄输入测试：不接真实设备，通过 Push* 接口注入合成手柄（任取设备编号），每步之后 Update 一次，检查：
+// 1. 默认键位下的动作位（按住、同一 tick 内短按、PAUSE 不进入自机输入）
+// 2. 左摇杆 8 方向：每条 22.5° + 45°·k 分界线两侧各 1° 落到相邻的两个方向
+// 3. 死区：偏移量刚好在死区内不产生方向，刚出死区即产生
+// 4. 热插拔：按接入顺序占用玩家槽位，槽位满时忽略多余的手柄，拔出不挪动其他槽位
+// 5. 拔出后重新接入：按键状态清空，占用空出的槽位；同一 tick 内拔出再接入同样如此
+
+#include "../src/input/InputHandler.h"
+
+#include <SDL3/SDL.h>
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    constexpr SDL_JoystickID PAD_A = 101;
+    constexpr SDL_JoystickID PAD_B = 202;
+    constexpr SDL_JoystickID PAD_C = 303;
+
+    constexpr float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+    constexpr float AXIS_MAX = 32767.0f;
+
+    constexpr InputActionBits LEFT = ActionBit(InputAction::LEFT);
+    constexpr InputActionBits RIGHT = ActionBit(InputAction::RIGHT);
+    constexpr InputActionBits UP = ActionBit(InputAction::UP);
+    constexpr InputActionBits DOWN = ActionBit(InputAction::DOWN);
+    constexpr InputActionBits DIRECTIONS = LEFT | RIGHT | UP | DOWN;
+
+    // 以 +X 为 0°、顺时针（SDL 的 Y 轴向下为正）每 45° 一个方向
+    constexpr InputActionBits EIGHT_WAY[8] = {
+        RIGHT, RIGHT | DOWN, DOWN, LEFT | DOWN, LEFT, LEFT | UP, UP, RIGHT | UP
+    };
+
+    int failures = 0;
+
+    void Check(bool condition, const char* what) {
+        if (!condition) {
+            std::printf("FAILED: %s\n", what);
+            failures++;
+        }
+    }
+
+    void CheckBits(InputActionBits actual, InputActionBits expected, const char* what) {
+        if (actual != expected) {
+            std::printf("FAILED: %s (bits 0x%02x, expected 0x%02x)\n", what, actual, expected);
+            failures++;
+        }
+    }
+
+    void Press(InputHandler& input, SDL_JoystickID device, SDL_GamepadButton button, bool down) {
+        input.PushGamepadButton(device, button, down, SDL_GetTicksNS());
+    }
+
+    // 左摇杆推到 angleDegrees 方向、偏移量为 magnitude（相对满偏）
+    void PushStick(InputHandler& input, SDL_JoystickID device, float angleDegrees, float magnitude) {
+        const float radians = angleDegrees * DEG_TO_RAD;
+        const auto x = static_cast<Sint16>(std::lround(std::cos(radians) * magnitude * AXIS_MAX));
+        const auto y = static_cast<Sint16>(std::lround(std::sin(radians) * magnitude * AXIS_MAX));
+        input.PushGamepadAxis(device, SDL_GAMEPAD_AXIS_LEFTX, x, SDL_GetTicksNS());
+        input.PushGamepadAxis(device, SDL_GAMEPAD_AXIS_LEFTY, y, SDL_GetTicksNS());
+    }
+
+    void TestActionBits() {
+        InputHandler input;
+        input.PushGamepadAdded(PAD_A, SDL_GetTicksNS());
+        input.Update();
+        Check(input.HasGamepad(0), "first gamepad takes slot 0");
+        CheckBits(input.GetActionBits(0), 0, "no buttons held after connect");
+
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_SOUTH, true);
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_LEFT_SHOULDER, true);
+        input.Update();
+        CheckBits(input.GetActionBits(0), ActionBit(InputAction::SHOOT) | ActionBit(InputAction::FOCUS),
+                  "south shoots, left shoulder focuses");
+        Check(input.IsActionJustPressed(InputAction::SHOOT, 0), "shoot just pressed");
+
+        input.Update();
+        Check(input.IsActionPressed(InputAction::SHOOT, 0) && !input.IsActionJustPressed(InputAction::SHOOT, 0),
+              "held shoot is not just pressed on the next tick");
+
+        // 两个 tick 之间按下又松开：这一 tick 仍算按下，下一 tick 消失
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_EAST, true);
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_EAST, false);
+        input.Update();
+        Check(input.IsActionPressed(InputAction::BOMB, 0), "tap between ticks counts as a bomb press");
+        input.Update();
+        Check(!input.IsActionPressed(InputAction::BOMB, 0), "tapped bomb is released on the next tick");
+
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_SOUTH, false);
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_LEFT_SHOULDER, false);
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_DPAD_UP, true);
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_START, true);
+        input.Update();
+        CheckBits(input.GetActionBits(0), UP | ActionBit(InputAction::PAUSE), "d-pad up and start");
+        CheckBits(input.SamplePlayerInput(0), PlayerInput::UP, "pause is not part of the player input");
+    }
+
+    void TestEightWay() {
+        InputHandler input;
+        input.PushGamepadAdded(PAD_A, SDL_GetTicksNS());
+        input.Update();
+
+        char what[96];
+        for (int sector = 0; sector < 8; ++sector) {
+            const float boundary = 22.5f + 45.0f * static_cast<float>(sector);
+            const InputActionBits before = EIGHT_WAY[sector];
+            const InputActionBits after = EIGHT_WAY[(sector + 1) % 8];
+
+            PushStick(input, PAD_A, boundary - 1.0f, 0.9f);
+            input.Update();
+            std::snprintf(what, sizeof(what), "stick at %.1f degrees", boundary - 1.0f);
+            CheckBits(input.GetActionBits(0) & DIRECTIONS, before, what);
+
+            PushStick(input, PAD_A, boundary + 1.0f, 0.9f);
+            input.Update();
+            std::snprintf(what, sizeof(what), "stick at %.1f degrees", boundary + 1.0f);
+            CheckBits(input.GetActionBits(0) & DIRECTIONS, after, what);
+        }
+
+        // 十字键与摇杆合并
+        PushStick(input, PAD_A, 0.0f, 0.9f);
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_DPAD_UP, true);
+        input.Update();
+        CheckBits(input.GetActionBits(0) & DIRECTIONS, RIGHT | UP, "d-pad merges with the stick");
+    }
+
+    void TestDeadzone() {
+        InputHandler input;
+        input.PushGamepadAdded(PAD_A, SDL_GetTicksNS());
+        input.Update();
+        const float deadzone = input.GetStickDeadzone();
+
+        for (int sector = 0; sector < 8; ++sector) {
+            const float angle = 45.0f * static_cast<float>(sector);
+            char what[96];
+
+            PushStick(input, PAD_A, angle, deadzone - 0.01f);
+            input.Update();
+            std::snprintf(what, sizeof(what), "stick inside the deadzone at %.0f degrees", angle);
+            CheckBits(input.GetActionBits(0), 0, what);
+
+            PushStick(input, PAD_A, angle, deadzone + 0.01f);
+            input.Update();
+            std::snprintf(what, sizeof(what), "stick just outside the deadzone at %.0f degrees", angle);
+            CheckBits(input.GetActionBits(0), EIGHT_WAY[sector], what);
+        }
+
+        // 死区可调：调大后同样的偏移量回到死区内
+        input.SetStickDeadzone(deadzone + 0.2f);
+        input.Update();
+        CheckBits(input.GetActionBits(0), 0, "raised deadzone swallows the same deflection");
+
+        // 回中
+        input.PushGamepadAxis(PAD_A, SDL_GAMEPAD_AXIS_LEFTX, 0, SDL_GetTicksNS());
+        input.PushGamepadAxis(PAD_A, SDL_GAMEPAD_AXIS_LEFTY, 0, SDL_GetTicksNS());
+        input.SetStickDeadzone(deadzone);
+        input.Update();
+        CheckBits(input.GetActionBits(0), 0, "centered stick");
+    }
+
+    void TestHotplug() {
+        InputHandler input;
+        Check(!input.HasGamepad(0) && !input.HasGamepad(1), "no gamepads at start");
+
+        // 按接入顺序占用槽位，第 3 个手柄被忽略
+        input.PushGamepadAdded(PAD_A, SDL_GetTicksNS());
+        input.PushGamepadAdded(PAD_B, SDL_GetTicksNS());
+        input.PushGamepadAdded(PAD_C, SDL_GetTicksNS());
+        input.Update();
+        Check(input.HasGamepad(0) && input.HasGamepad(1), "two gamepads fill both slots");
+
+        Press(input, PAD_B, SDL_GAMEPAD_BUTTON_SOUTH, true);
+        Press(input, PAD_C, SDL_GAMEPAD_BUTTON_EAST, true);
+        input.Update();
+        CheckBits(input.GetActionBits(0), 0, "second gamepad does not drive player 1");
+        CheckBits(input.GetActionBits(1), ActionBit(InputAction::SHOOT), "second gamepad drives player 2");
+
+        // 键盘只属于 1P
+        input.PushKeyEvent(SDL_SCANCODE_X, true, SDL_GetTicksNS());
+        input.Update();
+        CheckBits(input.GetActionBits(0), ActionBit(InputAction::BOMB), "keyboard drives player 1");
+        CheckBits(input.GetActionBits(1), ActionBit(InputAction::SHOOT), "keyboard does not drive player 2");
+        input.PushKeyEvent(SDL_SCANCODE_X, false, SDL_GetTicksNS());
+
+        // 拔出第 1 个手柄：2P 不挪到槽位 0
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_DPAD_LEFT, true);
+        input.Update();
+        CheckBits(input.GetActionBits(0), LEFT, "player 1 holds left");
+        input.PushGamepadRemoved(PAD_A, SDL_GetTicksNS());
+        input.Update();
+        Check(!input.HasGamepad(0) && input.HasGamepad(1), "removing the first gamepad frees only slot 0");
+        CheckBits(input.GetActionBits(0), 0, "removed gamepad releases its buttons");
+        CheckBits(input.GetActionBits(1), ActionBit(InputAction::SHOOT), "player 2 unaffected by the removal");
+
+        // 重新接入的手柄占用空出的槽位，之前按住的键不残留
+        input.PushGamepadAdded(PAD_A, SDL_GetTicksNS());
+        input.Update();
+        Check(input.HasGamepad(0), "re-added gamepad takes the free slot 0");
+        CheckBits(input.GetActionBits(0), 0, "re-added gamepad starts with no buttons held");
+        Press(input, PAD_A, SDL_GAMEPAD_BUTTON_EAST, true);
+        input.Update();
+        CheckBits(input.GetActionBits(0), ActionBit(InputAction::BOMB), "re-added gamepad drives player 1");
+
+        // 同一 tick 内拔出再接入：回到原槽位，按键和摇杆清空
+        PushStick(input, PAD_B, 90.0f, 0.9f);
+        input.Update();
+        CheckBits(input.GetActionBits(1), ActionBit(InputAction::SHOOT) | DOWN, "player 2 holds shoot and down");
+        input.PushGamepadRemoved(PAD_B, SDL_GetTicksNS());
+        input.PushGamepadAdded(PAD_B, SDL_GetTicksNS());
+        input.Update();
+        Check(input.HasGamepad(1), "remove then add in one tick keeps slot 1");
+        CheckBits(input.GetActionBits(1), 0, "remove then add in one tick clears buttons and stick");
+
+        // 槽位空出之前被忽略的手柄需要重新接入才生效
+        input.PushGamepadRemoved(PAD_A, SDL_GetTicksNS());
+        Press(input, PAD_C, SDL_GAMEPAD_BUTTON_SOUTH, true);
+        input.Update();
+        Check(!input.HasGamepad(0), "ignored gamepad does not take a slot by itself");
+        input.PushGamepadAdded(PAD_C, SDL_GetTicksNS());
+        Press(input, PAD_C, SDL_GAMEPAD_BUTTON_SOUTH, true);
+        input.Update();
+        Check(input.HasGamepad(0), "late gamepad takes slot 0 once added");
+        CheckBits(input.GetActionBits(0), ActionBit(InputAction::SHOOT), "late gamepad drives player 1");
+    }
+}
+
+int main() {
+    TestActionBits();
+    TestEightWay();
+    TestDeadzone();
+    TestHotplug();
+
+    if (failures == 0) {
+        std::printf("GamepadInputTest: OK\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,352 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+// 快照往返测试：不开窗口运行第一关的模拟，两个自机由脚本输入驱动（移动、集中、射击、放炸弹），
+// 在几个位置保存快照，比较「继续模拟 N tick」与「恢复快照后再模拟 N tick」的快照字节，必须完全一致。
+// 另外检查：恢复后立即保存的快照与原快照相同；脚本确实在比较窗口内放出了炸弹（自机状态和计时随之变化）。
+//
+// 在仓库根目录运行（读取 assert/ 下的配置和关卡）。
+// 子弹配置引用的贴图不在仓库里，复制到临时目录时改用 assert/pic.png，模拟不依赖贴图内容。
+
+#include "../src/bullet/BulletPattern.h"
+#include "../src/gamecore/Random.h"
+#include "../src/graphics/Renderer.h"
+#include "../src/input/PlayerInput.h"
+#include "../src/manager/BulletManager.h"
+#include "../src/manager/EnemyManager.h"
+#include "../src/manager/ItemManager.h"
+#include "../src/player/TestPlayer.h"
+#include "../src/snapshot/SimulationSnapshot.h"
+#include "../src/stage/StageTimeline.h"
+#include "../src/json.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr int WINDOW_WIDTH = 800;
+    constexpr int WINDOW_HEIGHT = 600;
+    constexpr float TICK_MS = 1000.0f / STAGE_TICKS_PER_SECOND;
+    constexpr float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+    constexpr const char* FALLBACK_TEXTURE = "assert/pic.png";
+
+    // 快照位置与每次比较的长度：覆盖敌人登场、各种弹幕和激光的区间；
+    // 720 与 1080 落在炸弹持续期间，快照中带着进行中的炸弹计时
+    constexpr uint32_t WINDOW_STARTS[] = {540, 720, 900, 1080};
+    constexpr uint32_t WINDOW_TICKS = 180;
+
+    // 炸弹输入（1P / 2P），每个比较窗口内至少一次
+    constexpr uint32_t BOMB_TICKS[2][3] = {{600, 700, 1000}, {650, 820, 1050}};
+
+    // 脚本输入：只取决于 tick 和槽位，恢复快照后重放得到完全相同的输入
+    PlayerInputBits ScriptedInput(uint32_t tick, int slot) {
+        PlayerInputBits bits = PlayerInput::SHOOT;
+        bits |= ((tick / 45 + slot) % 2) ? PlayerInput::LEFT : PlayerInput::RIGHT;
+        if ((tick / 70) % 3 == 1) bits |= PlayerInput::UP;
+        if ((tick / 70) % 3 == 2) bits |= PlayerInput::DOWN;
+        if (tick % 90 < 30) bits |= PlayerInput::FOCUS;
+        for (uint32_t bombTick : BOMB_TICKS[slot]) {
+            if (tick == bombTick) bits |= PlayerInput::BOMB;
+        }
+        return bits;
+    }
+
+    // 把配置目录里的 JSON 复制到 target，引用的贴图不存在时换成占位贴图
+    bool CopyConfigs(const std::filesystem::path& source, const std::filesystem::path& target) {
+        std::error_code error;
+        std::filesystem::create_directories(target, error);
+        if (error || !std::filesystem::is_directory(source)) {
+            std::cerr << "Cannot prepare configs from " << source << std::endl;
+            return false;
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator(source)) {
+            if (entry.path().extension() != ".json") continue;
+
+            std::ifstream input(entry.path());
+            nlohmann::json config = nlohmann::json::parse(input, nullptr, false);
+            if (config.is_discarded()) {
+                std::cerr << "Invalid config: " << entry.path() << std::endl;
+                return false;
+            }
+            if (config.contains("texture") && !std::filesystem::exists(config["texture"].get<std::string>())) {
+                config["texture"] = FALLBACK_TEXTURE;
+            }
+            std::ofstream output(target / entry.path().filename());
+            output << config.dump(2);
+        }
+        return true;
+    }
+
+    /**
+     * HeadlessSimulation - 不依赖 Game 的模拟
+     * 职责：
+     * 1. 按 Game::RegisterSystemStages 的阶段顺序单线程推进一个 tick（输入、自机、瞄准目标、时间轴、
+     *    敌人、子弹、道具、碰撞）
+     * 2. 关卡事件的处理与 Game::HandleStageEvent 相同
+     */
+    class HeadlessSimulation {
+    public:
+        bool Initialize(const std::filesystem::path& workDirectory) {
+            if (!renderer.Initialize("SnapshotRoundTripTest", WINDOW_WIDTH, WINDOW_HEIGHT)) {
+                return false;
+            }
+
+            const std::filesystem::path bulletDirectory = workDirectory / "bullet_assert";
+            const std::filesystem::path enemyDirectory = workDirectory / "enemy_assert";
+            if (!CopyConfigs("assert/bullet_assert", bulletDirectory) ||
+                !CopyConfigs("assert/enemy_assert", enemyDirectory)) {
+                return false;
+            }
+
+            for (size_t i = 0; i < players.size(); ++i) {
+                players[i] = std::make_unique<TestPlayer>(nullptr, WINDOW_WIDTH, WINDOW_HEIGHT);
+                players[i]->Initialize(&renderer);
+            }
+            players[1]->Move(80.0f, 0.0f);
+
+            bullets = std::make_unique<BulletManager>();
+            if (!bullets->Initialize(bulletDirectory.string(), renderer)) {
+                std::cerr << "BulletManager failed to initialize" << std::endl;
+                return false;
+            }
+
+            items = std::make_unique<ItemManager>();
+            items->SetBottomBound(static_cast<float>(WINDOW_HEIGHT));
+            clearedPositions.reserve(10000);
+
+            enemies = std::make_unique<EnemyManager>();
+            if (!enemies->Initialize(enemyDirectory.string(), renderer, bullets.get())) {
+                std::cerr << "EnemyManager failed to initialize" << std::endl;
+                return false;
+            }
+            enemies->SetRandom(&random);
+            enemies->SetItemManager(items.get());
+
+            timeline.SetEventHandler([this](const StageEvent& event, const StageData& data) {
+                HandleStageEvent(event, data);
+            });
+            if (!timeline.Load("assert/stage/stage1.json", (workDirectory / "stage1.stgb").string())) {
+                std::cerr << "Stage failed to load" << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        void Tick() {
+            const uint32_t tick = timeline.GetCurrentTick();
+            for (size_t i = 0; i < players.size(); ++i) {
+                players[i]->SetInput(ScriptedInput(tick, static_cast<int>(i)));
+            }
+            for (auto& player : players) {
+                player->Update(TICK_MS);
+            }
+
+            BulletTargets& targets = bullets->GetTargets();
+            targets.Clear();
+            for (auto& player : players) {
+                if (player->IsAlive()) {
+                    targets.AddPlayer(player->GetCenterX(), player->GetCenterY());
+                }
+            }
+            enemies->CollectTargets(targets);
+
+            timeline.Tick();
+
+            enemies->SetTargetPosition(players[0]->GetCenterX(), players[0]->GetCenterY());
+            enemies->Update(TICK_MS);
+            bullets->Update(TICK_MS);
+
+            std::array<SelfMachineBase*, 2> collectors{players[0].get(), players[1].get()};
+            items->Update(TICK_MS, collectors);
+
+            for (auto& player : players) {
+                float radius = player->GetBombClearRadius();
+                if (radius > 0.0f) {
+                    ClearEnemyBulletsToItems(BulletClearRegion::Circle(player->GetCenterX(),
+                                                                       player->GetCenterY(), radius));
+                }
+            }
+            bullets->BuildPlayerCollisionCache();
+            for (auto& player : players) {
+                bullets->CheckPlayerCollisions(player.get());
+            }
+            enemies->CheckCollisions(bullets.get());
+        }
+
+        void RunUntil(uint32_t tick) {
+            while (timeline.GetCurrentTick() < tick && !timeline.IsFinished()) {
+                Tick();
+            }
+        }
+
+        SimulationState GetState() {
+            SimulationState simulation;
+            simulation.timeline = &timeline;
+            simulation.players = {players[0].get(), players[1].get()};
+            simulation.enemies = enemies.get();
+            simulation.bullets = bullets.get();
+            simulation.items = items.get();
+            simulation.random = &random;
+            simulation.backgroundIndex = &backgroundIndex;
+            simulation.bossPhase = &bossPhase;
+            return simulation;
+        }
+
+        const TestPlayer& GetPlayer(int slot) const { return *players[slot]; }
+        size_t GetBulletCount() const { return bullets->GetActiveBulletCount(); }
+        size_t GetEnemyCount() const { return enemies->GetActiveEnemyCount(); }
+
+    private:
+        void HandleStageEvent(const StageEvent& event, const StageData& data) {
+            const std::string& name = data.GetString(event.nameIndex);
+            switch (event.type) {
+                case StageEventType::SPAWN_ENEMY:
+                    enemies->SpawnEnemy(name, event.x, event.y);
+                    break;
+                case StageEventType::START_PATTERN:
+                    BulletPattern::FireFan(bullets.get(), name, BulletOwner::ENEMY, event.x, event.y,
+                                           event.angle * DEG_TO_RAD, event.spread * DEG_TO_RAD, event.count,
+                                           event.speed);
+                    break;
+                case StageEventType::START_AIMED_PATTERN:
+                    BulletPattern::FireAimedFan(bullets.get(), name, BulletOwner::ENEMY, event.x, event.y,
+                                                event.angle * DEG_TO_RAD, event.spread * DEG_TO_RAD, event.count,
+                                                event.speed);
+                    break;
+                case StageEventType::SET_BACKGROUND:
+                    backgroundIndex = event.nameIndex;
+                    break;
+                case StageEventType::BOSS_PHASE:
+                    ClearEnemyBulletsToItems(BulletClearRegion::Screen());
+                    bossPhase = event.count;
+                    if (!name.empty()) {
+                        enemies->SpawnEnemy(name, event.x, event.y);
+                    }
+                    break;
+                case StageEventType::END_STAGE:
+                    break;
+            }
+        }
+
+        void ClearEnemyBulletsToItems(const BulletClearRegion& region) {
+            clearedPositions.clear();
+            bullets->ClearBullets(region, BulletClearOwner::ENEMY, &clearedPositions);
+            if (!clearedPositions.empty()) {
+                items->SpawnItems(ItemType::POINT, clearedPositions.data(), clearedPositions.size());
+            }
+        }
+
+        Renderer renderer;
+        std::array<std::unique_ptr<TestPlayer>, 2> players;
+        std::unique_ptr<BulletManager> bullets;
+        std::unique_ptr<ItemManager> items;
+        std::unique_ptr<EnemyManager> enemies;
+        StageTimeline timeline;
+        Random random;
+        int32_t backgroundIndex = -1;
+        int bossPhase = 0;
+        std::vector<SDL_FPoint> clearedPositions;
+    };
+
+    // 两份快照第一个不同字节的位置（相同返回 -1）
+    long long FirstDifference(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+        const size_t common = std::min(a.size(), b.size());
+        for (size_t i = 0; i < common; ++i) {
+            if (a[i] != b[i]) return static_cast<long long>(i);
+        }
+        return a.size() == b.size() ? -1 : static_cast<long long>(common);
+    }
+}
+
+int main() {
+    // 无窗口运行：dummy 视频驱动加软件渲染器，只用于加载贴图
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    const std::filesystem::path workDirectory = std::filesystem::temp_directory_path() / "SnapshotRoundTripTest";
+    int failures = 0;
+    bool bombUsed = false;
+    {
+        HeadlessSimulation simulation;
+        if (!simulation.Initialize(workDirectory)) {
+            SDL_Quit();
+            return 1;
+        }
+
+        std::vector<uint8_t> start;
+        std::vector<uint8_t> restored;
+        std::vector<uint8_t> continuous;
+        std::vector<uint8_t> replayed;
+
+        for (uint32_t windowStart : WINDOW_STARTS) {
+            simulation.RunUntil(windowStart);
+            const uint32_t windowEnd = windowStart + WINDOW_TICKS;
+
+            SimulationSnapshot::Capture(simulation.GetState(), start);
+            const size_t bulletCount = simulation.GetBulletCount();
+            const size_t enemyCount = simulation.GetEnemyCount();
+            const int bombsBefore[2] = {simulation.GetPlayer(0).GetBombCount(),
+                                        simulation.GetPlayer(1).GetBombCount()};
+
+            simulation.RunUntil(windowEnd);
+            SimulationSnapshot::Capture(simulation.GetState(), continuous);
+            for (int slot = 0; slot < 2; ++slot) {
+                bombUsed = bombUsed || simulation.GetPlayer(slot).GetBombCount() != bombsBefore[slot];
+            }
+
+            auto restoreBegin = std::chrono::steady_clock::now();
+            const bool restoreOk = SimulationSnapshot::Restore(simulation.GetState(), start);
+            const double restoreMs =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restoreBegin).count();
+            if (!restoreOk) {
+                std::cerr << "tick " << windowStart << ": restore failed" << std::endl;
+                failures++;
+                break;
+            }
+
+            SimulationSnapshot::Capture(simulation.GetState(), restored);
+            const long long restoredDifference = FirstDifference(start, restored);
+
+            simulation.RunUntil(windowEnd);
+            SimulationSnapshot::Capture(simulation.GetState(), replayed);
+            const long long replayedDifference = FirstDifference(continuous, replayed);
+
+            const bool ok = restoredDifference < 0 && replayedDifference < 0;
+            std::printf("tick %4u-%4u  bullets %5zu  enemies %3zu  size %7zu  restore %.3f ms  %s\n", windowStart,
+                        windowEnd, bulletCount, enemyCount, start.size(), restoreMs, ok ? "OK" : "MISMATCH");
+            if (restoredDifference >= 0) {
+                std::printf("    restore -> capture differs at byte %lld\n", restoredDifference);
+            }
+            if (replayedDifference >= 0) {
+                std::printf("    continuous %llx / replayed %llx, first difference at byte %lld\n",
+                            static_cast<unsigned long long>(SimulationSnapshot::Hash(continuous)),
+                            static_cast<unsigned long long>(SimulationSnapshot::Hash(replayed)), replayedDifference);
+            }
+            if (!ok) failures++;
+        }
+    }
+
+    // 脚本没有让自机放出炸弹说明自机阶段没有真正参与比较
+    if (!bombUsed) {
+        std::cerr << "Scripted input never changed player state; the player stage was not exercised" << std::endl;
+        failures++;
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(workDirectory, error);
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
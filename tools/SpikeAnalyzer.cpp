@@ -0,0 +1,285 @@
+//
+// Created by zream on 2026/10/19.
+//
+
+// 卡顿捕获分析工具：读取 FrameProfiler 保存的 .fcap 文件，
+// 列出每个超过阈值的帧的主要耗时来源（阶段、重叠的事件标记、同时段另一条轨道的帧），
+// 最后按轨道汇总所有卡顿帧的耗时构成。
+//
+// 用法：SpikeAnalyzer [--threshold ms] [--top n] <文件或目录>...
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    struct Frame {
+        std::string track;
+        unsigned long long frame = 0;
+        double startMs = 0.0;
+        double totalMs = 0.0;
+        std::vector<double> phases;
+
+        double EndMs() const { return startMs + totalMs; }
+    };
+
+    struct Marker {
+        double timeMs = 0.0;
+        double durationMs = 0.0;
+        std::string type;
+        std::string label;
+
+        double EndMs() const { return timeMs + durationMs; }
+    };
+
+    struct Capture {
+        std::string path;
+        double thresholdMs = 0.0;
+        std::string trigger;
+        std::vector<std::string> phaseNames;
+        std::vector<Frame> frames;
+        std::vector<Marker> markers;
+    };
+
+    // 一个耗时来源：名字 + 毫秒
+    using Contributor = std::pair<std::string, double>;
+
+    // 每条轨道的汇总（所有卡顿帧）
+    struct TrackSummary {
+        int spikes = 0;
+        double totalMs = 0.0;
+        double worstMs = 0.0;
+        std::map<std::string, double> contributors;
+    };
+
+    bool LoadCapture(const std::string& path, Capture& capture) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open capture: " << path << std::endl;
+            return false;
+        }
+
+        capture.path = path;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            ++lineNumber;
+            if (line.empty() || line[0] == '#') continue;
+
+            std::istringstream stream(line);
+            std::string tag;
+            stream >> tag;
+
+            if (tag == "threshold_ms") {
+                stream >> capture.thresholdMs;
+            } else if (tag == "trigger") {
+                std::getline(stream >> std::ws, capture.trigger);
+            } else if (tag == "phases") {
+                std::string name;
+                while (stream >> name) {
+                    capture.phaseNames.push_back(name);
+                }
+            } else if (tag == "F") {
+                Frame frame;
+                stream >> frame.track >> frame.frame >> frame.startMs >> frame.totalMs;
+                frame.phases.resize(capture.phaseNames.size(), 0.0);
+                for (double& phase : frame.phases) {
+                    stream >> phase;
+                }
+                if (stream.fail()) {
+                    std::cerr << path << ":" << lineNumber << ": malformed frame line" << std::endl;
+                    continue;
+                }
+                capture.frames.push_back(std::move(frame));
+            } else if (tag == "M") {
+                Marker marker;
+                stream >> marker.timeMs >> marker.durationMs >> marker.type >> marker.label;
+                if (stream.fail()) {
+                    std::cerr << path << ":" << lineNumber << ": malformed marker line" << std::endl;
+                    continue;
+                }
+                capture.markers.push_back(std::move(marker));
+            }
+        }
+
+        if (capture.phaseNames.empty()) {
+            std::cerr << "Not a frame capture (missing phase header): " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // 区间 [aBegin, aEnd) 与 [bBegin, bEnd) 的重叠毫秒数
+    double Overlap(double aBegin, double aEnd, double bBegin, double bEnd) {
+        return std::max(0.0, std::min(aEnd, bEnd) - std::max(aBegin, bBegin));
+    }
+
+    void AnalyzeSpike(const Capture& capture, const Frame& spike, double thresholdMs, int topCount,
+                      TrackSummary& summary) {
+        std::printf("  %-10s frame %-8llu t=%10.1f ms  total %7.2f ms\n", spike.track.c_str(), spike.frame,
+                    spike.startMs, spike.totalMs);
+
+        // 阶段：按耗时降序；阶段之和与总耗时的差额记为未计入部分
+        std::vector<Contributor> contributors;
+        double accounted = 0.0;
+        for (size_t i = 0; i < spike.phases.size(); ++i) {
+            if (spike.phases[i] <= 0.0) continue;
+            contributors.emplace_back(capture.phaseNames[i], spike.phases[i]);
+            accounted += spike.phases[i];
+        }
+        if (spike.totalMs - accounted > 0.05) {
+            contributors.emplace_back("(untracked)", spike.totalMs - accounted);
+        }
+        std::sort(contributors.begin(), contributors.end(),
+                  [](const Contributor& a, const Contributor& b) { return a.second > b.second; });
+
+        int shown = 0;
+        for (const Contributor& contributor : contributors) {
+            if (shown++ >= topCount) break;
+            std::printf("      %-16s %7.2f ms  %5.1f%%\n", contributor.first.c_str(), contributor.second,
+                        spike.totalMs > 0.0 ? contributor.second * 100.0 / spike.totalMs : 0.0);
+        }
+        for (const Contributor& contributor : contributors) {
+            summary.contributors[contributor.first] += contributor.second;
+        }
+
+        // 与这一帧重叠的事件标记（按在帧内的时长计入汇总）
+        for (const Marker& marker : capture.markers) {
+            double overlap = Overlap(marker.timeMs, std::max(marker.EndMs(), marker.timeMs + 0.001),
+                                     spike.startMs, spike.EndMs());
+            if (overlap <= 0.0) continue;
+            std::printf("      marker %-16s %7.2f ms  %s\n", marker.type.c_str(), marker.durationMs,
+                        marker.label.c_str());
+            summary.contributors["marker:" + marker.type] += std::min(overlap, marker.durationMs);
+        }
+
+        // 同时段另一条轨道的慢帧：卡顿可能来自另一个线程（锁、共享资源）
+        for (const Frame& other : capture.frames) {
+            if (other.track == spike.track) continue;
+            if (other.totalMs <= thresholdMs) continue;
+            if (Overlap(other.startMs, other.EndMs(), spike.startMs, spike.EndMs()) <= 0.0) continue;
+
+            size_t largest = 0;
+            for (size_t i = 1; i < other.phases.size(); ++i) {
+                if (other.phases[i] > other.phases[largest]) largest = i;
+            }
+            std::printf("      concurrent %-10s frame %llu total %.2f ms (largest %s %.2f ms)\n",
+                        other.track.c_str(), other.frame, other.totalMs, capture.phaseNames[largest].c_str(),
+                        other.phases.empty() ? 0.0 : other.phases[largest]);
+        }
+    }
+
+    // 同一次卡顿可能落在多个捕获文件的窗口里，reported 记录已经分析过的 轨道+帧号
+    void AnalyzeCapture(const Capture& capture, double thresholdMs, int topCount,
+                        std::set<std::pair<std::string, unsigned long long>>& reported,
+                        std::map<std::string, TrackSummary>& summaries) {
+        std::printf("%s\n", capture.path.c_str());
+        std::printf("  trigger %s, %zu frames, %zu markers, threshold %.1f ms\n",
+                    capture.trigger.empty() ? "-" : capture.trigger.c_str(), capture.frames.size(),
+                    capture.markers.size(), thresholdMs);
+
+        int spikes = 0;
+        int repeated = 0;
+        for (const Frame& frame : capture.frames) {
+            if (frame.totalMs <= thresholdMs) continue;
+            if (!reported.emplace(frame.track, frame.frame).second) {
+                repeated++;
+                continue;
+            }
+            TrackSummary& summary = summaries[frame.track];
+            summary.spikes++;
+            summary.totalMs += frame.totalMs;
+            summary.worstMs = std::max(summary.worstMs, frame.totalMs);
+            AnalyzeSpike(capture, frame, thresholdMs, topCount, summary);
+            spikes++;
+        }
+        if (repeated > 0) {
+            std::printf("  (%d spikes already reported in an earlier capture)\n", repeated);
+        } else if (spikes == 0) {
+            std::printf("  no frames over threshold\n");
+        }
+        std::printf("\n");
+    }
+
+    void PrintSummary(const std::map<std::string, TrackSummary>& summaries, int topCount) {
+        std::printf("== Summary ==\n");
+        if (summaries.empty()) {
+            std::printf("  no spikes\n");
+            return;
+        }
+        for (const auto& [track, summary] : summaries) {
+            std::printf("  %-10s %d spikes, avg %.2f ms, worst %.2f ms\n", track.c_str(), summary.spikes,
+                        summary.totalMs / summary.spikes, summary.worstMs);
+
+            std::vector<Contributor> contributors(summary.contributors.begin(), summary.contributors.end());
+            std::sort(contributors.begin(), contributors.end(),
+                      [](const Contributor& a, const Contributor& b) { return a.second > b.second; });
+            int shown = 0;
+            for (const Contributor& contributor : contributors) {
+                if (shown++ >= topCount) break;
+                std::printf("      %-24s %9.2f ms  %5.1f%%\n", contributor.first.c_str(), contributor.second,
+                            contributor.second * 100.0 / summary.totalMs);
+            }
+        }
+    }
+
+    void CollectFiles(const std::string& path, std::vector<std::string>& files) {
+        std::error_code error;
+        if (std::filesystem::is_directory(path, error)) {
+            for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+                if (entry.path().extension() == ".fcap") {
+                    files.push_back(entry.path().string());
+                }
+            }
+        } else {
+            files.push_back(path);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    double thresholdOverride = -1.0;
+    int topCount = 5;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            thresholdOverride = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            topCount = std::max(1, std::atoi(argv[++i]));
+        } else {
+            CollectFiles(argv[i], files);
+        }
+    }
+
+    if (files.empty()) {
+        std::cerr << "Usage: SpikeAnalyzer [--threshold ms] [--top n] <capture.fcap | directory>..." << std::endl;
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    std::map<std::string, TrackSummary> summaries;
+    std::set<std::pair<std::string, unsigned long long>> reported;
+    int loaded = 0;
+    for (const std::string& path : files) {
+        Capture capture;
+        if (!LoadCapture(path, capture)) continue;
+        loaded++;
+        AnalyzeCapture(capture, thresholdOverride >= 0.0 ? thresholdOverride : capture.thresholdMs, topCount,
+                       reported, summaries);
+    }
+
+    if (loaded == 0) return 1;
+    PrintSummary(summaries, topCount);
+    return 0;
+}